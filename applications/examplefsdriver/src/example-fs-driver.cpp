@@ -134,12 +134,24 @@ int main(int argc, char* argv[]) {
 							parent->virt_id, disc->name, G_FS_NODE_TYPE_FILE,
 							child->phys_id, &created_vfs_node_id);
 					child->virt_id = created_vfs_node_id;
+
+					// the contents never change, so the kernel may keep the length
+					g_fs_set_attributes(created_vfs_node_id, 1024, G_FS_ATTRIBUTES_TTL_AUTHORITATIVE);
 					g_logger::log(
 							"discovered child of %i (phys %lli) named %s, virt %i, phys %lli",
 							parent->virt_id, parent->phys_id, disc->name,
 							child->virt_id, child->phys_id);
 
-					disc->result_status = G_FS_DISCOVERY_SUCCESSFUL;
+					/**
+					 * The kernel passes the rest of the path, so that all elements can be
+					 * discovered at once. All nodes of this filesystem are files, so any
+					 * remaining element does not exist.
+					 */
+					if (disc->remaining[0] != 0) {
+						disc->result_status = G_FS_DISCOVERY_NOT_FOUND;
+					} else {
+						disc->result_status = G_FS_DISCOVERY_SUCCESSFUL;
+					}
 				} else {
 					g_logger::log(
 							"tried to find child of non-existing physical node: %i",
@@ -153,7 +165,13 @@ int main(int argc, char* argv[]) {
 				g_fs_tasked_delegate_transaction_storage_read* storage =
 						(g_fs_tasked_delegate_transaction_storage_read*) transaction_storage;
 
-				int readable = 1024 - storage->offset;
+				int readable = 0;
+				if (storage->offset < 1024) {
+					readable = 1024 - storage->offset;
+					if (readable > storage->length) {
+						readable = storage->length;
+					}
+				}
 				for (int i = 0; i < readable; i++) {
 					((char*) storage->mapped_buffer)[i] = (char) ('a'
 							+ (i % ('z' - 'a')));
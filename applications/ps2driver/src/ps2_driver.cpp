@@ -36,10 +36,8 @@ uint8_t mouse_packet_buffer[3];
 int32_t mouse_position_x = 0;
 int32_t mouse_position_y = 0;
 
-uint32_t mouse_receiver_tid;
-uint32_t mouse_receiver_transaction;
-uint32_t keyboard_receiver_tid;
-uint32_t keyboard_receiver_transaction;
+g_topic_id mouse_topic;
+g_topic_id keyboard_topic;
 
 uint32_t packets_count;
 
@@ -54,6 +52,10 @@ int main() {
 				(char*) G_PS2_DRIVER_IDENTIFIER);
 	}
 
+	// open the topics that packets are published to
+	keyboard_topic = g_topic_open(G_PS2_KEYBOARD_TOPIC);
+	mouse_topic = g_topic_open(G_PS2_MOUSE_TOPIC);
+
 	// initialize mouse
 	initialize_mouse();
 
@@ -62,30 +64,11 @@ int main() {
 	g_register_irq_handler(1, irq_handler);
 	g_register_irq_handler(12, irq_handler);
 
-	// wait for control requests
-	size_t buflen = sizeof(g_message_header) + sizeof(g_ps2_register_request);
-	uint8_t buf[buflen];
-	g_tid tid = g_get_tid();
+	// the irq handlers do all the work, wait on an event that is never
+	// signaled so this thread is not scheduled until interrupted
+	g_fd idle_event = g_event_create();
 	while (true) {
-		g_message_receive_status stat = g_receive_message(buf, buflen);
-
-		if (stat == G_MESSAGE_RECEIVE_STATUS_SUCCESSFUL) {
-			g_message_header* mes = (g_message_header*) buf;
-			g_ps2_register_request* req =
-					(g_ps2_register_request*) G_MESSAGE_CONTENT(buf);
-
-			if (req->command == G_PS2_COMMAND_REGISTER_KEYBOARD) {
-				keyboard_receiver_tid = mes->sender;
-				keyboard_receiver_transaction = mes->transaction;
-
-			} else if (req->command == G_PS2_COMMAND_REGISTER_MOUSE) {
-				mouse_receiver_tid = mes->sender;
-				mouse_receiver_transaction = mes->transaction;
-
-			} else {
-				g_logger::log("received unknown command: %i", req->command);
-			}
-		}
+		g_event_wait(idle_event);
 	}
 }
 
@@ -151,8 +134,9 @@ void handle_mouse_data(uint8_t b) {
 			packet.x = offX;
 			packet.y = offY;
 			packet.flags = flags;
-			g_send_message_t(mouse_receiver_tid, &packet,
-					sizeof(g_ps2_mouse_packet), mouse_receiver_transaction);
+			g_topic_publish_m(mouse_topic, &packet,
+					sizeof(g_ps2_mouse_packet),
+					G_TOPIC_PUBLISH_MODE_NON_BLOCKING);
 		}
 
 		mouse_packet_number = 0;
@@ -167,8 +151,8 @@ void handle_keyboard_data(uint8_t b) {
 
 	g_ps2_keyboard_packet packet;
 	packet.scancode = b;
-	g_send_message_t(keyboard_receiver_tid, &packet,
-			sizeof(g_ps2_keyboard_packet), keyboard_receiver_transaction);
+	g_topic_publish_m(keyboard_topic, &packet, sizeof(g_ps2_keyboard_packet),
+			G_TOPIC_PUBLISH_MODE_NON_BLOCKING);
 }
 
 /**
@@ -27,15 +27,6 @@
 class terminal_t;
 class screen_t;
 
-/**
- *
- */
-struct standard_out_thread_data_t {
-	bool stop;
-	uint32_t stdout_read_end;
-	screen_t* screen;
-};
-
 /**
  *
  */
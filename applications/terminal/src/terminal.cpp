@@ -269,31 +269,30 @@ bool terminal_t::handle_builtin(std::string command) {
 		auto* iter = g_open_directory_s(working_directory.c_str(), &stat);
 
 		if (stat == G_FS_OPEN_DIRECTORY_SUCCESSFUL) {
-			g_fs_directory_entry* entry;
+			const uint32_t buffer_length = 0x1000;
+			uint8_t* buffer = new uint8_t[buffer_length];
 
-			while (true) {
-				g_fs_read_directory_status rstat;
-				entry = g_read_directory_s(iter, &rstat);
+			int32_t count;
+			while ((count = g_read_directory_batch(iter, buffer, buffer_length)) > 0) {
+				uint32_t offset = 0;
 
-				if (rstat == G_FS_READ_DIRECTORY_SUCCESSFUL) {
-					if (entry == 0) {
-						break;
-					}
+				for (int32_t i = 0; i < count; i++) {
+					g_fs_directory_record* record = (g_fs_directory_record*) &buffer[offset];
+					offset += record->length;
 
-					if (entry->type == G_FS_NODE_TYPE_FILE) {
+					if (record->type == G_FS_NODE_TYPE_FILE) {
 						screen->write("   ");
-					} else if (entry->type == G_FS_NODE_TYPE_FOLDER) {
+					} else if (record->type == G_FS_NODE_TYPE_FOLDER) {
 						screen->write(" + ");
 					} else {
 						screen->write(" ~ ");
 					}
-					screen->write(entry->name);
+					screen->write(record->name);
 					screen->write("\n");
-				} else {
-					break;
 				}
 			}
 
+			delete[] buffer;
 			g_close_directory(iter);
 		} else {
 			screen->write("failed to read directory\n");
@@ -465,23 +464,41 @@ bool terminal_t::handle_builtin(std::string command) {
 }
 
 /**
- *
+ * Writes everything the process puts to its standard output to the screen. The
+ * calling thread waits on the pipe until the process has closed its end, which
+ * is reported as an error event once no other process references the pipe.
  */
-void terminal_t::standard_out_thread(standard_out_thread_data_t* data) {
+void terminal_t::forward_standard_out(g_fd stdout_read_end, screen_t* screen) {
 
 	int buflen = 512;
 	char buf[buflen];
 
-	while (!data->stop) {
-		g_fs_read_status stat;
-		int r = g_read_s(data->stdout_read_end, buf, buflen, &stat);
+	g_poll_entry entry;
+	entry.type = G_POLL_TYPE_FD;
+	entry.value = stdout_read_end;
+	entry.events = G_POLL_EVENT_READABLE;
+
+	while (true) {
+		if (g_poll(&entry, 1, G_POLL_TIMEOUT_INFINITE) < 0) {
+			break;
+		}
+
+		int r = 0;
+		if (entry.revents & G_POLL_EVENT_READABLE) {
+			r = g_read(stdout_read_end, buf, buflen);
+		}
+
+		if (r > 0) {
+			std::stringstream o;
+			for (int i = 0; i < r; i++) {
+				o << buf[i];
+			}
+			screen->write(o.str());
+			screen->updateCursor();
 
-		std::stringstream o;
-		for (int i = 0; i < r; i++) {
-			o << buf[i];
+		} else if (entry.revents & G_POLL_EVENT_ERROR) {
+			break;
 		}
-		data->screen->write(o.str());
-		data->screen->updateCursor();
 	}
 }
 
@@ -605,14 +622,7 @@ void terminal_t::execute(std::string shortpath, std::string args,
 			g_fd process_stdout = g_clone_fd(process_io[1], process_id,
 					terminal_pid);
 
-			// create threads
-			standard_out_thread_data_t out_data;
-			out_data.stop = false;
-			out_data.stdout_read_end = process_stdout;
-			out_data.screen = screen;
-			g_tid rout = g_create_thread_d((void*) &standard_out_thread,
-					(void*) &out_data);
-
+			// create input thread
 			standard_in_thread_data_t in_data;
 			in_data.stop = false;
 			in_data.stdin_write_end = process_stdin;
@@ -621,16 +631,17 @@ void terminal_t::execute(std::string shortpath, std::string args,
 			g_tid rin = g_create_thread_d((void*) &standard_in_thread,
 					(void*) &in_data);
 
-			// wait for process to exit
+			// forward output until the process has exited
+			forward_standard_out(process_stdout, screen);
 			g_join(process_id);
 			in_data.stop = true;
-			out_data.stop = true;
 
 			screen->write("\n");
 
-			// wait for input/output thread before leaving
-			g_join(rout);
+			// wait for input thread before leaving
 			g_join(rin);
+			g_close(process_stdin);
+			g_close(process_stdout);
 		}
 
 	} else {
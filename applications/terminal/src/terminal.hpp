@@ -96,7 +96,7 @@ public:
 			terminal_input_status_t* out_status, bool* do_break);
 
 	static void standard_in_thread(standard_in_thread_data_t* data);
-	static void standard_out_thread(standard_out_thread_data_t* data);
+	static void forward_standard_out(g_fd stdout_read_end, screen_t* screen);
 
 	bool file_exists(std::string path);
 	bool find_in_path(std::string path, std::string& out);
@@ -21,6 +21,8 @@
 #define TEST_MESSAGING		0
 #define TEST_UI				1
 #define TEST_OLD_MESSAGING	2
+#define TEST_IPC_BENCHMARK	3
+#define TEST_FS_BENCHMARK	4
 
 #define SELECTED_TEST		TEST_UI
 
@@ -30,4 +32,8 @@
 #include "../testsrc/old_messaging.cpp"
 #elif SELECTED_TEST == TEST_UI
 #include "../testsrc/ui.cpp"
+#elif SELECTED_TEST == TEST_IPC_BENCHMARK
+#include "../testsrc/ipc_benchmark.cpp"
+#elif SELECTED_TEST == TEST_FS_BENCHMARK
+#include "../testsrc/fs_benchmark.cpp"
 #endif
@@ -0,0 +1,412 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <ghost.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+/**
+ * Filesystem benchmark. Measures path operations, reads at different sizes,
+ * directory enumeration and pipe throughput on the ramdisk, the tmpfs and a
+ * tasked delegate. The tasked delegate is the example filesystem driver, which
+ * must be started before and is mounted at /testfs; if it is missing, these
+ * tests are skipped.
+ *
+ * Usage: tester.bin [iterations] [directory entries]
+ *
+ * Each result is logged as a single line of the form:
+ * fs-bench: test=<name> target=<ramdisk|tmpfs|testfs|pipe> depth=<n> size=<bytes>
+ * 		ops=<n> total_ms=<ms> ops_per_s=<n> kib_per_s=<kib>
+ */
+
+#define FS_BENCHMARK_DEFAULT_ITERATIONS		1000
+#define FS_BENCHMARK_DEFAULT_ENTRIES		500
+#define FS_BENCHMARK_MAXIMUM_DEPTH			6
+#define FS_BENCHMARK_TMPFS_FILE_LENGTH		0x100000
+#define FS_BENCHMARK_PIPE_LENGTH			0x400000
+#define FS_BENCHMARK_PIPE_CHUNK				0x1000
+#define FS_BENCHMARK_DIRECTORY_BUFFER		0x1000
+#define FS_BENCHMARK_SEED					0x1234
+
+static uint32_t fs_benchmark_read_sizes[] = { 64, 512, 4096, 65536 };
+
+/**
+ * Files that are benchmarked on a target
+ */
+struct fs_benchmark_target_t {
+	const char* name;
+	char paths[FS_BENCHMARK_MAXIMUM_DEPTH + 1][G_PATH_MAX];
+	char large_file[G_PATH_MAX];
+	int64_t large_file_length;
+};
+
+/**
+ *
+ */
+void fs_benchmark_report(const char* test, const char* target, int depth, uint32_t size, uint32_t ops, uint64_t bytes, uint32_t total_ms) {
+
+	uint32_t measured_ms = (total_ms > 0) ? total_ms : 1;
+	uint32_t ops_per_s = (uint32_t) (((uint64_t) ops * 1000) / measured_ms);
+	uint32_t kib_per_s = (uint32_t) ((bytes * 1000) / measured_ms / 1024);
+
+	klog("fs-bench: test=%s target=%s depth=%i size=%i ops=%i total_ms=%i ops_per_s=%i kib_per_s=%i", test, target, depth, size, ops, total_ms, ops_per_s,
+			kib_per_s);
+}
+
+/**
+ * Walks the directory tree and remembers the first file at each depth and the
+ * largest file.
+ */
+void fs_benchmark_find_files(fs_benchmark_target_t* target, const char* path, int depth) {
+
+	if (depth > FS_BENCHMARK_MAXIMUM_DEPTH) {
+		return;
+	}
+
+	g_fs_directory_iterator* iterator = g_open_directory(path);
+	if (iterator == 0) {
+		return;
+	}
+
+	uint8_t* buffer = new uint8_t[FS_BENCHMARK_DIRECTORY_BUFFER];
+	int32_t count;
+	while ((count = g_read_directory_batch(iterator, buffer, FS_BENCHMARK_DIRECTORY_BUFFER)) > 0) {
+		uint32_t offset = 0;
+
+		for (int32_t i = 0; i < count; i++) {
+			g_fs_directory_record* record = (g_fs_directory_record*) &buffer[offset];
+			offset += record->length;
+
+			char child[G_PATH_MAX];
+			snprintf(child, G_PATH_MAX, "%s/%s", path, record->name);
+
+			if (record->type == G_FS_NODE_TYPE_FOLDER) {
+				fs_benchmark_find_files(target, child, depth + 1);
+
+			} else if (record->type == G_FS_NODE_TYPE_FILE) {
+				if (target->paths[depth][0] == 0) {
+					strcpy(target->paths[depth], child);
+				}
+
+				int64_t length = g_flength(child);
+				if (length > target->large_file_length) {
+					target->large_file_length = length;
+					strcpy(target->large_file, child);
+				}
+			}
+		}
+	}
+
+	delete[] buffer;
+	g_close_directory(iterator);
+}
+
+/**
+ * Creates a chain of folders on the tmpfs with a file at each depth; the large
+ * file is filled with a pattern.
+ */
+void fs_benchmark_prepare_tmpfs(fs_benchmark_target_t* target) {
+
+	char path[G_PATH_MAX];
+	strcpy(path, "/tmp/fsbench");
+	g_create_directory(path);
+
+	for (int depth = 1; depth <= FS_BENCHMARK_MAXIMUM_DEPTH; depth++) {
+		snprintf(target->paths[depth], G_PATH_MAX, "%s/file", path);
+		g_fd fd = g_open_f(target->paths[depth], G_FILE_FLAG_MODE_WRITE | G_FILE_FLAG_MODE_CREATE);
+		g_close(fd);
+
+		strcat(path, "/d");
+		g_create_directory(path);
+	}
+
+	uint8_t* pattern = new uint8_t[FS_BENCHMARK_PIPE_CHUNK];
+	memset(pattern, 0x55, FS_BENCHMARK_PIPE_CHUNK);
+
+	strcpy(target->large_file, "/tmp/fsbench/large");
+	g_fd fd = g_open_f(target->large_file, G_FILE_FLAG_MODE_WRITE | G_FILE_FLAG_MODE_CREATE | G_FILE_FLAG_MODE_TRUNCATE);
+
+	uint64_t start = g_millis();
+	int64_t written = 0;
+	while (written < FS_BENCHMARK_TMPFS_FILE_LENGTH) {
+		int32_t w = g_write(fd, pattern, FS_BENCHMARK_PIPE_CHUNK);
+		if (w <= 0) {
+			break;
+		}
+		written += w;
+	}
+	uint32_t total_ms = g_millis() - start;
+
+	g_close(fd);
+	delete[] pattern;
+
+	target->large_file_length = written;
+	fs_benchmark_report("seq-write", target->name, 0, FS_BENCHMARK_PIPE_CHUNK, written / FS_BENCHMARK_PIPE_CHUNK, written, total_ms);
+}
+
+/**
+ * Opens and closes the file at each depth
+ */
+void fs_benchmark_open_close(fs_benchmark_target_t* target, uint32_t iterations) {
+
+	for (int depth = 0; depth <= FS_BENCHMARK_MAXIMUM_DEPTH; depth++) {
+		const char* path = target->paths[depth];
+		if (path[0] == 0) {
+			continue;
+		}
+
+		uint64_t start = g_millis();
+		uint32_t ops = 0;
+		for (uint32_t i = 0; i < iterations; i++) {
+			g_fd fd = g_open(path);
+			if (fd == -1) {
+				klog("fs-bench: failed to open '%s'", path);
+				break;
+			}
+			g_close(fd);
+			++ops;
+		}
+		fs_benchmark_report("open-close", target->name, depth, 0, ops, 0, g_millis() - start);
+	}
+}
+
+/**
+ * Calls stat on the file at each depth
+ */
+void fs_benchmark_stat(fs_benchmark_target_t* target, uint32_t iterations) {
+
+	for (int depth = 0; depth <= FS_BENCHMARK_MAXIMUM_DEPTH; depth++) {
+		const char* path = target->paths[depth];
+		if (path[0] == 0) {
+			continue;
+		}
+
+		struct stat buf;
+		uint64_t start = g_millis();
+		uint32_t ops = 0;
+		for (uint32_t i = 0; i < iterations; i++) {
+			if (stat(path, &buf) != 0) {
+				klog("fs-bench: failed to stat '%s'", path);
+				break;
+			}
+			++ops;
+		}
+		fs_benchmark_report("stat", target->name, depth, 0, ops, 0, g_millis() - start);
+	}
+}
+
+/**
+ * Reads the large file of the target sequentially and at random offsets
+ */
+void fs_benchmark_reads(fs_benchmark_target_t* target, uint32_t iterations) {
+
+	if (target->large_file[0] == 0 || target->large_file_length <= 0) {
+		klog("fs-bench: no file to read on %s", target->name);
+		return;
+	}
+
+	g_fd fd = g_open_f(target->large_file, G_FILE_FLAG_MODE_READ);
+	if (fd == -1) {
+		klog("fs-bench: failed to open '%s'", target->large_file);
+		return;
+	}
+
+	int size_count = sizeof(fs_benchmark_read_sizes) / sizeof(uint32_t);
+	uint8_t* buffer = new uint8_t[fs_benchmark_read_sizes[size_count - 1]];
+
+	for (int s = 0; s < size_count; s++) {
+		uint32_t size = fs_benchmark_read_sizes[s];
+
+		// sequential, starting over at the end of the file
+		g_seek(fd, 0, G_FS_SEEK_SET);
+		uint64_t bytes = 0;
+		uint64_t start = g_millis();
+		for (uint32_t i = 0; i < iterations; i++) {
+			int32_t r = g_read(fd, buffer, size);
+			if (r <= 0) {
+				g_seek(fd, 0, G_FS_SEEK_SET);
+				continue;
+			}
+			bytes += r;
+		}
+		fs_benchmark_report("seq-read", target->name, 0, size, iterations, bytes, g_millis() - start);
+
+		// random offsets within the file
+		srand(FS_BENCHMARK_SEED);
+		int64_t range = target->large_file_length > size ? target->large_file_length - size : 1;
+		bytes = 0;
+		start = g_millis();
+		for (uint32_t i = 0; i < iterations; i++) {
+			g_seek(fd, rand() % range, G_FS_SEEK_SET);
+			int32_t r = g_read(fd, buffer, size);
+			if (r > 0) {
+				bytes += r;
+			}
+		}
+		fs_benchmark_report("rand-read", target->name, 0, size, iterations, bytes, g_millis() - start);
+	}
+
+	delete[] buffer;
+	g_close(fd);
+}
+
+/**
+ * Creates a large directory on the tmpfs and enumerates it entry by entry and
+ * in batches
+ */
+void fs_benchmark_directories(uint32_t entries, uint32_t iterations) {
+
+	const char* directory = "/tmp/fsbench/entries";
+	g_create_directory(directory);
+
+	char path[G_PATH_MAX];
+	for (uint32_t i = 0; i < entries; i++) {
+		snprintf(path, G_PATH_MAX, "%s/entry-%i", directory, i);
+		g_fd fd = g_open_f(path, G_FILE_FLAG_MODE_WRITE | G_FILE_FLAG_MODE_CREATE);
+		g_close(fd);
+	}
+
+	// fewer runs, each run reads all entries
+	uint32_t runs = iterations / 100 > 0 ? iterations / 100 : 1;
+
+	uint64_t start = g_millis();
+	uint32_t read = 0;
+	for (uint32_t r = 0; r < runs; r++) {
+		g_fs_directory_iterator* iterator = g_open_directory(directory);
+		while (g_read_directory(iterator)) {
+			++read;
+		}
+		g_close_directory(iterator);
+	}
+	fs_benchmark_report("readdir", "tmpfs", 0, entries, read, 0, g_millis() - start);
+
+	uint8_t* buffer = new uint8_t[FS_BENCHMARK_DIRECTORY_BUFFER];
+	start = g_millis();
+	read = 0;
+	for (uint32_t r = 0; r < runs; r++) {
+		g_fs_directory_iterator* iterator = g_open_directory(directory);
+		int32_t count;
+		while ((count = g_read_directory_batch(iterator, buffer, FS_BENCHMARK_DIRECTORY_BUFFER)) > 0) {
+			read += count;
+		}
+		g_close_directory(iterator);
+	}
+	fs_benchmark_report("readdir-batch", "tmpfs", 0, entries, read, 0, g_millis() - start);
+	delete[] buffer;
+}
+
+/**
+ * Writes to a pipe and reads from it again within this thread, so the pipe
+ * never blocks
+ */
+void fs_benchmark_pipe() {
+
+	g_fd write_end;
+	g_fd read_end;
+	g_pipe(&write_end, &read_end);
+
+	uint8_t* buffer = new uint8_t[FS_BENCHMARK_PIPE_CHUNK];
+	memset(buffer, 0x55, FS_BENCHMARK_PIPE_CHUNK);
+
+	uint64_t bytes = 0;
+	uint32_t ops = 0;
+	uint64_t start = g_millis();
+	while (bytes < FS_BENCHMARK_PIPE_LENGTH) {
+		int32_t w = g_write(write_end, buffer, FS_BENCHMARK_PIPE_CHUNK);
+		int32_t r = g_read(read_end, buffer, FS_BENCHMARK_PIPE_CHUNK);
+		if (w <= 0 || r <= 0) {
+			klog("fs-bench: pipe transfer failed");
+			break;
+		}
+		bytes += r;
+		ops += 2;
+	}
+	fs_benchmark_report("pipe", "pipe", 0, FS_BENCHMARK_PIPE_CHUNK, ops, bytes, g_millis() - start);
+
+	delete[] buffer;
+	g_close(write_end);
+	g_close(read_end);
+}
+
+/**
+ *
+ */
+int main(int argc, char* argv[]) {
+
+	uint32_t iterations = FS_BENCHMARK_DEFAULT_ITERATIONS;
+	uint32_t entries = FS_BENCHMARK_DEFAULT_ENTRIES;
+
+	if (argc > 1) {
+		int value = atoi(argv[1]);
+		if (value > 0) {
+			iterations = value;
+		}
+	}
+	if (argc > 2) {
+		int value = atoi(argv[2]);
+		if (value > 0) {
+			entries = value;
+		}
+	}
+
+	klog("fs-bench: start iterations=%i entries=%i", iterations, entries);
+
+	fs_benchmark_target_t* ramdisk = new fs_benchmark_target_t();
+	memset(ramdisk, 0, sizeof(fs_benchmark_target_t));
+	ramdisk->name = "ramdisk";
+	fs_benchmark_find_files(ramdisk, "/ramdisk", 0);
+
+	fs_benchmark_target_t* tmpfs = new fs_benchmark_target_t();
+	memset(tmpfs, 0, sizeof(fs_benchmark_target_t));
+	tmpfs->name = "tmpfs";
+	fs_benchmark_prepare_tmpfs(tmpfs);
+
+	// the example driver only knows a few files of 1024 bytes in its root
+	fs_benchmark_target_t* testfs = new fs_benchmark_target_t();
+	memset(testfs, 0, sizeof(fs_benchmark_target_t));
+	testfs->name = "testfs";
+	g_fd probe = g_open("/testfs/file0");
+	if (probe != -1) {
+		g_close(probe);
+		strcpy(testfs->paths[1], "/testfs/file0");
+		strcpy(testfs->large_file, "/testfs/file0");
+		testfs->large_file_length = 1024;
+	} else {
+		klog("fs-bench: /testfs is not mounted, skipping tasked delegate");
+		testfs = 0;
+	}
+
+	fs_benchmark_target_t* targets[] = { ramdisk, tmpfs, testfs };
+	for (int t = 0; t < 3; t++) {
+		if (targets[t] == 0) {
+			continue;
+		}
+		fs_benchmark_open_close(targets[t], iterations);
+		fs_benchmark_stat(targets[t], iterations);
+		fs_benchmark_reads(targets[t], iterations);
+	}
+
+	fs_benchmark_directories(entries, iterations);
+	fs_benchmark_pipe();
+
+	klog("fs-bench: done");
+}
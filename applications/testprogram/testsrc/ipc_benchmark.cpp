@@ -0,0 +1,364 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <ghost.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * IPC benchmark. Measures ping-pong latency and one-way throughput between
+ * two threads for the different IPC mechanisms, once with both threads on the
+ * same core and once on different cores.
+ *
+ * Usage: tester.bin [iterations] [payload size]...
+ *
+ * Each result is logged as a single line of the form:
+ * ipc-bench: mechanism=<name> test=<latency|throughput> placement=<same-core|other-core>
+ * 		payload=<bytes> iterations=<n> total_ms=<ms> avg_us=<us> kib_per_s=<kib>
+ */
+
+#define IPC_BENCHMARK_DEFAULT_ITERATIONS	1000
+#define IPC_BENCHMARK_MAXIMUM_PAYLOAD		1024
+#define IPC_BENCHMARK_MAXIMUM_PAYLOADS		8
+#define IPC_BENCHMARK_SHARED_SLOTS			4
+
+#define IPC_BENCHMARK_TO_ECHO				0
+#define IPC_BENCHMARK_TO_MAIN				1
+
+/**
+ * Slot within a shared memory channel. The atoms are always inverse to each other,
+ * because {g_atomic_block} can only wait for an atom to become false.
+ */
+struct ipc_benchmark_slot_t {
+	uint8_t full;
+	uint8_t empty;
+	uint8_t data[IPC_BENCHMARK_MAXIMUM_PAYLOAD];
+};
+
+/**
+ * Shared memory channel, a ring of slots.
+ */
+struct ipc_benchmark_channel_t {
+	ipc_benchmark_slot_t slots[IPC_BENCHMARK_SHARED_SLOTS];
+	uint32_t next_write;
+	uint32_t next_read;
+};
+
+/**
+ * Shared memory area, one channel per direction.
+ */
+struct ipc_benchmark_shared_t {
+	ipc_benchmark_channel_t channels[2];
+};
+
+struct ipc_benchmark_run_t;
+
+/**
+ * An IPC mechanism
+ */
+struct ipc_benchmark_mechanism_t {
+	const char* name;
+	bool fixed_payload;
+	void (*setup)(ipc_benchmark_run_t* run);
+	void (*teardown)(ipc_benchmark_run_t* run);
+	void (*send)(ipc_benchmark_run_t* run, int direction, uint8_t* buffer, uint32_t length);
+	void (*receive)(ipc_benchmark_run_t* run, int direction, uint8_t* buffer, uint32_t length);
+};
+
+/**
+ * State of a single benchmark run
+ */
+struct ipc_benchmark_run_t {
+	ipc_benchmark_mechanism_t* mechanism;
+	bool throughput;
+	uint32_t payload;
+	uint32_t iterations;
+
+	g_tid main_tid;
+	volatile g_tid echo_tid;
+
+	g_message_transaction transaction;
+	g_fd pipes[2][2];
+	ipc_benchmark_shared_t* shared[2];
+};
+
+/**
+ * Messages (g_send_message/g_receive_message)
+ */
+void ipc_benchmark_message_setup(ipc_benchmark_run_t* run) {
+	run->transaction = g_ipc_next_topic();
+}
+
+void ipc_benchmark_message_teardown(ipc_benchmark_run_t* run) {
+}
+
+void ipc_benchmark_message_send(ipc_benchmark_run_t* run, int direction, uint8_t* buffer, uint32_t length) {
+	g_tid target = (direction == IPC_BENCHMARK_TO_ECHO) ? run->echo_tid : run->main_tid;
+	g_send_message_t(target, buffer, length, run->transaction);
+}
+
+void ipc_benchmark_message_receive(ipc_benchmark_run_t* run, int direction, uint8_t* buffer, uint32_t length) {
+	size_t buflen = sizeof(g_message_header) + IPC_BENCHMARK_MAXIMUM_PAYLOAD;
+	uint8_t buf[buflen];
+	if (g_receive_message_t(buf, buflen, run->transaction) == G_MESSAGE_RECEIVE_STATUS_SUCCESSFUL) {
+		memcpy(buffer, G_MESSAGE_CONTENT(buf), length);
+	}
+}
+
+/**
+ * Topic messages (g_send_msg/g_recv_topic_msg), have a fixed size
+ */
+void ipc_benchmark_topic_send(ipc_benchmark_run_t* run, int direction, uint8_t* buffer, uint32_t length) {
+	g_tid target = (direction == IPC_BENCHMARK_TO_ECHO) ? run->echo_tid : run->main_tid;
+
+	g_message_empty(message);
+	message.topic = run->transaction;
+	message.parameterA = buffer[0];
+
+	// queues are limited and sending does not block
+	while (g_send_msg(target, &message) == G_MESSAGE_SEND_STATUS_QUEUE_FULL) {
+		g_yield();
+	}
+}
+
+void ipc_benchmark_topic_receive(ipc_benchmark_run_t* run, int direction, uint8_t* buffer, uint32_t length) {
+	g_message message;
+	g_recv_topic_msg(g_get_tid(), run->transaction, &message);
+	buffer[0] = message.parameterA;
+}
+
+/**
+ * Pipes
+ */
+void ipc_benchmark_pipe_setup(ipc_benchmark_run_t* run) {
+	g_pipe(&run->pipes[IPC_BENCHMARK_TO_ECHO][0], &run->pipes[IPC_BENCHMARK_TO_ECHO][1]);
+	g_pipe(&run->pipes[IPC_BENCHMARK_TO_MAIN][0], &run->pipes[IPC_BENCHMARK_TO_MAIN][1]);
+}
+
+void ipc_benchmark_pipe_teardown(ipc_benchmark_run_t* run) {
+	for (int i = 0; i < 2; i++) {
+		g_close(run->pipes[i][0]);
+		g_close(run->pipes[i][1]);
+	}
+}
+
+void ipc_benchmark_pipe_send(ipc_benchmark_run_t* run, int direction, uint8_t* buffer, uint32_t length) {
+	uint32_t written = 0;
+	while (written < length) {
+		int32_t w = g_write(run->pipes[direction][0], &buffer[written], length - written);
+		if (w > 0) {
+			written += w;
+		} else {
+			// both ends are in this process, so the pipe does not block
+			g_yield();
+		}
+	}
+}
+
+void ipc_benchmark_pipe_receive(ipc_benchmark_run_t* run, int direction, uint8_t* buffer, uint32_t length) {
+	uint32_t read = 0;
+	while (read < length) {
+		int32_t r = g_read(run->pipes[direction][1], &buffer[read], length - read);
+		if (r > 0) {
+			read += r;
+		} else {
+			g_yield();
+		}
+	}
+}
+
+/**
+ * Shared memory (g_share_mem), the echo thread uses the second mapping
+ */
+void ipc_benchmark_shared_setup(ipc_benchmark_run_t* run) {
+	ipc_benchmark_shared_t* shared = (ipc_benchmark_shared_t*) g_alloc_mem(sizeof(ipc_benchmark_shared_t));
+	memset(shared, 0, sizeof(ipc_benchmark_shared_t));
+	for (int c = 0; c < 2; c++) {
+		for (int s = 0; s < IPC_BENCHMARK_SHARED_SLOTS; s++) {
+			shared->channels[c].slots[s].empty = true;
+		}
+	}
+
+	run->shared[0] = shared;
+	run->shared[1] = (ipc_benchmark_shared_t*) g_share_mem(shared, sizeof(ipc_benchmark_shared_t), g_get_pid());
+}
+
+void ipc_benchmark_shared_teardown(ipc_benchmark_run_t* run) {
+	g_unmap(run->shared[1]);
+	g_unmap(run->shared[0]);
+}
+
+void ipc_benchmark_shared_send(ipc_benchmark_run_t* run, int direction, uint8_t* buffer, uint32_t length) {
+	ipc_benchmark_shared_t* shared = run->shared[direction == IPC_BENCHMARK_TO_ECHO ? 0 : 1];
+	ipc_benchmark_channel_t* channel = &shared->channels[direction];
+	ipc_benchmark_slot_t* slot = &channel->slots[channel->next_write];
+	channel->next_write = (channel->next_write + 1) % IPC_BENCHMARK_SHARED_SLOTS;
+
+	g_atomic_block(&slot->full);
+	memcpy(slot->data, buffer, length);
+	__sync_synchronize();
+	slot->full = true;
+	slot->empty = false;
+}
+
+void ipc_benchmark_shared_receive(ipc_benchmark_run_t* run, int direction, uint8_t* buffer, uint32_t length) {
+	ipc_benchmark_shared_t* shared = run->shared[direction == IPC_BENCHMARK_TO_ECHO ? 1 : 0];
+	ipc_benchmark_channel_t* channel = &shared->channels[direction];
+	ipc_benchmark_slot_t* slot = &channel->slots[channel->next_read];
+	channel->next_read = (channel->next_read + 1) % IPC_BENCHMARK_SHARED_SLOTS;
+
+	g_atomic_block(&slot->empty);
+	memcpy(buffer, slot->data, length);
+	__sync_synchronize();
+	slot->empty = true;
+	slot->full = false;
+}
+
+static ipc_benchmark_mechanism_t ipc_benchmark_mechanisms[] = {
+	{ "message", false, ipc_benchmark_message_setup, ipc_benchmark_message_teardown, ipc_benchmark_message_send, ipc_benchmark_message_receive },
+	{ "topic-message", true, ipc_benchmark_message_setup, ipc_benchmark_message_teardown, ipc_benchmark_topic_send, ipc_benchmark_topic_receive },
+	{ "pipe", false, ipc_benchmark_pipe_setup, ipc_benchmark_pipe_teardown, ipc_benchmark_pipe_send, ipc_benchmark_pipe_receive },
+	{ "shared-memory", false, ipc_benchmark_shared_setup, ipc_benchmark_shared_teardown, ipc_benchmark_shared_send, ipc_benchmark_shared_receive }
+};
+
+/**
+ * Echo side of a run. For latency runs each payload is sent back, for
+ * throughput runs only a single acknowledgement after all payloads.
+ */
+void ipc_benchmark_echo_thread(ipc_benchmark_run_t* run) {
+
+	uint8_t buffer[IPC_BENCHMARK_MAXIMUM_PAYLOAD];
+	ipc_benchmark_mechanism_t* mechanism = run->mechanism;
+
+	run->echo_tid = g_get_tid();
+
+	for (uint32_t i = 0; i < run->iterations; i++) {
+		mechanism->receive(run, IPC_BENCHMARK_TO_ECHO, buffer, run->payload);
+		if (!run->throughput) {
+			mechanism->send(run, IPC_BENCHMARK_TO_MAIN, buffer, run->payload);
+		}
+	}
+
+	if (run->throughput) {
+		mechanism->send(run, IPC_BENCHMARK_TO_MAIN, buffer, 1);
+	}
+}
+
+/**
+ *
+ */
+void ipc_benchmark_run(ipc_benchmark_mechanism_t* mechanism, bool throughput, g_thread_placement placement, uint32_t payload, uint32_t iterations) {
+
+	uint8_t buffer[IPC_BENCHMARK_MAXIMUM_PAYLOAD];
+	memset(buffer, 0x55, payload);
+
+	ipc_benchmark_run_t run;
+	run.mechanism = mechanism;
+	run.throughput = throughput;
+	run.payload = payload;
+	run.iterations = iterations;
+	run.main_tid = g_get_tid();
+	run.echo_tid = 0;
+	mechanism->setup(&run);
+
+	g_tid echo = g_create_thread_dp((void*) ipc_benchmark_echo_thread, &run, placement);
+	while (run.echo_tid == 0) {
+		g_yield();
+	}
+
+	uint64_t start = g_millis();
+	for (uint32_t i = 0; i < iterations; i++) {
+		mechanism->send(&run, IPC_BENCHMARK_TO_ECHO, buffer, payload);
+		if (!throughput) {
+			mechanism->receive(&run, IPC_BENCHMARK_TO_MAIN, buffer, payload);
+		}
+	}
+	if (throughput) {
+		mechanism->receive(&run, IPC_BENCHMARK_TO_MAIN, buffer, 1);
+	}
+	uint32_t total_ms = g_millis() - start;
+
+	g_join(echo);
+	mechanism->teardown(&run);
+
+	// a message round-trip transfers the payload twice
+	uint64_t bytes = (uint64_t) payload * iterations * (throughput ? 1 : 2);
+	uint32_t measured_ms = (total_ms > 0) ? total_ms : 1;
+	uint32_t avg_us = (uint32_t) (((uint64_t) total_ms * 1000) / iterations);
+	uint32_t kib_per_s = (uint32_t) ((bytes * 1000) / measured_ms / 1024);
+
+	klog("ipc-bench: mechanism=%s test=%s placement=%s payload=%i iterations=%i total_ms=%i avg_us=%i kib_per_s=%i", mechanism->name,
+			throughput ? "throughput" : "latency", (placement == G_THREAD_PLACEMENT_SAME_CORE) ? "same-core" : "other-core", payload, iterations, total_ms,
+			avg_us, kib_per_s);
+}
+
+/**
+ *
+ */
+int main(int argc, char* argv[]) {
+
+	uint32_t iterations = IPC_BENCHMARK_DEFAULT_ITERATIONS;
+	uint32_t payloads[IPC_BENCHMARK_MAXIMUM_PAYLOADS] = { 16, 64, 256, 1024 };
+	int payload_count = 4;
+
+	if (argc > 1) {
+		int value = atoi(argv[1]);
+		if (value > 0) {
+			iterations = value;
+		}
+	}
+
+	if (argc > 2) {
+		payload_count = 0;
+		for (int i = 2; i < argc && payload_count < IPC_BENCHMARK_MAXIMUM_PAYLOADS; i++) {
+			int value = atoi(argv[i]);
+			if (value > 0 && value <= IPC_BENCHMARK_MAXIMUM_PAYLOAD) {
+				payloads[payload_count++] = value;
+			} else {
+				klog("ipc-bench: skipping invalid payload size '%s'", argv[i]);
+			}
+		}
+	}
+
+	klog("ipc-bench: start iterations=%i payloads=%i", iterations, payload_count);
+
+	g_thread_placement placements[] = { G_THREAD_PLACEMENT_SAME_CORE, G_THREAD_PLACEMENT_OTHER_CORE };
+	int mechanism_count = sizeof(ipc_benchmark_mechanisms) / sizeof(ipc_benchmark_mechanism_t);
+
+	for (int p = 0; p < 2; p++) {
+		for (int m = 0; m < mechanism_count; m++) {
+			ipc_benchmark_mechanism_t* mechanism = &ipc_benchmark_mechanisms[m];
+
+			for (int s = 0; s < payload_count; s++) {
+				uint32_t payload = mechanism->fixed_payload ? sizeof(g_message) : payloads[s];
+
+				ipc_benchmark_run(mechanism, false, placements[p], payload, iterations);
+				ipc_benchmark_run(mechanism, true, placements[p], payload, iterations);
+
+				if (mechanism->fixed_payload) {
+					break;
+				}
+			}
+		}
+	}
+
+	klog("ipc-bench: done");
+}
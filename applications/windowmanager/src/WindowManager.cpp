@@ -119,6 +119,9 @@ void WindowManager::systemLoop() {
 	// register as main
 	g_task_register_id("windowserver:main");
 
+	// Create the event that is signaled when rendering is required
+	renderEvent = g_event_create();
+
 	// Initialize the input manager
 	InputManager::initialize();
 
@@ -161,9 +164,6 @@ void WindowManager::systemLoop() {
 	global.resize(screenBounds.width, screenBounds.height);
 	while (true) {
 
-		// Set render atom
-		renderAtom = true;
-
 		// Handle waiting events
 		keyEventQueueLock.lock();
 		while (keyEventQueue.size() > 0) {
@@ -197,7 +197,7 @@ void WindowManager::systemLoop() {
 		outputDirty(screen->grabInvalid(), screenBounds, global.getBuffer());
 
 		// Wait until another render is requested
-		g_atomic_wait(&renderAtom);
+		g_event_wait(renderEvent);
 	}
 }
 
@@ -212,7 +212,7 @@ void WindowManager::addToScreen(Component* comp) {
  *
  */
 void WindowManager::markForRender() {
-	renderAtom = false;
+	g_event_signal(renderEvent);
 }
 
 /**
@@ -45,7 +45,7 @@ class TextRenderer;
  */
 class WindowManager {
 private:
-	uint8_t renderAtom;
+	g_fd renderEvent;
 	screen_t* screen;
 
 	int multiclickTimespan;
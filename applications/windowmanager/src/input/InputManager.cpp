@@ -25,30 +25,36 @@
  *
  */
 void InputManager::initialize() {
-	g_create_thread((void*) InputManager::mouseReceiverThread);
-	g_create_thread((void*) InputManager::keyReceiverThread);
+	g_create_thread((void*) InputManager::inputReceiverThread);
 }
 
 /**
- *
+ * Receives both keyboard and mouse input, waiting for whichever
+ * of the two arrives first.
  */
-void InputManager::keyReceiverThread() {
+void InputManager::inputReceiverThread() {
 
-	g_task_register_id("windowserver:key-recv");
-	while (true) {
-		g_key_info info = g_keyboard::readKey();
-		WindowManager::getInstance()->queueKeyEvent(info);
-	}
-}
+	g_task_register_id("windowserver:input-recv");
 
-/**
- *
- */
-void InputManager::mouseReceiverThread() {
+	g_poll_entry entries[2];
+	entries[0].type = G_POLL_TYPE_SUBSCRIPTION;
+	entries[0].value = g_keyboard::getSubscription();
+	entries[0].events = G_POLL_EVENT_READABLE;
+	entries[1].type = G_POLL_TYPE_SUBSCRIPTION;
+	entries[1].value = g_mouse::getSubscription();
+	entries[1].events = G_POLL_EVENT_READABLE;
 
-	g_task_register_id("windowserver:mouse-recv");
 	while (true) {
-		g_mouse_info info = g_mouse::readMouse();
-		WindowManager::getInstance()->queueMouseEvent(info);
+		g_poll(entries, 2, G_POLL_TIMEOUT_INFINITE);
+
+		if (entries[0].revents & G_POLL_EVENT_READABLE) {
+			g_key_info info = g_keyboard::readKey();
+			WindowManager::getInstance()->queueKeyEvent(info);
+		}
+
+		if (entries[1].revents & G_POLL_EVENT_READABLE) {
+			g_mouse_info info = g_mouse::readMouse();
+			WindowManager::getInstance()->queueMouseEvent(info);
+		}
 	}
 }
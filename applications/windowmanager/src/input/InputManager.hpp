@@ -29,8 +29,7 @@
 class InputManager {
 public:
 	static void initialize();
-	static void mouseReceiverThread();
-	static void keyReceiverThread();
+	static void inputReceiverThread();
 };
 
 #endif
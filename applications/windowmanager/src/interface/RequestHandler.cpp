@@ -53,7 +53,8 @@ static std::map<g_pid, UIRegisteredProcessData> processMap;
 /**
  * Event dispatch thread data
  */
-static uint8_t event_dispatch_events_empty = true;
+static g_fd event_dispatch_event = -1;
+static uint8_t event_dispatch_queue_lock = false;
 static std::deque<UIEventDispatchData> event_dispatch_queue;
 
 /**
@@ -68,6 +69,10 @@ void RequestHandler::run() {
 
 	uint32_t tid = g_get_tid();
 
+	// one event dispatch thread serves all processes
+	event_dispatch_event = g_event_create();
+	g_create_thread((void*) &event_dispatch_thread);
+
 	g_logger::log("window manager: ready for requests");
 	while (true) {
 		g_message* request = new g_message;
@@ -196,58 +201,73 @@ void RequestHandler::event_dispatch_thread() {
 
 	while (true) {
 		// wait for events
-		g_atomic_block(&event_dispatch_events_empty);
+		g_event_wait(event_dispatch_event);
 
-		// lock
-		g_atomic_wait(&sending_locked);
+		// dispatch all queued events
+		while (true) {
+			g_atomic_wait(&event_dispatch_queue_lock);
+			if (event_dispatch_queue.empty()) {
+				event_dispatch_queue_lock = false;
+				break;
+			}
 
-		// call listener
-		UIEventDispatchData ldata = event_dispatch_queue.back();
-		event_dispatch_queue.pop_back();
-
-		// write transaction id
-		uint32_t idlen = sizeof(g_ui_transaction_id);
-		uint8_t idbytes[idlen];
-		*((g_ui_transaction_id*) idbytes) = 0;
-		g_write(ldata.output, idbytes, idlen);
+			UIEventDispatchData ldata = event_dispatch_queue.back();
+			event_dispatch_queue.pop_back();
+			event_dispatch_queue_lock = false;
 
-		// write length
-		uint32_t lenlen = sizeof(uint32_t);
-		uint8_t lenbytes[lenlen];
-		*((uint32_t*) lenbytes) = ldata.length + 4;
-		g_write(ldata.output, lenbytes, lenlen);
-
-		// write listener id
-		uint32_t lidlen = sizeof(uint32_t);
-		uint8_t lidbytes[lidlen];
-		*((uint32_t*) lidbytes) = ldata.listener;
-		g_write(ldata.output, lidbytes, lidlen);
-
-		// write data
-		uint32_t written = 0;
-		while (written < ldata.length) {
-			written += g_write(ldata.output, &ldata.data[written], ldata.length - written);
+			send_dispatched_event(ldata);
 		}
+	}
+}
 
-		// delete the data
-		delete ldata.data;
+/**
+ *
+ */
+void RequestHandler::send_dispatched_event(UIEventDispatchData& ldata) {
 
-		// check if empty
-		if (event_dispatch_queue.empty()) {
-			event_dispatch_events_empty = true;
-		}
+	// lock
+	g_atomic_wait(&sending_locked);
 
-		// unlock
-		sending_locked = false;
+	// write transaction id
+	uint32_t idlen = sizeof(g_ui_transaction_id);
+	uint8_t idbytes[idlen];
+	*((g_ui_transaction_id*) idbytes) = 0;
+	g_write(ldata.output, idbytes, idlen);
+
+	// write length
+	uint32_t lenlen = sizeof(uint32_t);
+	uint8_t lenbytes[lenlen];
+	*((uint32_t*) lenbytes) = ldata.length + 4;
+	g_write(ldata.output, lenbytes, lenlen);
+
+	// write listener id
+	uint32_t lidlen = sizeof(uint32_t);
+	uint8_t lidbytes[lidlen];
+	*((uint32_t*) lidbytes) = ldata.listener;
+	g_write(ldata.output, lidbytes, lidlen);
+
+	// write data
+	uint32_t written = 0;
+	while (written < ldata.length) {
+		written += g_write(ldata.output, &ldata.data[written], ldata.length - written);
 	}
+
+	// delete the data
+	delete ldata.data;
+
+	// unlock
+	sending_locked = false;
 }
 
 /**
  *
  */
 void RequestHandler::event_dispatch_queue_add(const UIEventDispatchData& data) {
+	g_atomic_wait(&event_dispatch_queue_lock);
 	event_dispatch_queue.push_front(data);
-	event_dispatch_events_empty = false;
+	event_dispatch_queue_lock = false;
+
+	g_event_signal(event_dispatch_event);
 }
 
 /**
@@ -297,9 +317,6 @@ void RequestHandler::handling_thread(g_message* _request) {
 	// add process
 	add_process(requester_pid, requester_out, requester_in);
 
-	// start event dispatch thread
-	g_create_thread((void*) &event_dispatch_thread);
-
 	while (true) {
 		// read transaction id
 		uint32_t idlen = sizeof(g_ui_transaction_id);
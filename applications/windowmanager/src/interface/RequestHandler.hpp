@@ -69,6 +69,7 @@ public:
 
 	static void event_dispatch_thread();
 	static void event_dispatch_queue_add(const UIEventDispatchData& data);
+	static void send_dispatched_event(UIEventDispatchData& data);
 };
 
 #endif
@@ -56,6 +56,8 @@ __BEGIN_C
 #define G_SYSCALL_RESTORE_INTERRUPTED_STATE		0x115
 #define G_SYSCALL_REGISTER_SIGNAL_HANDLER		0x116
 #define G_SYSCALL_RAISE_SIGNAL					0x117
+#define G_SYSCALL_POLL							0x118
+#define G_SYSCALL_YIELD_TO						0x119
 
 #define G_SYSCALL_CALL_VM86						0x201
 #define G_SYSCALL_LOWER_MEMORY_ALLOCATE			0x202
@@ -84,6 +86,11 @@ __BEGIN_C
 #define G_SYSCALL_MESSAGE_SEND					0x406
 #define G_SYSCALL_MESSAGE_RECEIVE				0x407
 #define G_SYSCALL_MESSAGE_RECEIVE_TRANSACTION	0x408
+#define G_SYSCALL_TOPIC_OPEN					0x409
+#define G_SYSCALL_TOPIC_SUBSCRIBE				0x40A
+#define G_SYSCALL_TOPIC_UNSUBSCRIBE				0x40B
+#define G_SYSCALL_TOPIC_PUBLISH					0x40C
+#define G_SYSCALL_TOPIC_RECEIVE					0x40D
 
 #define G_SYSCALL_RAMDISK_FIND					0x501
 #define G_SYSCALL_RAMDISK_FIND_CHILD			0x502
@@ -110,6 +117,21 @@ __BEGIN_C
 #define G_SYSCALL_FS_OPEN_DIRECTORY				0x60F
 #define G_SYSCALL_FS_READ_DIRECTORY				0x610
 #define G_SYSCALL_FS_CLOSE_DIRECTORY			0x611
+#define G_SYSCALL_FS_EVENT_CREATE				0x612
+#define G_SYSCALL_FS_EVENT_SIGNAL				0x613
+#define G_SYSCALL_FS_EVENT_WAIT					0x614
+#define G_SYSCALL_FS_CACHE_INVALIDATE			0x615
+#define G_SYSCALL_FS_IO_RING_SETUP				0x616
+#define G_SYSCALL_FS_IO_RING_ENTER				0x617
+#define G_SYSCALL_FS_READ_VECTOR				0x618
+#define G_SYSCALL_FS_WRITE_VECTOR				0x619
+#define G_SYSCALL_FS_MAP						0x61A
+#define G_SYSCALL_FS_SPLICE						0x61B
+#define G_SYSCALL_FS_READ_DIRECTORY_BATCH		0x61C
+#define G_SYSCALL_FS_CREATE_DIRECTORY			0x61D
+#define G_SYSCALL_FS_SET_ATTRIBUTES				0x61E
+#define G_SYSCALL_FS_FLUSH						0x61F
+#define G_SYSCALL_FS_SET_WRITE_MODE				0x620
 
 __END_C
 
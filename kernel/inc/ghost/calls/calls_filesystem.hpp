@@ -22,6 +22,7 @@
 #define GHOST_API_CALLS_FILESYSTEMCALLS
 
 #include "ghost/fs.h"
+#include "ghost/io.h"
 
 /**
  * @field path
@@ -100,6 +101,70 @@ typedef struct {
 	int64_t result;
 }__attribute__((packed)) g_syscall_fs_write;
 
+/**
+ * @field fd
+ * 		file descriptor
+ *
+ * @field vector
+ * 		segments to fill one after another
+ *
+ * @field count
+ * 		number of segments
+ *
+ * @field offset
+ * 		offset to read from without changing the offset of the file
+ * 		descriptor, or {G_FS_OFFSET_CURRENT}
+ *
+ * @field status
+ * 		one of the {g_fs_read_status} codes
+ *
+ * @field result
+ * 		total number of bytes read
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_fd fd;
+	g_fs_io_vector* vector;
+	uint32_t count;
+	int64_t offset;
+
+	g_fs_read_status status;
+	int64_t result;
+}__attribute__((packed)) g_syscall_fs_read_vector;
+
+/**
+ * @field fd
+ * 		file descriptor
+ *
+ * @field vector
+ * 		segments to write one after another
+ *
+ * @field count
+ * 		number of segments
+ *
+ * @field offset
+ * 		offset to write at without changing the offset of the file
+ * 		descriptor, or {G_FS_OFFSET_CURRENT}
+ *
+ * @field status
+ * 		one of the {g_fs_write_status} codes
+ *
+ * @field result
+ * 		total number of bytes written
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_fd fd;
+	g_fs_io_vector* vector;
+	uint32_t count;
+	int64_t offset;
+
+	g_fs_write_status status;
+	int64_t result;
+}__attribute__((packed)) g_syscall_fs_write_vector;
+
 /**
  * @field fd
  * 		file descriptor
@@ -116,6 +181,21 @@ typedef struct {
 	uint8_t result;
 }__attribute__((packed)) g_syscall_fs_close;
 
+/**
+ * @field fd
+ * 		file descriptor
+ *
+ * @field status
+ * 		one of the {g_fs_flush_status} codes
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_fd fd;
+
+	g_fs_flush_status status;
+}__attribute__((packed)) g_syscall_fs_flush;
+
 /**
  * @field path
  * 		file path
@@ -187,6 +267,9 @@ typedef struct {
 }__attribute__((packed)) g_syscall_fs_clonefd;
 
 /**
+ * @field capacity
+ * 		capacity of the pipe in bytes, zero for the default capacity
+ *
  * @field write_fd
  * 		write end file descriptor of created pipe
  *
@@ -199,6 +282,8 @@ typedef struct {
  * @security-level APPLICATION
  */
 typedef struct {
+	uint32_t capacity;
+
 	g_fd write_fd;
 	g_fd read_fd;
 	g_fs_pipe_status status;
@@ -413,6 +498,52 @@ typedef struct {
 	g_fs_read_directory_status status;
 }__attribute__((packed)) g_syscall_fs_read_directory;
 
+/**
+ * @field iterator
+ * 		pointer to the iterator
+ *
+ * @field buffer
+ * 		buffer that is filled with {g_fs_directory_record} entries
+ *
+ * @field length
+ * 		length of the buffer in bytes
+ *
+ * @field count
+ * 		number of records that were written
+ *
+ * @field used
+ * 		number of bytes that were written
+ *
+ * @field status
+ * 		one of the {g_fs_read_directory_status} codes
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_fs_directory_iterator* iterator;
+	void* buffer;
+	uint32_t length;
+
+	uint32_t count;
+	uint32_t used;
+	g_fs_read_directory_status status;
+}__attribute__((packed)) g_syscall_fs_read_directory_batch;
+
+/**
+ * @field path
+ * 		path of the directory to create
+ *
+ * @field status
+ * 		one of the {g_fs_create_directory_status} codes
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	char* path;
+
+	g_fs_create_directory_status status;
+}__attribute__((packed)) g_syscall_fs_create_directory;
+
 /**
  * @field iterator
  * 		pointer to the iterator
@@ -423,4 +554,215 @@ typedef struct {
 	g_fs_directory_iterator* iterator;
 }__attribute__((packed)) g_syscall_fs_close_directory;
 
+/**
+ * @field fd
+ * 		file descriptor of the created event
+ *
+ * @field status
+ * 		the call status
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_fd fd;
+	g_event_create_status status;
+}__attribute__((packed)) g_syscall_fs_event_create;
+
+/**
+ * @field fd
+ * 		file descriptor of the event to signal
+ *
+ * @field value
+ * 		value to add to the event counter
+ *
+ * @field status
+ * 		the call status
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_fd fd;
+	uint64_t value;
+	g_event_signal_status status;
+}__attribute__((packed)) g_syscall_fs_event_signal;
+
+/**
+ * @field fd
+ * 		file descriptor of the event to wait for
+ *
+ * @field timeout
+ * 		timeout in milliseconds, {G_EVENT_TIMEOUT_INFINITE} to wait
+ * 		without time limit
+ *
+ * @field count
+ * 		the counter value that was taken from the event
+ *
+ * @field status
+ * 		the call status
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_fd fd;
+	uint64_t timeout;
+	uint64_t count;
+	g_event_wait_status status;
+}__attribute__((packed)) g_syscall_fs_event_wait;
+
+/**
+ * @field node_id
+ * 		id of the node whose cached contents are dropped
+ *
+ * @field offset
+ * 		start of the range to drop
+ *
+ * @field length
+ * 		length of the range to drop, a negative value drops
+ * 		all cached contents of the node
+ *
+ * @field status
+ * 		the call status
+ *
+ * @security-level DRIVER
+ */
+typedef struct {
+	g_fs_virt_id node_id;
+	int64_t offset;
+	int64_t length;
+	g_fs_cache_invalidate_status status;
+}__attribute__((packed)) g_syscall_fs_cache_invalidate;
+
+/**
+ * @field ring
+ * 		is filled with the address of the ring within the process
+ *
+ * @field status
+ * 		the call status
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_io_ring* ring;
+	g_io_ring_setup_status status;
+}__attribute__((packed)) g_syscall_fs_io_ring_setup;
+
+/**
+ * @field minimum_completions
+ * 		number of completions that must be available before the call
+ * 		returns, zero to only submit
+ *
+ * @field submitted
+ * 		is filled with the number of submissions that were taken
+ *
+ * @field status
+ * 		the call status
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	uint32_t minimum_completions;
+	uint32_t submitted;
+	g_io_ring_enter_status status;
+}__attribute__((packed)) g_syscall_fs_io_ring_enter;
+
+/**
+ * @field fd
+ * 		file descriptor of the file to map
+ *
+ * @field offset
+ * 		offset within the file where the mapping starts
+ *
+ * @field length
+ * 		number of bytes to map
+ *
+ * @field flags
+ * 		the {g_fs_map_flags}
+ *
+ * @field address
+ * 		is filled with the address of the byte at the offset
+ *
+ * @field status
+ * 		one of the {g_fs_map_status} codes
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_fd fd;
+	int64_t offset;
+	uint32_t length;
+	g_fs_map_flags flags;
+
+	void* address;
+	g_fs_map_status status;
+}__attribute__((packed)) g_syscall_fs_map;
+
+/**
+ * @field in_fd
+ * 		file descriptor to move data from, a pipe or a file
+ *
+ * @field out_fd
+ * 		file descriptor of the pipe to move data to
+ *
+ * @field length
+ * 		maximum number of bytes to move
+ *
+ * @field status
+ * 		one of the {g_fs_splice_status} codes
+ *
+ * @field result
+ * 		number of bytes that were moved
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_fd in_fd;
+	g_fd out_fd;
+	uint32_t length;
+
+	g_fs_splice_status status;
+	int32_t result;
+}__attribute__((packed)) g_syscall_fs_splice;
+
+/**
+ * @field node_id
+ * 		id of the node whose attributes are set
+ *
+ * @field length
+ * 		length of the node, a negative value only changes the time-to-live
+ *
+ * @field ttl
+ * 		time-to-live of the cached attributes
+ *
+ * @field status
+ * 		one of the {g_fs_set_attributes_status} codes
+ *
+ * @security-level DRIVER
+ */
+typedef struct {
+	g_fs_virt_id node_id;
+	int64_t length;
+	g_fs_attributes_ttl ttl;
+
+	g_fs_set_attributes_status status;
+}__attribute__((packed)) g_syscall_fs_set_attributes;
+
+/**
+ * @field node_id
+ * 		id of a node of the delegate
+ *
+ * @field mode
+ * 		one of the {g_fs_write_mode} values
+ *
+ * @field status
+ * 		one of the {g_fs_set_write_mode_status} codes
+ *
+ * @security-level DRIVER
+ */
+typedef struct {
+	g_fs_virt_id node_id;
+	g_fs_write_mode mode;
+
+	g_fs_set_write_mode_status status;
+}__attribute__((packed)) g_syscall_fs_set_write_mode;
+
 #endif
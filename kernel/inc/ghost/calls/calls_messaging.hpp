@@ -135,4 +135,120 @@ typedef struct {
 	g_message_receive_status status;
 }__attribute__((packed)) g_syscall_receive_message;
 
+/**
+ * @field name
+ * 		name of the topic to open, created if it does not exist
+ *
+ * @field topic
+ * 		id of the topic, -1 if the name was invalid
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	char* name;
+
+	g_topic_id topic;
+}__attribute__((packed)) g_syscall_topic_open;
+
+/**
+ * @field topic
+ * 		id of the topic to subscribe to
+ *
+ * @field policy
+ * 		what to do when the queue of the subscription is full
+ *
+ * @field capacity
+ * 		number of messages the queue of the subscription can hold
+ *
+ * @field subscription
+ * 		id of the subscription, -1 on failure
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_topic_id topic;
+	g_topic_backpressure policy;
+	uint32_t capacity;
+
+	g_topic_subscription subscription;
+}__attribute__((packed)) g_syscall_topic_subscribe;
+
+/**
+ * @field subscription
+ * 		id of the subscription to remove
+ *
+ * @field successful
+ * 		whether the subscription was removed
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_topic_subscription subscription;
+
+	uint8_t successful;
+}__attribute__((packed)) g_syscall_topic_unsubscribe;
+
+/**
+ * @field topic
+ * 		id of the topic to publish to
+ *
+ * @field buffer
+ * 		message buffer
+ *
+ * @field length
+ * 		message length
+ *
+ * @field mode
+ * 		publishing mode
+ *
+ * @field status
+ * 		one of the {g_topic_publish_status} codes
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_topic_id topic;
+	void* buffer;
+	size_t length;
+	g_topic_publish_mode mode;
+
+	g_topic_publish_status status;
+}__attribute__((packed)) g_syscall_topic_publish;
+
+/**
+ * @field subscription
+ * 		id of the subscription to receive from
+ *
+ * @field buffer
+ * 		message buffer
+ *
+ * @field maximum
+ * 		size of the message buffer
+ *
+ * @field mode
+ * 		receiving mode
+ *
+ * @field length
+ * 		length of the received message
+ *
+ * @field dropped
+ * 		number of messages that were dropped from the queue of
+ * 		the subscription since the last receive
+ *
+ * @field status
+ * 		one of the {g_topic_receive_status} codes
+ *
+ * @security-level APPLICATION
+ */
+typedef struct {
+	g_topic_subscription subscription;
+	void* buffer;
+	size_t maximum;
+	g_topic_receive_mode mode;
+
+	size_t length;
+	uint32_t dropped;
+	g_topic_receive_status status;
+}__attribute__((packed)) g_syscall_topic_receive;
+
 #endif
@@ -50,11 +50,15 @@ typedef struct {
  *
  * @field userData
  * 		user-defined
+ *
+ * @field placement
+ * 		one of the {g_thread_placement} values
  */
 typedef struct {
 	void* initialEntry;
 	void* userEntry;
 	void* userData;
+	g_thread_placement placement;
 
 	uint32_t processId;
 }__attribute__((packed)) g_syscall_create_thread;
@@ -23,6 +23,7 @@
 
 #include "ghost/kernel.h"
 #include "ghost/system.h"
+#include "ghost/poll.h"
 
 /**
  * @field code
@@ -88,12 +89,24 @@ typedef struct {
  *
  * @field set_on_finish
  * 		whether or not to set the atom once finished
+ *
+ * @field owner
+ * 		id of the thread that releases the atom, or {G_TID_NONE} if unknown
  */
 typedef struct {
 	uint8_t* atom;
 	uint8_t set_on_finish;
+	g_tid owner;
 }__attribute__((packed)) g_syscall_atomic_wait;
 
+/**
+ * @field target
+ * 		id of the thread to yield to
+ */
+typedef struct {
+	g_tid target;
+}__attribute__((packed)) g_syscall_yield_to;
+
 /**
  * @field identifier
  * 		the identifier
@@ -197,4 +210,26 @@ typedef struct {
 	g_raise_signal_status status;
 }__attribute__((packed)) g_syscall_raise_signal;
 
+/**
+ * @field entries
+ * 		the wait set entries, revents are filled by the kernel
+ * @field count
+ * 		number of entries
+ * @field timeout
+ * 		maximum number of milliseconds to wait, zero to only check
+ * 		or {G_POLL_TIMEOUT_INFINITE}
+ * @field ready
+ * 		number of entries that have events to report
+ * @field status
+ * 		result of the command
+ */
+typedef struct {
+	g_poll_entry* entries;
+	uint32_t count;
+	uint64_t timeout;
+
+	int32_t ready;
+	g_poll_status status;
+}__attribute__((packed)) g_syscall_poll;
+
 #endif
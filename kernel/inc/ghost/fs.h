@@ -71,12 +71,16 @@ static const g_fs_node_type G_FS_NODE_TYPE_MOUNTPOINT = 2;
 static const g_fs_node_type G_FS_NODE_TYPE_FOLDER = 3;
 static const g_fs_node_type G_FS_NODE_TYPE_FILE = 4;
 static const g_fs_node_type G_FS_NODE_TYPE_PIPE = 5;
+static const g_fs_node_type G_FS_NODE_TYPE_EVENT = 6;
 
 /**
  * Stat attributes
  */
 typedef struct {
 	uint32_t mode;
+	g_fs_node_type type;
+	int64_t length; // length of files, 0 for other nodes
+	uint64_t modified; // milliseconds since boot of the last write through the kernel, 0 if not known
 }__attribute__((packed)) g_fs_stat_attributes;
 
 /**
@@ -155,6 +159,25 @@ static const g_fs_write_status G_FS_WRITE_NOT_SUPPORTED = 2;
 static const g_fs_write_status G_FS_WRITE_BUSY = 3;
 static const g_fs_write_status G_FS_WRITE_ERROR = 4;
 
+/**
+ * Segment of a vectored read or write, layout-compatible with the POSIX iovec
+ */
+typedef struct {
+	void* buffer;
+	uint32_t length;
+}__attribute__((packed)) g_fs_io_vector;
+
+/**
+ * Maximum number of segments in a vectored read or write
+ */
+#define G_FS_IO_VECTOR_MAXIMUM		1024
+
+/**
+ * Offset value for vectored reads and writes that use the current offset
+ * of the file descriptor and advance it
+ */
+#define G_FS_OFFSET_CURRENT			((int64_t) -1)
+
 /**
  * Status codes for the {g_fs_close} system call
  */
@@ -163,6 +186,15 @@ static const g_fs_close_status G_FS_CLOSE_SUCCESSFUL = 0;
 static const g_fs_close_status G_FS_CLOSE_INVALID_FD = 1;
 static const g_fs_close_status G_FS_CLOSE_ERROR = 2;
 
+/**
+ * Status codes for the {g_fs_flush} system call
+ */
+typedef int g_fs_flush_status;
+static const g_fs_flush_status G_FS_FLUSH_SUCCESSFUL = 0;
+static const g_fs_flush_status G_FS_FLUSH_INVALID_FD = 1;
+static const g_fs_flush_status G_FS_FLUSH_BUSY = 2;
+static const g_fs_flush_status G_FS_FLUSH_ERROR = 3;
+
 /**
  * Status codes for the {g_fs_seek} system call
  */
@@ -203,6 +235,112 @@ typedef int g_fs_pipe_status;
 static const g_fs_pipe_status G_FS_PIPE_SUCCESSFUL = 0;
 static const g_fs_pipe_status G_FS_PIPE_ERROR = 1;
 
+/**
+ * Status codes for the {g_event_create} system call
+ */
+typedef int g_event_create_status;
+static const g_event_create_status G_EVENT_CREATE_SUCCESSFUL = 0;
+static const g_event_create_status G_EVENT_CREATE_ERROR = 1;
+
+/**
+ * Status codes for the {g_event_signal} system call
+ */
+typedef int g_event_signal_status;
+static const g_event_signal_status G_EVENT_SIGNAL_SUCCESSFUL = 0;
+static const g_event_signal_status G_EVENT_SIGNAL_INVALID = 1;
+
+/**
+ * Status codes for the {g_event_wait} system call
+ */
+typedef int g_event_wait_status;
+static const g_event_wait_status G_EVENT_WAIT_SUCCESSFUL = 0;
+static const g_event_wait_status G_EVENT_WAIT_TIMEOUT = 1;
+static const g_event_wait_status G_EVENT_WAIT_INVALID = 2;
+
+/**
+ * Timeout value to wait for an event without time limit
+ */
+#define G_EVENT_TIMEOUT_INFINITE	((uint64_t) -1)
+
+/**
+ * Status codes for the {g_fs_cache_invalidate} system call
+ */
+typedef int g_fs_cache_invalidate_status;
+static const g_fs_cache_invalidate_status G_FS_CACHE_INVALIDATE_SUCCESSFUL = 0;
+static const g_fs_cache_invalidate_status G_FS_CACHE_INVALIDATE_NOT_FOUND = 1;
+static const g_fs_cache_invalidate_status G_FS_CACHE_INVALIDATE_NOT_PERMITTED = 2;
+
+/**
+ * Time-to-live values (in milliseconds) for attributes of a node that the kernel caches.
+ * Authoritative attributes stay valid until the delegate invalidates them.
+ */
+typedef uint32_t g_fs_attributes_ttl;
+#define G_FS_ATTRIBUTES_TTL_NONE			((g_fs_attributes_ttl) 0)
+#define G_FS_ATTRIBUTES_TTL_AUTHORITATIVE	((g_fs_attributes_ttl) -1)
+
+/**
+ * Status codes for the {g_fs_set_attributes} system call
+ */
+typedef int g_fs_set_attributes_status;
+static const g_fs_set_attributes_status G_FS_SET_ATTRIBUTES_SUCCESSFUL = 0;
+static const g_fs_set_attributes_status G_FS_SET_ATTRIBUTES_NOT_FOUND = 1;
+static const g_fs_set_attributes_status G_FS_SET_ATTRIBUTES_NOT_PERMITTED = 2;
+
+/**
+ * Write modes of a delegate. With write-back, the kernel buffers small writes and
+ * passes them to the delegate in larger batches; write-through passes each write
+ * on immediately, as required for devices.
+ */
+typedef int g_fs_write_mode;
+#define G_FS_WRITE_MODE_BACK		0
+#define G_FS_WRITE_MODE_THROUGH		1
+
+/**
+ * Status codes for the {g_fs_set_write_mode} system call
+ */
+typedef int g_fs_set_write_mode_status;
+static const g_fs_set_write_mode_status G_FS_SET_WRITE_MODE_SUCCESSFUL = 0;
+static const g_fs_set_write_mode_status G_FS_SET_WRITE_MODE_NOT_FOUND = 1;
+static const g_fs_set_write_mode_status G_FS_SET_WRITE_MODE_NOT_PERMITTED = 2;
+
+/**
+ * Flags for the {g_mmap} system call. Without {G_FS_MAP_PRIVATE}, the mapping
+ * is read-only and shares the pages that hold the file contents. A private
+ * mapping is writable; pages are copied on the first write to them.
+ */
+typedef uint32_t g_fs_map_flags;
+#define G_FS_MAP_SHARED		0
+#define G_FS_MAP_PRIVATE	1
+
+/**
+ * Status codes for the {g_mmap} system call. {G_FS_MAP_NOT_RESIDENT} is only
+ * used within the kernel, when the contents must be read before mapping.
+ */
+typedef int g_fs_map_status;
+static const g_fs_map_status G_FS_MAP_SUCCESSFUL = 0;
+static const g_fs_map_status G_FS_MAP_INVALID_FD = 1;
+static const g_fs_map_status G_FS_MAP_NOT_SUPPORTED = 2;
+static const g_fs_map_status G_FS_MAP_INVALID_RANGE = 3;
+static const g_fs_map_status G_FS_MAP_ERROR = 4;
+static const g_fs_map_status G_FS_MAP_NOT_RESIDENT = 5;
+
+/**
+ * Status codes for the {g_splice} system call
+ */
+typedef int g_fs_splice_status;
+static const g_fs_splice_status G_FS_SPLICE_SUCCESSFUL = 0;
+static const g_fs_splice_status G_FS_SPLICE_INVALID_FD = 1;
+static const g_fs_splice_status G_FS_SPLICE_NOT_SUPPORTED = 2;
+static const g_fs_splice_status G_FS_SPLICE_ERROR = 3;
+
+/**
+ * Status codes for the {g_create_directory} system call
+ */
+typedef int g_fs_create_directory_status;
+static const g_fs_create_directory_status G_FS_CREATE_DIRECTORY_SUCCESSFUL = 0;
+static const g_fs_create_directory_status G_FS_CREATE_DIRECTORY_EXISTS = 1;
+static const g_fs_create_directory_status G_FS_CREATE_DIRECTORY_ERROR = 2;
+
 /**
  * Status codes for the {g_set_working_directory} system call
  */
@@ -239,6 +377,28 @@ typedef struct {
 	g_fs_directory_entry entry_buffer;
 } g_fs_directory_iterator;
 
+/**
+ * Entry that a batched directory read writes to the callers buffer. Records
+ * are packed one after another, each starting at a four-byte boundary; the
+ * length is the distance to the next record and includes the terminated name.
+ */
+typedef struct {
+	g_fs_virt_id node_id;
+	g_fs_node_type type;
+	uint16_t length;
+	char name[];
+}__attribute__((packed)) g_fs_directory_record;
+
+/**
+ * Maximum number of entries that a batched directory read returns at once
+ */
+#define G_FS_READ_DIRECTORY_BATCH_MAXIMUM	256
+
+/**
+ * Maximum length of the remaining path that is passed to a delegate on discovery
+ */
+#define G_FS_DISCOVERY_REMAINING_MAX	3072
+
 /**
  * Transaction storage structures (may not be bigger than one page).
  */
@@ -247,6 +407,15 @@ typedef struct {
 	char name[G_FILENAME_MAX];
 
 	g_fs_discovery_status result_status;
+
+	/**
+	 * Path elements that follow the name, separated by slashes, or an empty string.
+	 * A delegate may discover all of them in the same transaction by creating a node
+	 * for each element; if any element does not exist, the result is
+	 * {G_FS_DISCOVERY_NOT_FOUND}. Delegates that ignore it only discover the name,
+	 * the kernel then asks for the next element.
+	 */
+	char remaining[G_FS_DISCOVERY_REMAINING_MAX];
 } g_fs_tasked_delegate_transaction_storage_discovery;
 
 typedef struct {
@@ -286,6 +455,15 @@ typedef struct {
 
 	g_fs_virt_id result_child;
 	g_fs_read_directory_status result_status;
+
+	/**
+	 * For batched reads, a delegate may return up to "maximum" children
+	 * starting at "position" instead of only "result_child". Delegates that
+	 * leave "result_count" at zero are treated as returning one child.
+	 */
+	int maximum;
+	int result_count;
+	g_fs_virt_id result_children[G_FS_READ_DIRECTORY_BATCH_MAXIMUM];
 } g_fs_tasked_delegate_transaction_storage_read_directory;
 
 __END_C
@@ -0,0 +1,111 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef __GHOST_SYS_IO__
+#define __GHOST_SYS_IO__
+
+#include "ghost/common.h"
+#include "ghost/stdint.h"
+
+__BEGIN_C
+
+// operations that can be submitted to an I/O ring
+typedef uint32_t g_io_operation;
+#define G_IO_OPERATION_READ					((g_io_operation) 0)
+#define G_IO_OPERATION_WRITE				((g_io_operation) 1)
+#define G_IO_OPERATION_OPEN					((g_io_operation) 2)
+#define G_IO_OPERATION_CLOSE				((g_io_operation) 3)
+#define G_IO_OPERATION_READ_DIRECTORY		((g_io_operation) 4)
+
+// completion status of an operation
+typedef uint32_t g_io_completion_status;
+#define G_IO_COMPLETION_SUCCESSFUL			((g_io_completion_status) 0)
+#define G_IO_COMPLETION_INVALID				((g_io_completion_status) 1)
+
+// number of entries in each of the rings
+#define G_IO_RING_ENTRIES					64
+
+/**
+ * Entry of the submission ring.
+ *
+ * @field operation
+ * 		one of the {g_io_operation} values
+ * @field data
+ * 		the call data of the operation, a {g_syscall_fs_read}, {g_syscall_fs_write},
+ * 		{g_syscall_fs_open}, {g_syscall_fs_close} or {g_syscall_fs_read_directory};
+ * 		must stay valid until the completion of the operation was taken
+ * @field user_data
+ * 		value that is passed through to the completion
+ */
+typedef struct {
+	g_io_operation operation;
+	void* data;
+	uint64_t user_data;
+}__attribute__((packed)) g_io_submission;
+
+/**
+ * Entry of the completion ring. The results of the operation are found
+ * in its call data.
+ *
+ * @field operation
+ * 		the operation that was completed
+ * @field data
+ * 		the call data of the operation
+ * @field user_data
+ * 		the value that was passed on submission
+ * @field status
+ * 		one of the {g_io_completion_status} values
+ */
+typedef struct {
+	g_io_operation operation;
+	void* data;
+	uint64_t user_data;
+	g_io_completion_status status;
+}__attribute__((packed)) g_io_completion;
+
+/**
+ * Submission and completion ring of a process, shared between the process and
+ * the kernel. The process adds submissions at the submission tail and takes
+ * completions at the completion head, the kernel does the opposite. Indices
+ * increase steadily and are taken modulo {G_IO_RING_ENTRIES}.
+ */
+typedef struct {
+	volatile uint32_t submission_head;
+	volatile uint32_t submission_tail;
+	volatile uint32_t completion_head;
+	volatile uint32_t completion_tail;
+
+	g_io_submission submissions[G_IO_RING_ENTRIES];
+	g_io_completion completions[G_IO_RING_ENTRIES];
+}__attribute__((packed)) g_io_ring;
+
+// status codes for setting up an I/O ring
+typedef int g_io_ring_setup_status;
+#define G_IO_RING_SETUP_SUCCESSFUL			((g_io_ring_setup_status) 0)
+#define G_IO_RING_SETUP_ERROR				((g_io_ring_setup_status) 1)
+
+// status codes for entering an I/O ring
+typedef int g_io_ring_enter_status;
+#define G_IO_RING_ENTER_SUCCESSFUL			((g_io_ring_enter_status) 0)
+#define G_IO_RING_ENTER_NO_RING				((g_io_ring_enter_status) 1)
+
+__END_C
+
+#endif
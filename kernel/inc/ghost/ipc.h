@@ -94,6 +94,46 @@ static const g_message_receive_status G_MESSAGE_RECEIVE_STATUS_FAILED = 3;
 static const g_message_receive_status G_MESSAGE_RECEIVE_STATUS_FAILED_NOT_PERMITTED = 4;
 static const g_message_receive_status G_MESSAGE_RECEIVE_STATUS_EXCEEDS_BUFFER_SIZE = 5;
 
+// publish/subscribe topics
+typedef int32_t g_topic_id;
+typedef int32_t g_topic_subscription;
+
+// topic bounds
+#define G_TOPIC_NAME_MAXIMUM_LENGTH			64
+#define G_TOPIC_MAXIMUM_PAYLOAD				G_MESSAGE_MAXIMUM_LENGTH
+#define G_TOPIC_DEFAULT_CAPACITY			32
+#define G_TOPIC_MAXIMUM_CAPACITY			256
+
+// what happens when a subscribers queue is full on publishing
+typedef int g_topic_backpressure;
+static const g_topic_backpressure G_TOPIC_BACKPRESSURE_DROP_OLDEST = 0;
+static const g_topic_backpressure G_TOPIC_BACKPRESSURE_BLOCK = 1;
+
+// modes for topic publishing
+typedef int g_topic_publish_mode;
+static const g_topic_publish_mode G_TOPIC_PUBLISH_MODE_BLOCKING = 0;
+static const g_topic_publish_mode G_TOPIC_PUBLISH_MODE_NON_BLOCKING = 1;
+
+// modes for topic receiving
+typedef int g_topic_receive_mode;
+static const g_topic_receive_mode G_TOPIC_RECEIVE_MODE_BLOCKING = 0;
+static const g_topic_receive_mode G_TOPIC_RECEIVE_MODE_NON_BLOCKING = 1;
+
+// status for topic publishing
+typedef int g_topic_publish_status;
+static const g_topic_publish_status G_TOPIC_PUBLISH_STATUS_SUCCESSFUL = 1;
+static const g_topic_publish_status G_TOPIC_PUBLISH_STATUS_QUEUE_FULL = 2;
+static const g_topic_publish_status G_TOPIC_PUBLISH_STATUS_FAILED = 3;
+static const g_topic_publish_status G_TOPIC_PUBLISH_STATUS_EXCEEDS_MAXIMUM = 4;
+
+// status for topic receiving
+typedef int g_topic_receive_status;
+static const g_topic_receive_status G_TOPIC_RECEIVE_STATUS_SUCCESSFUL = 1;
+static const g_topic_receive_status G_TOPIC_RECEIVE_STATUS_QUEUE_EMPTY = 2;
+static const g_topic_receive_status G_TOPIC_RECEIVE_STATUS_FAILED = 3;
+static const g_topic_receive_status G_TOPIC_RECEIVE_STATUS_FAILED_NOT_PERMITTED = 4;
+static const g_topic_receive_status G_TOPIC_RECEIVE_STATUS_EXCEEDS_BUFFER_SIZE = 5;
+
 __END_C
 
 #endif
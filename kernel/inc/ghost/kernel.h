@@ -38,6 +38,16 @@ typedef void* g_process_creation_identifier;
  */
 typedef uint32_t g_tid;
 typedef g_tid g_pid;
+#define G_TID_NONE		((g_tid) -1)
+
+/**
+ * Core placement of created threads
+ */
+typedef uint8_t g_thread_placement;
+
+#define G_THREAD_PLACEMENT_ANY			0
+#define G_THREAD_PLACEMENT_SAME_CORE	1
+#define G_THREAD_PLACEMENT_OTHER_CORE	2
 
 /**
  * Task execution security levels
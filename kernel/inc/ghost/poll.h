@@ -0,0 +1,80 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef __GHOST_SYS_POLL__
+#define __GHOST_SYS_POLL__
+
+#include "ghost/common.h"
+#include "ghost/stdint.h"
+
+__BEGIN_C
+
+// kinds of sources that can be part of a wait set
+typedef uint8_t g_poll_type;
+#define G_POLL_TYPE_FD						((g_poll_type) 0)
+#define G_POLL_TYPE_MESSAGE					((g_poll_type) 1)
+#define G_POLL_TYPE_TOPIC_MESSAGE			((g_poll_type) 2)
+#define G_POLL_TYPE_IRQ						((g_poll_type) 3)
+#define G_POLL_TYPE_SUBSCRIPTION			((g_poll_type) 4)
+
+// events that can be requested and reported
+typedef uint8_t g_poll_events;
+#define G_POLL_EVENT_NONE					((g_poll_events) 0)
+#define G_POLL_EVENT_READABLE				((g_poll_events) 1)
+#define G_POLL_EVENT_WRITABLE				((g_poll_events) 2)
+#define G_POLL_EVENT_ERROR					((g_poll_events) 4)
+
+/**
+ * Entry of a wait set.
+ *
+ * @field type
+ * 		kind of the source, one of the {g_poll_type} values
+ * @field value
+ * 		depending on the type: the file descriptor, the message transaction (or
+ * 		{G_MESSAGE_TRANSACTION_NONE} for any message), the message topic or
+ * 		the IRQ number
+ * @field events
+ * 		the requested {g_poll_events}; only relevant for file descriptors, all
+ * 		other sources are reported as readable
+ * @field revents
+ * 		filled by the kernel with the events that occurred
+ */
+typedef struct {
+	g_poll_type type;
+	uint32_t value;
+	g_poll_events events;
+	g_poll_events revents;
+}__attribute__((packed)) g_poll_entry;
+
+// maximum number of entries in one wait set
+#define G_POLL_MAXIMUM_ENTRIES				64
+
+// timeout value to wait without limit
+#define G_POLL_TIMEOUT_INFINITE				((uint64_t) -1)
+
+// status codes for polling
+typedef int g_poll_status;
+#define G_POLL_STATUS_SUCCESSFUL			((g_poll_status) 0)
+#define G_POLL_STATUS_TIMEOUT				((g_poll_status) 1)
+#define G_POLL_STATUS_INVALID				((g_poll_status) 2)
+
+__END_C
+
+#endif
@@ -22,6 +22,7 @@
 #define __GHOST_SYS_RAMDISK__
 
 #include "ghost/common.h"
+#include "ghost/stdint.h"
 
 __BEGIN_C
 
@@ -43,6 +44,44 @@ typedef int g_ramdisk_entry_type;
 #define G_RAMDISK_ENTRY_TYPE_FOLDER		0
 #define G_RAMDISK_ENTRY_TYPE_FILE		1
 
+/**
+ * Layout of a version 2 ramdisk image. The image starts with the header, which
+ * points to a table of entries and a table of null-terminated names. File data
+ * is stored page-aligned, so it can be mapped directly; compressed data is only
+ * aligned to four bytes.
+ *
+ * Images without the magic at the start are read as version 1 images, which are
+ * a flat sequence of variable-length records.
+ */
+#define G_RAMDISK_MAGIC					"GHOSTRD2"
+#define G_RAMDISK_MAGIC_LENGTH			8
+#define G_RAMDISK_VERSION				2
+
+#define G_RAMDISK_COMPRESSION_NONE		0
+#define G_RAMDISK_COMPRESSION_LZ4		1
+
+typedef struct {
+	uint8_t magic[G_RAMDISK_MAGIC_LENGTH];
+	uint32_t version;
+	uint32_t entryCount;
+	uint32_t entryTableOffset;
+	uint32_t stringTableOffset;
+	uint32_t stringTableLength;
+}__attribute__((packed)) g_ramdisk_image_header;
+
+typedef struct {
+	uint8_t type;
+	uint8_t compression;
+	uint16_t reserved;
+	uint32_t id;
+	uint32_t parentId;
+	uint32_t nameOffset;
+	uint32_t nameLength;
+	uint32_t dataOffset;
+	uint32_t storedLength;
+	uint32_t length;
+}__attribute__((packed)) g_ramdisk_image_entry;
+
 /**
  * Ramdisk entry information struct used within system calls
  */
@@ -65,6 +65,7 @@ G_SYSCALL_HANDLER(handle) {
 
 	switch (call) {
 		link(G_SYSCALL_YIELD, yield);
+		link(G_SYSCALL_YIELD_TO, yield_to);
 		link(G_SYSCALL_EXIT, exit);
 		link(G_SYSCALL_GET_PROCESS_ID, get_pid);
 		link(G_SYSCALL_GET_TASK_ID, get_tid);
@@ -83,6 +84,12 @@ G_SYSCALL_HANDLER(handle) {
 		link(G_SYSCALL_MESSAGE_SEND, send_message);
 		link(G_SYSCALL_MESSAGE_RECEIVE, receive_message);
 
+		link(G_SYSCALL_TOPIC_OPEN, topic_open);
+		link(G_SYSCALL_TOPIC_SUBSCRIBE, topic_subscribe);
+		link(G_SYSCALL_TOPIC_UNSUBSCRIBE, topic_unsubscribe);
+		link(G_SYSCALL_TOPIC_PUBLISH, topic_publish);
+		link(G_SYSCALL_TOPIC_RECEIVE, topic_receive);
+
 		link(G_SYSCALL_WAIT_FOR_IRQ, wait_for_irq);
 		link(G_SYSCALL_ALLOCATE_MEMORY, alloc_mem);
 		link(G_SYSCALL_SHARE_MEMORY, share_mem);
@@ -105,6 +112,7 @@ G_SYSCALL_HANDLER(handle) {
 		link(G_SYSCALL_RESTORE_INTERRUPTED_STATE, restore_interrupted_state);
 		link(G_SYSCALL_REGISTER_SIGNAL_HANDLER, register_signal_handler);
 		link(G_SYSCALL_RAISE_SIGNAL, raise_signal);
+		link(G_SYSCALL_POLL, poll);
 
 		link(G_SYSCALL_CREATE_EMPTY_PROCESS, create_empty_process);
 		link(G_SYSCALL_CREATE_PAGES_IN_SPACE, create_pages_in_space);
@@ -125,6 +133,8 @@ G_SYSCALL_HANDLER(handle) {
 		link(G_SYSCALL_FS_OPEN, fs_open);
 		link(G_SYSCALL_FS_READ, fs_read);
 		link(G_SYSCALL_FS_WRITE, fs_write);
+		link(G_SYSCALL_FS_READ_VECTOR, fs_read_vector);
+		link(G_SYSCALL_FS_WRITE_VECTOR, fs_write_vector);
 		link(G_SYSCALL_FS_CLOSE, fs_close);
 		link(G_SYSCALL_FS_STAT, fs_stat);
 		link(G_SYSCALL_FS_FSTAT, fs_fstat);
@@ -135,10 +145,24 @@ G_SYSCALL_HANDLER(handle) {
 		link(G_SYSCALL_FS_TELL, fs_tell);
 		link(G_SYSCALL_FS_OPEN_DIRECTORY, fs_open_directory);
 		link(G_SYSCALL_FS_READ_DIRECTORY, fs_read_directory);
+		link(G_SYSCALL_FS_CLOSE_DIRECTORY, fs_close_directory);
+		link(G_SYSCALL_FS_EVENT_CREATE, fs_event_create);
+		link(G_SYSCALL_FS_EVENT_SIGNAL, fs_event_signal);
+		link(G_SYSCALL_FS_EVENT_WAIT, fs_event_wait);
 
 		link(G_SYSCALL_FS_REGISTER_AS_DELEGATE, fs_register_as_delegate);
 		link(G_SYSCALL_FS_SET_TRANSACTION_STATUS, fs_set_transaction_status);
 		link(G_SYSCALL_FS_CREATE_NODE, fs_create_node);
+		link(G_SYSCALL_FS_CACHE_INVALIDATE, fs_cache_invalidate);
+		link(G_SYSCALL_FS_IO_RING_SETUP, fs_io_ring_setup);
+		link(G_SYSCALL_FS_IO_RING_ENTER, fs_io_ring_enter);
+		link(G_SYSCALL_FS_MAP, fs_map);
+		link(G_SYSCALL_FS_SPLICE, fs_splice);
+		link(G_SYSCALL_FS_READ_DIRECTORY_BATCH, fs_read_directory_batch);
+		link(G_SYSCALL_FS_CREATE_DIRECTORY, fs_create_directory);
+		link(G_SYSCALL_FS_SET_ATTRIBUTES, fs_set_attributes);
+		link(G_SYSCALL_FS_FLUSH, fs_flush);
+		link(G_SYSCALL_FS_SET_WRITE_MODE, fs_set_write_mode);
 	}
 
 	// The system call could not be handled, this might mean that the
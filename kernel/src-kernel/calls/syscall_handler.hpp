@@ -42,6 +42,7 @@ public:
 
 private:
 	static g_cpu_state* yield(g_cpu_state* state);
+	static g_cpu_state* yield_to(g_cpu_state* state);
 	static g_cpu_state* exit(g_cpu_state* state);
 	static g_cpu_state* sleep(g_cpu_state* state);
 	static g_cpu_state* get_pid(g_cpu_state* state);
@@ -60,6 +61,7 @@ private:
 	static g_cpu_state* restore_interrupted_state(g_cpu_state* state);
 	static g_cpu_state* register_signal_handler(g_cpu_state* state);
 	static g_cpu_state* raise_signal(g_cpu_state* state);
+	static g_cpu_state* poll(g_cpu_state* state);
 
 	static g_cpu_state* task_id_register(g_cpu_state* state);
 	static g_cpu_state* task_id_get(g_cpu_state* state);
@@ -79,6 +81,11 @@ private:
 	static g_cpu_state* recv_topic_msg(g_cpu_state* state);
 	static g_cpu_state* send_message(g_cpu_state* state);
 	static g_cpu_state* receive_message(g_cpu_state* state);
+	static g_cpu_state* topic_open(g_cpu_state* state);
+	static g_cpu_state* topic_subscribe(g_cpu_state* state);
+	static g_cpu_state* topic_unsubscribe(g_cpu_state* state);
+	static g_cpu_state* topic_publish(g_cpu_state* state);
+	static g_cpu_state* topic_receive(g_cpu_state* state);
 
 	static g_cpu_state* alloc_mem(g_cpu_state* state);
 	static g_cpu_state* share_mem(g_cpu_state* state);
@@ -102,6 +109,8 @@ private:
 	static g_cpu_state* fs_open(g_cpu_state* state);
 	static g_cpu_state* fs_read(g_cpu_state* state);
 	static g_cpu_state* fs_write(g_cpu_state* state);
+	static g_cpu_state* fs_read_vector(g_cpu_state* state);
+	static g_cpu_state* fs_write_vector(g_cpu_state* state);
 	static g_cpu_state* fs_close(g_cpu_state* state);
 	static g_cpu_state* fs_seek(g_cpu_state* state);
 	static g_cpu_state* fs_length(g_cpu_state* state);
@@ -113,6 +122,10 @@ private:
 	static g_cpu_state* fs_tell(g_cpu_state* state);
 	static g_cpu_state* fs_open_directory(g_cpu_state* state);
 	static g_cpu_state* fs_read_directory(g_cpu_state* state);
+	static g_cpu_state* fs_close_directory(g_cpu_state* state);
+	static g_cpu_state* fs_event_create(g_cpu_state* state);
+	static g_cpu_state* fs_event_signal(g_cpu_state* state);
+	static g_cpu_state* fs_event_wait(g_cpu_state* state);
 
 	static g_cpu_state* get_working_directory(g_cpu_state* state);
 	static g_cpu_state* set_working_directory(g_cpu_state* state);
@@ -120,6 +133,16 @@ private:
 	static g_cpu_state* fs_register_as_delegate(g_cpu_state* state);
 	static g_cpu_state* fs_set_transaction_status(g_cpu_state* state);
 	static g_cpu_state* fs_create_node(g_cpu_state* state);
+	static g_cpu_state* fs_cache_invalidate(g_cpu_state* state);
+	static g_cpu_state* fs_io_ring_setup(g_cpu_state* state);
+	static g_cpu_state* fs_io_ring_enter(g_cpu_state* state);
+	static g_cpu_state* fs_map(g_cpu_state* state);
+	static g_cpu_state* fs_splice(g_cpu_state* state);
+	static g_cpu_state* fs_read_directory_batch(g_cpu_state* state);
+	static g_cpu_state* fs_create_directory(g_cpu_state* state);
+	static g_cpu_state* fs_set_attributes(g_cpu_state* state);
+	static g_cpu_state* fs_flush(g_cpu_state* state);
+	static g_cpu_state* fs_set_write_mode(g_cpu_state* state);
 
 };
 
@@ -24,9 +24,27 @@
 #include "filesystem/fs_transaction_handler_discovery_set_cwd.hpp"
 #include "filesystem/fs_transaction_handler_discovery_open.hpp"
 #include "filesystem/fs_transaction_handler_discovery_open_directory.hpp"
+#include "filesystem/fs_transaction_handler_discovery_create_directory.hpp"
 #include "filesystem/fs_transaction_handler_get_length_seek.hpp"
 #include "filesystem/fs_transaction_handler_get_length_default.hpp"
 #include "filesystem/fs_transaction_handler_discovery_get_length.hpp"
+#include "filesystem/fs_transaction_handler_discovery_stat.hpp"
+#include "filesystem/fs_transaction_handler_get_length_stat.hpp"
+#include "filesystem/fs_transaction_handler_read_vector.hpp"
+#include "filesystem/fs_transaction_handler_write_vector.hpp"
+#include "filesystem/fs_transaction_handler_map.hpp"
+#include "filesystem/fs_transaction_handler_read_directory_batch.hpp"
+#include "filesystem/fs_transaction_handler_flush_default.hpp"
+#include "filesystem/fs_transaction_handler_flush_close.hpp"
+#include "filesystem/fs_mappings.hpp"
+#include "memory/physical/pp_allocator.hpp"
+#include "memory/physical/pp_reference_tracker.hpp"
+#include "filesystem/events.hpp"
+#include "filesystem/fs_page_cache.hpp"
+#include "filesystem/pipes.hpp"
+#include "filesystem/io_rings.hpp"
+#include "tasking/wait/waiter_io_ring.hpp"
+#include "tasking/wait/waiter_event_wait.hpp"
 
 #include "ghost/utils/local.hpp"
 #include "tasking/tasking.hpp"
@@ -42,15 +60,13 @@ G_SYSCALL_HANDLER(set_working_directory) {
 	g_thread* task = g_tasking::getCurrentThread();
 	g_syscall_fs_set_working_directory* data = (g_syscall_fs_set_working_directory*) G_SYSCALL_DATA(state);
 
-	// get absolute path for the requested path, relative to process working directory
-	g_local<char> absolute_path(new char[G_PATH_MAX]);
-	g_filesystem::concat_as_absolute_path(task->process->workingDirectory, data->path, absolute_path());
+	g_fs_node* base = g_filesystem::get_path_base(task->process, data->path);
 
 	// perform discovery, perform setting of working directory once finished
 	g_contextual<g_syscall_fs_set_working_directory*> bound_data(data, task->process->pageDirectory);
-	g_fs_transaction_handler_discovery_set_cwd* handler = new g_fs_transaction_handler_discovery_set_cwd(absolute_path(), bound_data);
+	g_fs_transaction_handler_discovery_set_cwd* handler = new g_fs_transaction_handler_discovery_set_cwd(base, data->path, bound_data);
 
-	g_filesystem::discover_absolute_path(task, absolute_path(), handler);
+	g_filesystem::discover_path(task, handler->base, handler->path, handler);
 	return g_tasking::switchTask(state);
 }
 
@@ -83,8 +99,15 @@ G_SYSCALL_HANDLER(fs_register_as_delegate) {
  */
 G_SYSCALL_HANDLER(fs_set_transaction_status) {
 
+	g_thread* task = g_tasking::getCurrentThread();
 	g_syscall_fs_set_transaction_status* data = (g_syscall_fs_set_transaction_status*) G_SYSCALL_DATA(state);
 	g_fs_transaction_store::set_status(data->transaction, data->status);
+
+	// flushes that nobody waits for are completed by the delegate itself
+	g_filesystem::transaction_status_changed(task);
+
+	// operations of I/O rings complete without a waiting thread
+	g_io_rings::progress_all();
 	return state;
 }
 
@@ -126,6 +149,88 @@ G_SYSCALL_HANDLER(fs_create_node) {
 	return state;
 }
 
+/**
+ * Drops cached contents of a node. Only the process that serves the node
+ * as a delegate may do this.
+ */
+G_SYSCALL_HANDLER(fs_cache_invalidate) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_cache_invalidate* data = (g_syscall_fs_cache_invalidate*) G_SYSCALL_DATA(state);
+
+	g_fs_node* node = g_filesystem::get_node_by_id(data->node_id);
+	if (node == 0 || node->get_delegate() == 0) {
+		data->status = G_FS_CACHE_INVALIDATE_NOT_FOUND;
+		return state;
+	}
+
+	g_thread* serving = g_tasking::getTaskById(node->get_delegate()->get_serving_thread());
+	if (serving == 0 || serving->process != task->process) {
+		data->status = G_FS_CACHE_INVALIDATE_NOT_PERMITTED;
+		return state;
+	}
+
+	g_fs_page_cache::invalidate(node->id, data->offset, data->length);
+	node->invalidate_attributes();
+	data->status = G_FS_CACHE_INVALIDATE_SUCCESSFUL;
+	return state;
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(fs_set_attributes) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_set_attributes* data = (g_syscall_fs_set_attributes*) G_SYSCALL_DATA(state);
+
+	g_fs_node* node = g_filesystem::get_node_by_id(data->node_id);
+	if (node == 0 || node->get_delegate() == 0) {
+		data->status = G_FS_SET_ATTRIBUTES_NOT_FOUND;
+		return state;
+	}
+
+	g_thread* serving = g_tasking::getTaskById(node->get_delegate()->get_serving_thread());
+	if (serving == 0 || serving->process != task->process) {
+		data->status = G_FS_SET_ATTRIBUTES_NOT_PERMITTED;
+		return state;
+	}
+
+	node->attributes_ttl = data->ttl;
+	if (data->length >= 0) {
+		node->cache_length(data->length);
+	} else {
+		node->invalidate_attributes();
+	}
+	data->status = G_FS_SET_ATTRIBUTES_SUCCESSFUL;
+	return state;
+}
+
+/**
+ * Only the process that serves the delegate may change its write mode.
+ */
+G_SYSCALL_HANDLER(fs_set_write_mode) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_set_write_mode* data = (g_syscall_fs_set_write_mode*) G_SYSCALL_DATA(state);
+
+	g_fs_node* node = g_filesystem::get_node_by_id(data->node_id);
+	if (node == 0 || node->get_delegate() == 0) {
+		data->status = G_FS_SET_WRITE_MODE_NOT_FOUND;
+		return state;
+	}
+
+	g_thread* serving = g_tasking::getTaskById(node->get_delegate()->get_serving_thread());
+	if (serving == 0 || serving->process != task->process) {
+		data->status = G_FS_SET_WRITE_MODE_NOT_PERMITTED;
+		return state;
+	}
+
+	node->get_delegate()->set_write_mode(data->mode);
+	data->status = G_FS_SET_WRITE_MODE_SUCCESSFUL;
+	return state;
+}
+
 /**
  *
  */
@@ -134,16 +239,33 @@ G_SYSCALL_HANDLER(fs_open) {
 	g_thread* task = g_tasking::getCurrentThread();
 	g_syscall_fs_open* data = (g_syscall_fs_open*) G_SYSCALL_DATA(state);
 
-	// get absolute path for the requested path, relative to process working directory
-	g_local<char> absolute_path(new char[G_PATH_MAX]);
-	g_filesystem::concat_as_absolute_path(task->process->workingDirectory, data->path, absolute_path());
+	g_fs_node* base = g_filesystem::get_path_base(task->process, data->path);
 
 	// create handler
 	g_contextual<g_syscall_fs_open*> bound_data(data, task->process->pageDirectory);
-	g_fs_transaction_handler_discovery_open* handler = new g_fs_transaction_handler_discovery_open(absolute_path(), bound_data);
+	g_fs_transaction_handler_discovery_open* handler = new g_fs_transaction_handler_discovery_open(base, data->path, bound_data);
 
 	// discover path and let go
-	g_filesystem::discover_absolute_path(task, absolute_path(), handler);
+	g_filesystem::discover_path(task, handler->base, handler->path, handler);
+	return g_tasking::switchTask(state);
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(fs_create_directory) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_create_directory* data = (g_syscall_fs_create_directory*) G_SYSCALL_DATA(state);
+
+	g_fs_node* base = g_filesystem::get_path_base(task->process, data->path);
+
+	// create handler
+	g_contextual<g_syscall_fs_create_directory*> bound_data(data, task->process->pageDirectory);
+	g_fs_transaction_handler_discovery_create_directory* handler = new g_fs_transaction_handler_discovery_create_directory(base, data->path, bound_data);
+
+	// discover path and let go
+	g_filesystem::discover_path(task, handler->base, handler->path, handler);
 	return g_tasking::switchTask(state);
 }
 
@@ -158,7 +280,7 @@ G_SYSCALL_HANDLER(fs_read) {
 	// Find the file descriptor and the matching virtual file system node first:
 	g_fs_node* node;
 	g_file_descriptor_content* fd;
-	if (g_filesystem::node_for_descriptor(task->process->main->id, data->fd, &node, &fd)) {
+	if (g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
 
 		/**
 		 * Create handler for the transaction. The transaction handler is then asked to
@@ -199,7 +321,7 @@ G_SYSCALL_HANDLER(fs_write) {
 	// See {fs_read} for an explanation
 	g_fs_node* node;
 	g_file_descriptor_content* fd;
-	if (g_filesystem::node_for_descriptor(task->process->main->id, data->fd, &node, &fd)) {
+	if (g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
 
 		g_contextual<g_syscall_fs_write*> bound_data(data, task->process->pageDirectory);
 		g_fs_transaction_handler_write* handler = new g_fs_transaction_handler_write(node, fd, bound_data);
@@ -220,6 +342,93 @@ G_SYSCALL_HANDLER(fs_write) {
 	return state;
 }
 
+/**
+ * Copies the segment list of a vectored operation to the kernel heap, so that
+ * the handler can still access it when continuing from a waiter.
+ */
+static g_fs_io_vector* copy_io_vector(g_fs_io_vector* vector, uint32_t count, int64_t offset) {
+
+	if (count == 0 || count > G_FS_IO_VECTOR_MAXIMUM || vector == 0) {
+		return 0;
+	}
+	if (offset < 0 && offset != G_FS_OFFSET_CURRENT) {
+		return 0;
+	}
+
+	g_fs_io_vector* segments = new g_fs_io_vector[count];
+	g_memory::copy(segments, vector, sizeof(g_fs_io_vector) * count);
+	return segments;
+}
+
+/**
+ * Reads into multiple buffers at once, optionally at a given offset. See {fs_read}
+ * for the general procedure; a handler that finishes immediately is deleted here.
+ */
+G_SYSCALL_HANDLER(fs_read_vector) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_read_vector* data = (g_syscall_fs_read_vector*) G_SYSCALL_DATA(state);
+	data->result = -1;
+
+	g_fs_node* node;
+	g_file_descriptor_content* fd;
+	if (!g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
+		data->status = G_FS_READ_INVALID_FD;
+		return state;
+	}
+
+	g_fs_io_vector* segments = copy_io_vector(data->vector, data->count, data->offset);
+	if (segments == 0) {
+		data->status = G_FS_READ_ERROR;
+		return state;
+	}
+
+	g_contextual<g_syscall_fs_read_vector*> bound_data(data, task->process->pageDirectory);
+	g_fs_transaction_handler_read_vector* handler = new g_fs_transaction_handler_read_vector(node, fd, segments, data->count, data->offset, bound_data);
+	g_fs_transaction_handler_start_status start_status = handler->start_transaction(task);
+
+	if (start_status == G_FS_TRANSACTION_STARTED_WITH_WAITER) {
+		return g_tasking::switchTask(state);
+	}
+
+	delete handler;
+	return state;
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(fs_write_vector) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_write_vector* data = (g_syscall_fs_write_vector*) G_SYSCALL_DATA(state);
+	data->result = -1;
+
+	g_fs_node* node;
+	g_file_descriptor_content* fd;
+	if (!g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
+		data->status = G_FS_WRITE_INVALID_FD;
+		return state;
+	}
+
+	g_fs_io_vector* segments = copy_io_vector(data->vector, data->count, data->offset);
+	if (segments == 0) {
+		data->status = G_FS_WRITE_ERROR;
+		return state;
+	}
+
+	g_contextual<g_syscall_fs_write_vector*> bound_data(data, task->process->pageDirectory);
+	g_fs_transaction_handler_write_vector* handler = new g_fs_transaction_handler_write_vector(node, fd, segments, data->count, data->offset, bound_data);
+	g_fs_transaction_handler_start_status start_status = handler->start_transaction(task);
+
+	if (start_status == G_FS_TRANSACTION_STARTED_WITH_WAITER) {
+		return g_tasking::switchTask(state);
+	}
+
+	delete handler;
+	return state;
+}
+
 /**
  *
  */
@@ -228,15 +437,61 @@ G_SYSCALL_HANDLER(fs_close) {
 	g_thread* task = g_tasking::getCurrentThread();
 	g_syscall_fs_close* data = (g_syscall_fs_close*) G_SYSCALL_DATA(state);
 
+	// buffered writes are flushed before the descriptor is closed
 	g_fs_node* node;
 	g_file_descriptor_content* fd;
-	if (g_filesystem::node_for_descriptor(task->process->main->id, data->fd, &node, &fd)) {
-		data->result = g_filesystem::close(task->process->main->id, node, fd, &data->status);
+	if (g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
+
+		g_contextual<g_syscall_fs_close*> bound_data(data, task->process->pageDirectory);
+		g_fs_transaction_handler_flush_close* handler = new g_fs_transaction_handler_flush_close(node, data->fd, bound_data);
+		g_fs_transaction_handler_start_status start_status = handler->start_transaction(task);
+
+		if (start_status == G_FS_TRANSACTION_STARTED_WITH_WAITER) {
+			return g_tasking::switchTask(state);
+
+		} else if (start_status == G_FS_TRANSACTION_STARTED_AND_FINISHED) {
+			return state;
+		}
+
+		delete handler;
+		data->result = g_filesystem::close(task->process, node, fd, &data->status);
 	}
 
 	return state;
 }
 
+/**
+ *
+ */
+G_SYSCALL_HANDLER(fs_flush) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_flush* data = (g_syscall_fs_flush*) G_SYSCALL_DATA(state);
+
+	g_fs_node* node;
+	g_file_descriptor_content* fd;
+	if (g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
+
+		g_contextual<g_syscall_fs_flush*> bound_data(data, task->process->pageDirectory);
+		g_fs_transaction_handler_flush_default* handler = new g_fs_transaction_handler_flush_default(node, bound_data);
+		g_fs_transaction_handler_start_status start_status = handler->start_transaction(task);
+
+		if (start_status == G_FS_TRANSACTION_STARTED_WITH_WAITER) {
+			return g_tasking::switchTask(state);
+
+		} else if (start_status == G_FS_TRANSACTION_STARTED_AND_FINISHED) {
+			return state;
+		}
+
+		delete handler;
+		data->status = G_FS_FLUSH_ERROR;
+		return state;
+	}
+
+	data->status = G_FS_FLUSH_INVALID_FD;
+	return state;
+}
+
 /**
  *
  */
@@ -247,7 +502,7 @@ G_SYSCALL_HANDLER(fs_seek) {
 
 	g_fs_node* node;
 	g_file_descriptor_content* fd;
-	if (g_filesystem::node_for_descriptor(task->process->main->id, data->fd, &node, &fd)) {
+	if (g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
 		g_contextual<g_syscall_fs_seek*> bound_data(data, task->process->pageDirectory);
 		g_fs_transaction_handler_get_length_seek* handler = new g_fs_transaction_handler_get_length_seek(fd, bound_data);
 
@@ -277,7 +532,7 @@ G_SYSCALL_HANDLER(fs_length) {
 		g_fs_node* node;
 		g_file_descriptor_content* fd;
 
-		if (g_filesystem::node_for_descriptor(task->process->main->id, data->fd, &node, &fd)) {
+		if (g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
 			g_fs_transaction_handler_get_length_default* handler = new g_fs_transaction_handler_get_length_default(bound_data);
 			g_filesystem::get_length(task, node, handler);
 			return g_tasking::switchTask(state);
@@ -286,12 +541,10 @@ G_SYSCALL_HANDLER(fs_length) {
 			return state;
 		}
 	} else {
-		// get absolute path for the requested path, relative to process working directory
-		g_local<char> absolute_path(new char[G_PATH_MAX]);
-		g_filesystem::concat_as_absolute_path(task->process->workingDirectory, data->path, absolute_path());
+		g_fs_node* base = g_filesystem::get_path_base(task->process, data->path);
 
-		g_fs_transaction_handler_discovery_get_length* handler = new g_fs_transaction_handler_discovery_get_length(absolute_path(), bound_data);
-		g_filesystem::discover_absolute_path(task, absolute_path(), handler, follow_symlinks);
+		g_fs_transaction_handler_discovery_get_length* handler = new g_fs_transaction_handler_discovery_get_length(base, data->path, bound_data);
+		g_filesystem::discover_path(task, handler->base, handler->path, handler, follow_symlinks);
 		return g_tasking::switchTask(state);
 	}
 
@@ -309,7 +562,7 @@ G_SYSCALL_HANDLER(fs_tell) {
 	g_fs_node* node;
 	g_file_descriptor_content* fd;
 
-	if (g_filesystem::node_for_descriptor(task->process->main->id, data->fd, &node, &fd)) {
+	if (g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
 		data->status = G_FS_TELL_SUCCESSFUL;
 		data->result = fd->offset;
 	} else {
@@ -339,10 +592,88 @@ G_SYSCALL_HANDLER(fs_pipe) {
 
 	g_thread* task = g_tasking::getCurrentThread();
 	g_syscall_fs_pipe* data = (g_syscall_fs_pipe*) G_SYSCALL_DATA(state);
-	data->status = g_filesystem::pipe(task, &data->write_fd, &data->read_fd);
+	data->status = g_filesystem::pipe(task, data->capacity, &data->write_fd, &data->read_fd);
 	return state;
 }
 
+/**
+ *
+ */
+G_SYSCALL_HANDLER(fs_event_create) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_event_create* data = (g_syscall_fs_event_create*) G_SYSCALL_DATA(state);
+	data->status = g_filesystem::create_event(task, &data->fd);
+	return state;
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(fs_event_signal) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_event_signal* data = (g_syscall_fs_event_signal*) G_SYSCALL_DATA(state);
+
+	g_fs_node* node;
+	g_file_descriptor_content* fd;
+	if (!g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd) || node->type != G_FS_NODE_TYPE_EVENT) {
+		data->status = G_EVENT_SIGNAL_INVALID;
+		return state;
+	}
+
+	g_event* event = g_events::get(node->phys_fs_id);
+	if (event == 0) {
+		data->status = G_EVENT_SIGNAL_INVALID;
+		return state;
+	}
+
+	g_events::signal(event, data->value);
+	data->status = G_EVENT_SIGNAL_SUCCESSFUL;
+	return state;
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(fs_event_wait) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_event_wait* data = (g_syscall_fs_event_wait*) G_SYSCALL_DATA(state);
+	data->count = 0;
+
+	g_fs_node* node;
+	g_file_descriptor_content* fd;
+	if (!g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd) || node->type != G_FS_NODE_TYPE_EVENT) {
+		data->status = G_EVENT_WAIT_INVALID;
+		return state;
+	}
+
+	g_event* event = g_events::get(node->phys_fs_id);
+	if (event == 0) {
+		data->status = G_EVENT_WAIT_INVALID;
+		return state;
+	}
+
+	// take the counter immediately if signaled
+	data->count = g_events::take(event);
+	if (data->count > 0) {
+		data->status = G_EVENT_WAIT_SUCCESSFUL;
+		return state;
+	}
+
+	if (data->timeout == 0) {
+		data->status = G_EVENT_WAIT_TIMEOUT;
+		return state;
+	}
+
+	// block on the events wait queue
+	g_waiter_event_wait* waiter = new g_waiter_event_wait(data, node->phys_fs_id, g_tasking::getCurrentScheduler());
+	waiter->enqueue(&event->waiters);
+	task->wait(waiter);
+	return g_tasking::switchTask(state);
+}
+
 /**
  *
  */
@@ -351,16 +682,14 @@ G_SYSCALL_HANDLER(fs_open_directory) {
 	g_thread* task = g_tasking::getCurrentThread();
 	g_syscall_fs_open_directory* data = (g_syscall_fs_open_directory*) G_SYSCALL_DATA(state);
 
-	// get absolute path for the requested path, relative to process working directory
-	g_local<char> absolute_path(new char[G_PATH_MAX]);
-	g_filesystem::concat_as_absolute_path(task->process->workingDirectory, data->path, absolute_path());
+	g_fs_node* base = g_filesystem::get_path_base(task->process, data->path);
 
 	// create handler
 	g_contextual<g_syscall_fs_open_directory*> bound_data(data, task->process->pageDirectory);
-	g_fs_transaction_handler_discovery_open_directory* handler = new g_fs_transaction_handler_discovery_open_directory(absolute_path(), bound_data);
+	g_fs_transaction_handler_discovery_open_directory* handler = new g_fs_transaction_handler_discovery_open_directory(base, data->path, bound_data);
 
 	// discover path and let go
-	g_filesystem::discover_absolute_path(task, absolute_path(), handler);
+	g_filesystem::discover_path(task, handler->base, handler->path, handler);
 	return g_tasking::switchTask(state);
 }
 
@@ -380,6 +709,43 @@ G_SYSCALL_HANDLER(fs_read_directory) {
 	return g_tasking::switchTask(state);
 }
 
+/**
+ *
+ */
+G_SYSCALL_HANDLER(fs_close_directory) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_close_directory* data = (g_syscall_fs_close_directory*) G_SYSCALL_DATA(state);
+
+	g_filesystem::close_directory(task->process, data->iterator->node_id);
+	return state;
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(fs_read_directory_batch) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_read_directory_batch* data = (g_syscall_fs_read_directory_batch*) G_SYSCALL_DATA(state);
+
+	// create handler
+	g_contextual<g_syscall_fs_read_directory_batch*> bound_data(data, task->process->pageDirectory);
+	g_fs_transaction_handler_read_directory_batch* handler = new g_fs_transaction_handler_read_directory_batch(data->length, bound_data);
+
+	// buffer must fit at least one record
+	if (handler->get_capacity() == 0) {
+		data->count = 0;
+		data->used = 0;
+		data->status = G_FS_READ_DIRECTORY_ERROR;
+		delete handler;
+		return state;
+	}
+
+	g_filesystem::read_directory(task, data->iterator->node_id, data->iterator->position, handler);
+	return g_tasking::switchTask(state);
+}
+
 /**
  *
  */
@@ -388,9 +754,12 @@ G_SYSCALL_HANDLER(fs_stat) {
 	g_thread* task = g_tasking::getCurrentThread();
 
 	g_syscall_fs_stat* data = (g_syscall_fs_stat*) G_SYSCALL_DATA(state);
-	g_filesystem::stat(task, data->path, data->follow_symlinks, &data->stats);
+	g_contextual<g_syscall_fs_stat*> bound_data(data, task->process->pageDirectory);
 
-	return state;
+	g_fs_node* base = g_filesystem::get_path_base(task->process, data->path);
+	g_fs_transaction_handler_discovery_stat* handler = new g_fs_transaction_handler_discovery_stat(base, data->path, bound_data);
+	g_filesystem::discover_path(task, handler->base, handler->path, handler, data->follow_symlinks);
+	return g_tasking::switchTask(state);
 }
 
 /**
@@ -401,7 +770,221 @@ G_SYSCALL_HANDLER(fs_fstat) {
 	g_thread* task = g_tasking::getCurrentThread();
 
 	g_syscall_fs_fstat* data = (g_syscall_fs_fstat*) G_SYSCALL_DATA(state);
-	g_filesystem::fstat(task, data->fd, &data->stats);
 
+	g_fs_node* node;
+	g_file_descriptor_content* fd;
+	if (!g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
+		data->result = -1;
+		return state;
+	}
+
+	g_contextual<g_fs_stat_attributes*> attributes(&data->stats, task->process->pageDirectory);
+	g_contextual<int32_t*> result(&data->result, task->process->pageDirectory);
+	g_filesystem::stat(task, node, new g_fs_transaction_handler_get_length_stat(node, attributes, result));
+	return g_tasking::switchTask(state);
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(fs_io_ring_setup) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_io_ring_setup* data = (g_syscall_fs_io_ring_setup*) G_SYSCALL_DATA(state);
+
+	data->ring = g_io_rings::setup(task);
+	data->status = data->ring ? G_IO_RING_SETUP_SUCCESSFUL : G_IO_RING_SETUP_ERROR;
+	return state;
+}
+
+/**
+ * Takes the submissions from the ring of the process and, if requested, waits
+ * until enough completions are available.
+ */
+G_SYSCALL_HANDLER(fs_io_ring_enter) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_io_ring_enter* data = (g_syscall_fs_io_ring_enter*) G_SYSCALL_DATA(state);
+
+	if (!g_io_rings::submit(task, &data->submitted)) {
+		data->submitted = 0;
+		data->status = G_IO_RING_ENTER_NO_RING;
+		return state;
+	}
+	data->status = G_IO_RING_ENTER_SUCCESSFUL;
+
+	uint32_t available = g_io_rings::progress(task->process);
+	if (available < data->minimum_completions && g_io_rings::get_pending_count(task->process) > 0) {
+		task->wait(new g_waiter_io_ring(data->minimum_completions));
+		return g_tasking::switchTask(state);
+	}
+	return state;
+}
+
+/**
+ * Maps the contents of a file into the address space of the process. If the delegate
+ * can provide the pages that hold the contents, they are mapped directly. Otherwise
+ * the contents are read into new pages of the mapping.
+ */
+G_SYSCALL_HANDLER(fs_map) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_process* process = task->process;
+	g_syscall_fs_map* data = (g_syscall_fs_map*) G_SYSCALL_DATA(state);
+	data->address = 0;
+
+	g_fs_node* node;
+	g_file_descriptor_content* fd;
+	if (!g_filesystem::node_for_descriptor(process, data->fd, &node, &fd)) {
+		data->status = G_FS_MAP_INVALID_FD;
+		return state;
+	}
+
+	g_fs_delegate* delegate = node->get_delegate();
+	if (delegate == 0) {
+		data->status = G_FS_MAP_NOT_SUPPORTED;
+		return state;
+	}
+
+	// checked before aligning, aligning a length close to 4GiB would wrap
+	if (data->length == 0 || data->offset < 0 || data->length > (G_FS_MAPPING_MAXIMUM_PAGES - 1) * G_PAGE_SIZE) {
+		data->status = G_FS_MAP_INVALID_RANGE;
+		return state;
+	}
+	uint32_t max_pages = PAGE_ALIGN_UP(data->length) / G_PAGE_SIZE + 1;
+
+	g_local<g_physical_address> pages(new g_physical_address[max_pages]);
+	uint32_t count = 0;
+	uint32_t displacement = 0;
+	int64_t mapped_length = 0;
+	g_fs_map_status status = delegate->acquire_pages(node, data->offset, data->length, pages(), max_pages, &count, &displacement, &mapped_length);
+
+	if (status == G_FS_MAP_SUCCESSFUL) {
+		g_virtual_address base = g_fs_mappings::create(process, pages(), count, data->flags);
+
+		if (base == 0) {
+			for (uint32_t i = 0; i < count; i++) {
+				if (g_pp_reference_tracker::decrement(pages()[i]) == 0) {
+					g_pp_allocator::free(pages()[i]);
+				}
+			}
+			data->status = G_FS_MAP_ERROR;
+			return state;
+		}
+
+		data->address = (void*) (base + displacement);
+		data->status = G_FS_MAP_SUCCESSFUL;
+		return state;
+	}
+
+	if (status != G_FS_MAP_NOT_RESIDENT) {
+		data->status = status;
+		return state;
+	}
+
+	// read the contents into a mapping of new pages
+	g_virtual_address base = g_fs_mappings::create_anonymous(process, PAGE_ALIGN_UP(data->length) / G_PAGE_SIZE);
+	if (base == 0) {
+		data->status = G_FS_MAP_ERROR;
+		return state;
+	}
+
+	g_contextual<g_syscall_fs_map*> bound_data(data, process->pageDirectory);
+	g_fs_transaction_handler_map* handler = new g_fs_transaction_handler_map(node, fd, process, base, data->length, data->offset, data->flags,
+			bound_data);
+	g_fs_transaction_handler_start_status start_status = handler->start_transaction(task);
+
+	if (start_status == G_FS_TRANSACTION_STARTED_WITH_WAITER) {
+		return g_tasking::switchTask(state);
+	}
+
+	delete handler;
+	return state;
+}
+
+/**
+ * Moves data into a pipe without copying it through userspace. Between pipes, whole
+ * pages are relinked. From a file, the pages that hold the contents are appended to
+ * the pipe if the delegate can provide them; otherwise the call is not supported and
+ * the caller has to fall back to reading and writing. The call never blocks.
+ */
+G_SYSCALL_HANDLER(fs_splice) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_fs_splice* data = (g_syscall_fs_splice*) G_SYSCALL_DATA(state);
+	data->result = 0;
+
+	g_fs_node* in_node;
+	g_file_descriptor_content* in_fd;
+	g_fs_node* out_node;
+	g_file_descriptor_content* out_fd;
+	if (!g_filesystem::node_for_descriptor(task->process, data->in_fd, &in_node, &in_fd)
+			|| !g_filesystem::node_for_descriptor(task->process, data->out_fd, &out_node, &out_fd)) {
+		data->status = G_FS_SPLICE_INVALID_FD;
+		return state;
+	}
+
+	if (out_node->type != G_FS_NODE_TYPE_PIPE) {
+		data->status = G_FS_SPLICE_NOT_SUPPORTED;
+		return state;
+	}
+
+	g_pipe* target = g_pipes::get(out_node->phys_fs_id);
+	if (target == 0) {
+		data->status = G_FS_SPLICE_INVALID_FD;
+		return state;
+	}
+
+	// pipe to pipe
+	if (in_node->type == G_FS_NODE_TYPE_PIPE) {
+		g_pipe* source = g_pipes::get(in_node->phys_fs_id);
+		if (source == 0) {
+			data->status = G_FS_SPLICE_INVALID_FD;
+			return state;
+		}
+
+		data->result = g_pipes::splice(source, target, data->length);
+		data->status = G_FS_SPLICE_SUCCESSFUL;
+		return state;
+	}
+
+	// file to pipe
+	g_fs_delegate* delegate = in_node->get_delegate();
+	if (delegate == 0) {
+		data->status = G_FS_SPLICE_NOT_SUPPORTED;
+		return state;
+	}
+
+	uint32_t length = g_pipes::get_space(target);
+	if (data->length < length) {
+		length = data->length;
+	}
+	if (length == 0) {
+		data->status = G_FS_SPLICE_SUCCESSFUL;
+		return state;
+	}
+
+	uint32_t max_pages = PAGE_ALIGN_UP(length) / G_PAGE_SIZE + 1;
+	g_local<g_physical_address> pages(new g_physical_address[max_pages]);
+	uint32_t count = 0;
+	uint32_t displacement = 0;
+	int64_t available = 0;
+	g_fs_map_status status = delegate->acquire_pages(in_node, in_fd->offset, length, pages(), max_pages, &count, &displacement, &available);
+
+	if (status == G_FS_MAP_INVALID_RANGE) {
+		// nothing left to read
+		data->status = G_FS_SPLICE_SUCCESSFUL;
+		return state;
+	}
+	if (status != G_FS_MAP_SUCCESSFUL) {
+		data->status = G_FS_SPLICE_NOT_SUPPORTED;
+		return state;
+	}
+
+	uint32_t moved = g_pipes::append_pages(target, pages(), count, displacement, available);
+	in_fd->offset += moved;
+
+	data->result = moved;
+	data->status = (moved > 0 || available == 0) ? G_FS_SPLICE_SUCCESSFUL : G_FS_SPLICE_ERROR;
 	return state;
 }
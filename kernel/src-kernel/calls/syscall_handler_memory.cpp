@@ -31,6 +31,7 @@
 #include <memory/temporary_paging_util.hpp>
 #include <memory/constants.hpp>
 #include <memory/lower_heap.hpp>
+#include <filesystem/fs_mappings.hpp>
 
 /**
  * Allocates a memory area of at least "size" bytes. Memory is always allocated page-wise,
@@ -227,6 +228,12 @@ G_SYSCALL_HANDLER(unmap) {
 	g_syscall_unmap* data = (g_syscall_unmap*) G_SYSCALL_DATA(state);
 	g_virtual_address base = data->virtualBase;
 
+	// File mappings drop their page references instead
+	if (g_fs_mappings::release(process, base)) {
+		g_log_debug("%! task %i in process %i unmapped file mapping at %h", "syscall", process->main->id, task->id, base);
+		return state;
+	}
+
 	// Search for the range
 	g_address_range* range = process->virtualRanges.getRanges();
 	while (range) {
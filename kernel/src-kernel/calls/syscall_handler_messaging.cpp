@@ -21,6 +21,7 @@
 #include <calls/syscall_handler.hpp>
 
 #include <tasking/communication/message_controller.hpp>
+#include <tasking/communication/topics.hpp>
 #include <logger/logger.hpp>
 #include <tasking/tasking.hpp>
 #include <tasking/thread_manager.hpp>
@@ -28,6 +29,8 @@
 #include <tasking/wait/waiter_recv_topic_msg.hpp>
 #include <tasking/wait/waiter_send_message.hpp>
 #include <tasking/wait/waiter_receive_message.hpp>
+#include <tasking/wait/waiter_topic_publish.hpp>
+#include <tasking/wait/waiter_topic_receive.hpp>
 
 /**
  *
@@ -200,3 +203,90 @@ G_SYSCALL_HANDLER(recv_topic_msg) {
 	}
 }
 
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(topic_open) {
+
+	g_syscall_topic_open* data = (g_syscall_topic_open*) G_SYSCALL_DATA(state);
+	data->topic = g_topics::open(data->name);
+	return state;
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(topic_subscribe) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_topic_subscribe* data = (g_syscall_topic_subscribe*) G_SYSCALL_DATA(state);
+	data->subscription = g_topics::subscribe(task->id, data->topic, data->policy, data->capacity);
+	return state;
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(topic_unsubscribe) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_topic_unsubscribe* data = (g_syscall_topic_unsubscribe*) G_SYSCALL_DATA(state);
+	data->successful = g_topics::unsubscribe(task->id, data->subscription);
+	return state;
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(topic_publish) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_topic_publish* data = (g_syscall_topic_publish*) G_SYSCALL_DATA(state);
+
+	if (data->length > G_TOPIC_MAXIMUM_PAYLOAD) {
+		data->status = G_TOPIC_PUBLISH_STATUS_EXCEEDS_MAXIMUM;
+		return state;
+	}
+
+	// copy the payload once, it is shared by all subscribers
+	g_topic_payload* payload = g_topics::create_payload(task->id, data->buffer, data->length);
+	if (payload == 0) {
+		data->status = G_TOPIC_PUBLISH_STATUS_FAILED;
+		return state;
+	}
+
+	data->status = g_topics::publish(data->topic, payload);
+
+	// check if block
+	if (data->mode == G_TOPIC_PUBLISH_MODE_BLOCKING && data->status == G_TOPIC_PUBLISH_STATUS_QUEUE_FULL) {
+		g_waiter_topic_publish* waiter = new g_waiter_topic_publish(data, payload);
+		g_topics::wait_for_space(data->topic, waiter);
+		task->wait(waiter);
+		return g_tasking::switchTask(state);
+	}
+
+	g_topics::release_payload(payload);
+	return state;
+}
+
+/**
+ *
+ */
+G_SYSCALL_HANDLER(topic_receive) {
+
+	g_thread* task = g_tasking::getCurrentThread();
+	g_syscall_topic_receive* data = (g_syscall_topic_receive*) G_SYSCALL_DATA(state);
+
+	data->status = g_topics::receive(task->id, data->subscription, data->buffer, data->maximum, &data->length, &data->dropped);
+
+	// check if block
+	if (data->mode == G_TOPIC_RECEIVE_MODE_BLOCKING && data->status == G_TOPIC_RECEIVE_STATUS_QUEUE_EMPTY) {
+		g_waiter_topic_receive* waiter = new g_waiter_topic_receive(data);
+		g_topics::wait_for_message(data->subscription, waiter);
+		task->wait(waiter);
+		return g_tasking::switchTask(state);
+	}
+
+	return state;
+}
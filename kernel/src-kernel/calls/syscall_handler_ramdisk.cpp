@@ -88,7 +88,8 @@ G_SYSCALL_HANDLER(ramdisk_read) {
 	g_syscall_ramdisk_read* data = (g_syscall_ramdisk_read*) G_SYSCALL_DATA(state);
 
 	g_ramdisk_entry* entry = g_kernel_ramdisk->findById(data->nodeId);
-	if (entry && entry->type == G_RAMDISK_ENTRY_TYPE_FILE) {
+	uint8_t* entryData = (entry && entry->type == G_RAMDISK_ENTRY_TYPE_FILE) ? g_kernel_ramdisk->getData(entry) : 0;
+	if (entryData) {
 		int bytesFromOffset = entry->datalength - ((int32_t) data->offset);
 		if (bytesFromOffset < 0) {
 			bytesFromOffset = 0;
@@ -100,7 +101,7 @@ G_SYSCALL_HANDLER(ramdisk_read) {
 				data->buffer[i] = 0;
 			}
 
-			g_memory::copy(data->buffer, &entry->data[data->offset], byteCount);
+			g_memory::copy(data->buffer, &entryData[data->offset], byteCount);
 		}
 
 		data->readBytes = byteCount;
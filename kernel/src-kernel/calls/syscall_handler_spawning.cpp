@@ -394,7 +394,14 @@ G_SYSCALL_HANDLER(create_thread) {
 		thread->userData = data->userData;
 
 		data->processId = thread->id;
-		g_tasking::addTask(thread);
+
+		if (data->placement == G_THREAD_PLACEMENT_SAME_CORE) {
+			g_tasking::addTask(thread, true);
+		} else if (data->placement == G_THREAD_PLACEMENT_OTHER_CORE) {
+			g_tasking::addTaskToOtherCore(thread);
+		} else {
+			g_tasking::addTask(thread);
+		}
 	} else {
 		g_log_warn("%! (%i:%i) failed to spawn thread", "syscall", task->process->main->id, task->id);
 		data->processId = 0;
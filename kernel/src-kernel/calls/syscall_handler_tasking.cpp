@@ -28,6 +28,7 @@
 #include <tasking/wait/waiter_wait_for_irq.hpp>
 #include <tasking/wait/waiter_atomic_wait.hpp>
 #include <tasking/wait/waiter_join.hpp>
+#include <tasking/wait/waiter_poll.hpp>
 #include <system/interrupts/handling/interrupt_request_handler.hpp>
 
 /**
@@ -37,6 +38,16 @@ G_SYSCALL_HANDLER(yield) {
 	return g_tasking::switchTask(state);
 }
 
+/**
+ * Yields to a specific thread if it runs on the same processor
+ */
+G_SYSCALL_HANDLER(yield_to) {
+
+	g_syscall_yield_to* data = (g_syscall_yield_to*) G_SYSCALL_DATA(state);
+	g_tasking::getCurrentScheduler()->yieldTo(data->target);
+	return g_tasking::switchTask(state);
+}
+
 /**
  * Sets the status of the current task to dead and yields. On the next call
  * to the scheduler this process is removed completely.
@@ -163,7 +174,7 @@ G_SYSCALL_HANDLER(atomic_wait) {
 	bool set_on_finish = data->set_on_finish;
 
 	if (*atom) {
-		task->wait(new g_waiter_atomic_wait(atom, set_on_finish));
+		task->wait(new g_waiter_atomic_wait(atom, set_on_finish, data->owner));
 		return g_tasking::switchTask(state);
 	} else {
 		if (set_on_finish) {
@@ -339,3 +350,33 @@ G_SYSCALL_HANDLER(raise_signal) {
 	return g_tasking::switchTask(state);
 }
 
+
+/**
+ * Blocks the current thread until any of the entries in the given wait set has
+ * an event to report or the timeout expires. A timeout of zero only checks the
+ * entries and returns immediately.
+ */
+G_SYSCALL_HANDLER(poll) {
+
+	g_thread* thread = g_tasking::getCurrentThread();
+	g_syscall_poll* data = (g_syscall_poll*) G_SYSCALL_DATA(state);
+
+	if (data->count > G_POLL_MAXIMUM_ENTRIES) {
+		data->ready = -1;
+		data->status = G_POLL_STATUS_INVALID;
+		return state;
+	}
+
+	if (g_waiter_poll::check(thread, data) > 0) {
+		data->status = G_POLL_STATUS_SUCCESSFUL;
+		return state;
+	}
+
+	if (data->timeout == 0) {
+		data->status = G_POLL_STATUS_TIMEOUT;
+		return state;
+	}
+
+	thread->wait(new g_waiter_poll(data, g_tasking::getCurrentScheduler()));
+	return g_tasking::switchTask(state);
+}
@@ -46,7 +46,10 @@ g_elf32_spawn_status g_elf32_loader::spawnFromRamdisk(g_ramdisk_entry* entry, g_
 	}
 
 	// Get and validate ELF header
-	elf32_ehdr* header = (elf32_ehdr*) entry->data;
+	elf32_ehdr* header = (elf32_ehdr*) g_kernel_ramdisk->getData(entry);
+	if (header == 0) {
+		return ELF32_SPAWN_STATUS_FILE_NOT_FOUND;
+	}
 	g_elf32_validation_status status = validate(header);
 
 	if (status == ELF32_VALIDATION_SUCCESSFUL) {
@@ -0,0 +1,113 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/events.hpp"
+#include "logger/logger.hpp"
+#include "utils/hash_map.hpp"
+
+static g_event_id event_next_id = 0;
+static g_hash_map<g_event_id, g_event*>* events;
+
+void g_events::initialize() {
+	events = new g_hash_map<g_event_id, g_event*>();
+}
+
+g_event_id g_events::create() {
+
+	g_event* event = new g_event();
+	event->counter = 0;
+	event->references = 0;
+
+	g_event_id id = event_next_id++;
+	events->put(id, event);
+	return id;
+}
+
+g_event* g_events::get(g_event_id id) {
+
+	auto entry = events->get(id);
+	if (entry) {
+		return entry->value;
+	}
+	return 0;
+}
+
+void g_events::add_reference(g_event_id id, g_pid pid) {
+
+	auto event_entry = events->get(id);
+	if (event_entry) {
+		g_event* event = event_entry->value;
+
+		g_list_entry<g_pid>* entry = new g_list_entry<g_pid>;
+		entry->value = pid;
+		entry->next = event->references;
+		event->references = entry;
+	}
+}
+
+void g_events::remove_reference(g_event_id id, g_pid pid) {
+
+	auto event_entry = events->get(id);
+	if (event_entry) {
+		g_event* event = event_entry->value;
+
+		// find entry and remove
+		g_list_entry<g_pid>* prev = 0;
+		g_list_entry<g_pid>* entry = event->references;
+		while (entry) {
+			if (entry->value == pid) {
+				if (prev == 0) {
+					event->references = entry->next;
+				} else {
+					prev->next = entry->next;
+				}
+				delete entry;
+				break;
+			}
+			prev = entry;
+			entry = entry->next;
+		}
+
+		// no entry left?
+		if (event->references == 0) {
+			events->remove(id);
+
+			g_log_debug("%! removing non-referenced event %i", "events", id);
+			delete event;
+		}
+	}
+}
+
+void g_events::signal(g_event* event, uint64_t value) {
+
+	event->counter += value;
+	event->waiters.wake_all();
+}
+
+uint64_t g_events::take(g_event* event) {
+
+	uint64_t value = event->counter;
+	event->counter = 0;
+	return value;
+}
+
+bool g_events::is_signaled(g_event* event) {
+	return event->counter > 0;
+}
@@ -0,0 +1,90 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_EVENTS
+#define GHOST_FILESYSTEM_EVENTS
+
+#include "ghost/stdint.h"
+#include "utils/list_entry.hpp"
+#include "tasking/process.hpp"
+#include "tasking/wait/wait_queue.hpp"
+
+typedef int g_event_id;
+
+/**
+ * A counting event. Signaling adds to the counter and wakes all threads
+ * that wait on the event, waiting takes the whole counter.
+ */
+struct g_event {
+	uint64_t counter;
+	g_wait_queue waiters;
+
+	g_list_entry<g_pid>* references;
+};
+
+class g_events {
+public:
+
+	/**
+	 *
+	 */
+	static void initialize();
+
+	/**
+	 *
+	 */
+	static g_event* get(g_event_id id);
+
+	/**
+	 *
+	 */
+	static g_event_id create();
+
+	/**
+	 *
+	 */
+	static void add_reference(g_event_id event, g_pid pid);
+
+	/**
+	 * Removes the reference of a process. An event that is no longer
+	 * referenced is destroyed, waking its remaining waiters.
+	 */
+	static void remove_reference(g_event_id event, g_pid pid);
+
+	/**
+	 * Adds the value to the counter of the event and wakes its waiters.
+	 */
+	static void signal(g_event* event, uint64_t value);
+
+	/**
+	 * Takes the current counter value of the event, resetting it to zero.
+	 *
+	 * @return the taken value, zero if the event was not signaled
+	 */
+	static uint64_t take(g_event* event);
+
+	/**
+	 *
+	 */
+	static bool is_signaled(g_event* event);
+
+};
+
+#endif
@@ -22,13 +22,19 @@
 #include "filesystem/fs_descriptors.hpp"
 #include "filesystem/fs_transaction_store.hpp"
 #include "filesystem/fs_delegate.hpp"
+#include "filesystem/fs_node_cache.hpp"
 #include "filesystem/fs_delegate_root.hpp"
 #include "filesystem/fs_delegate_ramdisk.hpp"
 #include "filesystem/fs_delegate_pipe.hpp"
 #include "filesystem/fs_delegate_tasked.hpp"
 #include "filesystem/pipes.hpp"
+#include "filesystem/fs_delegate_event.hpp"
+#include "filesystem/fs_delegate_tmpfs.hpp"
+#include "filesystem/tmpfs.hpp"
+#include "filesystem/events.hpp"
 
 #include "tasking/wait/waiter_fs_transaction.hpp"
+#include "tasking/tasking.hpp"
 #include "logger/logger.hpp"
 
 #include "ghost/utils/local.hpp"
@@ -44,13 +50,15 @@ static g_hash_map<g_fs_virt_id, g_fs_node*>* nodes;
 
 static g_fs_node* root;
 static g_fs_node* pipe_root;
+static g_fs_node* event_root;
 
 /**
  *
  */
 void g_filesystem::initialize() {
 	g_pipes::initialize();
-	g_file_descriptors::initialize();
+	g_events::initialize();
+	g_tmpfs::initialize();
 	g_fs_transaction_store::initialize();
 	nodes = new g_hash_map<g_fs_virt_id, g_fs_node*>();
 
@@ -73,6 +81,21 @@ void g_filesystem::initialize() {
 	pipe_root->type = G_FS_NODE_TYPE_MOUNTPOINT;
 	root->add_child(pipe_root);
 
+	// event root
+	event_root = create_node();
+	event_root->set_delegate(new g_fs_delegate_event());
+	event_root->name = (char*) "event";
+	event_root->type = G_FS_NODE_TYPE_MOUNTPOINT;
+	root->add_child(event_root);
+
+	// tmpfs root
+	g_fs_node* tmp_root = create_node();
+	tmp_root->set_delegate(new g_fs_delegate_tmpfs());
+	tmp_root->name = (char*) "tmp";
+	tmp_root->type = G_FS_NODE_TYPE_MOUNTPOINT;
+	tmp_root->phys_fs_id = g_tmpfs::get_root()->id;
+	root->add_child(tmp_root);
+
 	g_log_info("%! initial resources created", "filesystem");
 }
 
@@ -95,49 +118,47 @@ g_fs_node* g_filesystem::create_node() {
 	g_fs_node* node = new g_fs_node();
 	node->id = node_next_id++;
 	nodes->put(node->id, node);
+	g_fs_node_cache::created(node);
 	return node;
 }
 
 /**
  *
  */
-void g_filesystem::find_existing(char* absolute_path, g_fs_node** out_parent,
-		g_fs_node** out_child, char* name_current, bool follow_symlinks) {
+void g_filesystem::remove_node(g_fs_node* node) {
+	nodes->remove(node->id);
+}
+
+/**
+ *
+ */
+void g_filesystem::find_existing(g_fs_node* base, const char* path, g_fs_node** out_parent,
+		g_fs_node** out_child, g_fs_path_slice* name_current, bool follow_symlinks,
+		const char** out_remaining) {
 
 	g_fs_node* parent = 0;
-	g_fs_node* child = root;
+	g_fs_node* child = (path[0] == '/') ? root : base;
 
-	char* abspos = absolute_path;
+	const char* position = path;
+	name_current->start = path;
+	name_current->length = 0;
 
 	while (true) {
 		// parent is now child
 		parent = child;
 
-		// copy first name on left into current
-		while (*abspos == '/') {
-			++abspos;
-		}
-
-		char* curpos = name_current;
-		int curlen = 0;
-		while (*abspos != 0 && *abspos != '/') {
-			*curpos++ = *abspos++;
-			++curlen;
-		}
-		*curpos = 0;
-
 		// quit if nothing left in path
-		if (curlen == 0) {
+		if (!g_fs_path::next_element(&position, name_current)) {
 			break;
 		}
 
 		// handle specials
-		if (g_string::equals("..", name_current)) {
+		if (g_fs_path::is_parent(name_current)) {
 			if (parent->parent != 0) {
 				child = parent->parent;
 			}
 
-		} else if (g_string::equals(".", name_current)) {
+		} else if (g_fs_path::is_current(name_current)) {
 			// skip
 
 		} else {
@@ -168,51 +189,240 @@ void g_filesystem::find_existing(char* absolute_path, g_fs_node** out_parent,
 
 	*out_parent = parent;
 	*out_child = child;
+
+	if (out_remaining) {
+		*out_remaining = g_fs_path::skip_separators(position);
+	}
 }
 
 /**
- *
+ * A process that never changed its working directory is in the root.
+ */
+g_fs_node* g_filesystem::get_path_base(g_process* process, const char* path) {
+
+	if (path[0] == 0 || path[0] == '/' || process->workingDirectoryNode == 0) {
+		return root;
+	}
+	return process->workingDirectoryNode;
+}
+
+/**
+ * The node can only be created if all elements but the last one exist.
  */
-void g_filesystem::process_closed(g_pid pid) {
-	g_file_descriptor_table* table = g_file_descriptors::get_process_table(pid);
+g_fs_node* g_filesystem::create(g_fs_node* base, const char* path, g_fs_node_type type) {
+
+	// find the parent folder
+	g_fs_node* parent = 0;
+	g_fs_node* child = 0;
+	g_fs_path_slice name;
+	const char* remaining = 0;
+	find_existing(base, path, &parent, &child, &name, true, &remaining);
+	if (child || *remaining != 0) {
+		return 0;
+	}
 
-	// close each entry
-	for (auto iter = table->descriptors.begin();
-			iter != table->descriptors.end(); ++iter) {
-		g_file_descriptor_content* content = iter->value;
+	if (name.length >= G_FILENAME_MAX) {
+		return 0;
+	}
+
+	g_fs_delegate* delegate = parent->get_delegate();
+	if (delegate == 0) {
+		return 0;
+	}
+
+	g_local<char> name_copy(new char[name.length + 1]);
+	g_memory::copy(name_copy(), name.start, name.length);
+	name_copy()[name.length] = 0;
+	return delegate->create_child(parent, name_copy(), type);
+}
+
+/**
+ *
+ */
+void g_filesystem::process_closed(g_process* process) {
+	g_file_descriptor_table* table = process->fileDescriptors;
+
+	// close each entry, closing removes it from the table
+	for (uint32_t i = 0; i < table->size; i++) {
+		g_file_descriptor_content* content = table->entries[i];
+		if (content == 0) {
+			continue;
+		}
 
 		auto node_entry = nodes->get(content->node_id);
 		if (node_entry) {
+			// buffered writes are passed on although nobody waits for them
+			g_fs_delegate* delegate = node_entry->value->get_delegate();
+			if (delegate) {
+				delegate->flush_detached(node_entry->value);
+			}
+
 			g_fs_close_status stat;
-			close(pid, node_entry->value, content, &stat);
+			close(process, node_entry->value, content, &stat);
 
 			if (stat == G_FS_CLOSE_SUCCESSFUL) {
 				g_log_debug(
 						"%! successfully closed fd %i when exiting process %i",
-						"filesystem", content->id, pid);
+						"filesystem", i, process->main->id);
 			} else {
 				g_log_debug(
 						"%! failed to close fd %i when exiting process %i with status %i",
-						"filesystem", content->id, pid, stat);
+						"filesystem", i, process->main->id, stat);
 			}
 		}
 	}
 
 	// remove all entries
-	g_file_descriptors::unmap_all(pid);
+	g_file_descriptors::unmap_all(process);
+
+	if (process->workingDirectoryNode) {
+		process->workingDirectoryNode->unpin();
+		process->workingDirectoryNode = 0;
+	}
+
+	// release directories that were not closed
+	while (process->openDirectories) {
+		g_list_entry<g_fs_node*>* entry = process->openDirectories;
+		process->openDirectories = entry->next;
+		entry->value->unpin();
+		delete entry;
+	}
+}
+
+/**
+ *
+ */
+void g_filesystem::open_directory(g_process* process, g_fs_node* node) {
+
+	node->pin();
+
+	g_list_entry<g_fs_node*>* entry = new g_list_entry<g_fs_node*>();
+	entry->value = node;
+	entry->next = process->openDirectories;
+	process->openDirectories = entry;
+}
+
+/**
+ *
+ */
+void g_filesystem::close_directory(g_process* process, g_fs_virt_id node_id) {
+
+	g_list_entry<g_fs_node*>** pos = &process->openDirectories;
+	while (*pos) {
+		g_list_entry<g_fs_node*>* entry = *pos;
+		if (entry->value->id == node_id) {
+			*pos = entry->next;
+			entry->value->unpin();
+			delete entry;
+			return;
+		}
+		pos = &entry->next;
+	}
+}
+
+/**
+ * Delegates of tasks are mounted directly below the root.
+ */
+void g_filesystem::transaction_status_changed(g_thread* thread) {
+
+	g_list_entry<g_fs_node*>* entry = root->children;
+	while (entry) {
+		g_fs_node* child = entry->value;
+		if (child->type == G_FS_NODE_TYPE_MOUNTPOINT) {
+			g_fs_delegate* delegate = child->get_delegate();
+			if (delegate && delegate->get_serving_thread() == thread->id) {
+				delegate->transaction_status_changed();
+			}
+		}
+		entry = entry->next;
+	}
+}
+
+/**
+ * The descriptors are copied as a whole, then the references that opening would
+ * have added are taken for pipes and events. The child also starts in the working
+ * directory of its parent.
+ */
+void g_filesystem::process_forked(g_process* parent, g_process* child) {
+
+	g_file_descriptors::clone_all(parent, child);
+
+	g_file_descriptor_table* table = child->fileDescriptors;
+	for (uint32_t i = 0; i < table->size; i++) {
+		g_file_descriptor_content* content = table->entries[i];
+		if (content == 0) {
+			continue;
+		}
+
+		auto node_entry = nodes->get(content->node_id);
+		if (node_entry == 0) {
+			continue;
+		}
+
+		g_fs_node* node = node_entry->value;
+		node->pin();
+		if (node->type == G_FS_NODE_TYPE_PIPE) {
+			g_pipes::add_reference(node->phys_fs_id, child->main->id);
+		} else if (node->type == G_FS_NODE_TYPE_EVENT) {
+			g_events::add_reference(node->phys_fs_id, child->main->id);
+		}
+	}
+
+	g_string::copy(child->workingDirectory, parent->workingDirectory);
+	child->workingDirectoryNode = parent->workingDirectoryNode;
+	if (child->workingDirectoryNode) {
+		child->workingDirectoryNode->pin();
+	}
+
+	// the iterators are in the copied memory of the child
+	g_list_entry<g_fs_node*>* entry = parent->openDirectories;
+	while (entry) {
+		open_directory(child, entry->value);
+		entry = entry->next;
+	}
 }
 
 /**
  *
  */
-g_fd g_filesystem::open(g_pid pid, g_fs_node* node, int32_t flags, g_fd fd) {
+g_poll_events g_filesystem::poll(g_thread* thread, g_fs_node* node,
+		g_poll_events events) {
+
+	g_fs_delegate* delegate = node->get_delegate();
+	if (delegate == 0) {
+		return G_POLL_EVENT_ERROR;
+	}
+
+	return delegate->poll(thread, node, events);
+}
+
+/**
+ * Each descriptor pins its node, so that it stays in the tree while it is open.
+ */
+g_fd g_filesystem::open(g_process* process, g_fs_node* node, int32_t flags, g_fd fd) {
 
 	if (node->type == G_FS_NODE_TYPE_FILE) {
-		return g_file_descriptors::map(pid, node->id, fd);
+		g_fd created = g_file_descriptors::map(process, node->id, fd);
+		if (created != -1) {
+			node->pin();
+		}
+		return created;
 
 	} else if (node->type == G_FS_NODE_TYPE_PIPE) {
-		g_pipes::add_reference(node->phys_fs_id, pid);
-		return g_file_descriptors::map(pid, node->id, fd);
+		g_fd created = g_file_descriptors::map(process, node->id, fd);
+		if (created != -1) {
+			node->pin();
+			g_pipes::add_reference(node->phys_fs_id, process->main->id);
+		}
+		return created;
+
+	} else if (node->type == G_FS_NODE_TYPE_EVENT) {
+		g_fd created = g_file_descriptors::map(process, node->id, fd);
+		if (created != -1) {
+			node->pin();
+			g_events::add_reference(node->phys_fs_id, process->main->id);
+		}
+		return created;
 	}
 
 	g_log_warn("%! tried to open a node of non-file type %i", "filesystem",
@@ -223,17 +433,31 @@ g_fd g_filesystem::open(g_pid pid, g_fs_node* node, int32_t flags, g_fd fd) {
 /**
  *
  */
-bool g_filesystem::close(g_pid pid, g_fs_node* node,
+bool g_filesystem::close(g_process* process, g_fs_node* node,
 		g_file_descriptor_content* fd, g_fs_close_status* out_status) {
 
 	if (node->type == G_FS_NODE_TYPE_FILE) {
-		g_file_descriptors::unmap(pid, fd->id);
+		g_file_descriptors::unmap(process, fd->id);
+		node->unpin();
 		*out_status = G_FS_CLOSE_SUCCESSFUL;
 		return 0;
 
 	} else if (node->type == G_FS_NODE_TYPE_PIPE) {
-		g_pipes::remove_reference(node->phys_fs_id, pid);
-		g_file_descriptors::unmap(pid, fd->id);
+		g_pipes::remove_reference(node->phys_fs_id, process->main->id);
+		g_file_descriptors::unmap(process, fd->id);
+		node->unpin();
+		*out_status = G_FS_CLOSE_SUCCESSFUL;
+		return 0;
+
+	} else if (node->type == G_FS_NODE_TYPE_EVENT) {
+		g_events::remove_reference(node->phys_fs_id, process->main->id);
+		g_file_descriptors::unmap(process, fd->id);
+		node->unpin();
+
+		// the node goes away with the last reference to the event
+		if (g_events::get(node->phys_fs_id) == 0) {
+			g_fs_node_cache::destroy(node);
+		}
 		*out_status = G_FS_CLOSE_SUCCESSFUL;
 		return 0;
 	}
@@ -249,15 +473,10 @@ bool g_filesystem::close(g_pid pid, g_fs_node* node,
  */
 void g_filesystem::get_real_path_to_node(g_fs_node* node, char* out) {
 
-	g_fs_node* current = node;
-
+	// measure the path first, so that each name is only copied once
 	int abs_len = 0;
-	while (current != 0) {
-
-		// on root we can stop
-		if (current->type == G_FS_NODE_TYPE_ROOT) {
-			break;
-		}
+	g_fs_node* current = node;
+	while (current != 0 && current->type != G_FS_NODE_TYPE_ROOT) {
 
 		// check
 		if (current->name == 0) {
@@ -268,57 +487,31 @@ void g_filesystem::get_real_path_to_node(g_fs_node* node, char* out) {
 
 		// get & check length + slash
 		int name_len = g_string::length(current->name);
-		if (abs_len + name_len + 1 > G_PATH_MAX) {
+		if (abs_len + name_len + 2 > G_PATH_MAX) {
 			g_log_warn(
 					"%! problem: tried to create a path thats longer than G_PATH_MAX from a node",
 					"filesystem");
 			break;
 		}
-
-		// copy so that out contains: current->name "/" out
-		for (int i = abs_len; i >= 0; i--) {
-			out[i + name_len + 1] = out[i];
-		}
-		out[name_len] = '/';
-		g_memory::copy(out, current->name, name_len);
-
 		abs_len += name_len + 1;
 
 		current = current->parent;
 	}
+	g_fs_node* last = current;
 
-	// add final slash & null termination
-	for (int i = abs_len; i >= 0; i--) {
-		out[i + 1] = out[i];
-	}
+	// fill from the end, each name is followed by a slash
 	out[0] = '/';
 	out[abs_len + 1] = 0;
-}
-
-/**
- *
- */
-void g_filesystem::concat_as_absolute_path(char* relative_base, char* in,
-		char* out) {
 
-	// check if valid input
-	int len_in = g_string::length(in);
-	if (len_in == 0) {
-		out[0] = 0;
-		return;
-	}
+	int pos = abs_len + 1;
+	current = node;
+	while (current != last) {
+		int name_len = g_string::length(current->name);
+		out[--pos] = '/';
+		pos -= name_len;
+		g_memory::copy(&out[pos], current->name, name_len);
 
-	// if path is absolute, only copy to out
-	if (in[0] == '/') {
-		g_string::copy(out, in);
-	} else {
-		// otherwise append: cwd + "/" + in
-		int len_cwd = g_string::length(relative_base);
-		int len_sep = 1;
-		g_memory::copy(out, relative_base, len_cwd);
-		g_memory::copy(&out[len_cwd], "/", len_sep);
-		g_memory::copy(&out[len_cwd + len_sep], in, len_in);
-		out[len_cwd + len_in + len_sep] = 0;
+		current = current->parent;
 	}
 }
 
@@ -363,47 +556,69 @@ g_fs_register_as_delegate_status g_filesystem::create_delegate(g_thread* thread,
 /**
  *
  */
-bool g_filesystem::discover_absolute_path(g_thread* requester,
-		char* absolute_path, g_fs_transaction_handler_discovery* handler,
+bool g_filesystem::discover_path(g_thread* requester, g_fs_node* base,
+		const char* path, g_fs_transaction_handler_discovery* handler,
 		bool follow_symlinks) {
 
 	// check if this node is already discovered
 	g_fs_node* parent = 0;
 	g_fs_node* child = 0;
-	g_local<char> last_name(new char[G_PATH_MAX]);
-	g_filesystem::find_existing(absolute_path, &parent, &child, last_name(),
-			follow_symlinks);
+	g_fs_path_slice last_name;
+	const char* remaining = 0;
+	g_filesystem::find_existing(base, path, &parent, &child, &last_name,
+			follow_symlinks, &remaining);
+
+	// a repeated transaction is finished through the waiter that is still on the requester
+	bool repeating = handler->wants_repeat_transaction();
 
 	// if the node already exists, tell the handler that discovery was successful
 	if (child) {
 		handler->status = G_FS_DISCOVERY_SUCCESSFUL;
 		handler->node = child;
 		handler->all_nodes_discovered = true;
+		if (repeating) {
+			g_fs_transaction_store::set_status(handler->get_repeated_transaction(), G_FS_TRANSACTION_FINISHED);
+			return false;
+		}
 		handler->finish_transaction(requester, child->get_delegate());
 
 	} else {
 		// otherwise, request the driver delegate to discover it and set to sleep
 		g_fs_delegate* delegate = parent->get_delegate();
 		if (delegate) {
+			// only the name that is asked for is copied out of the path
+			g_local<char> name(new char[last_name.length + 1]);
+			g_memory::copy(name(), last_name.start, last_name.length);
+			name()[last_name.length] = 0;
+
+			// delegates may discover the rest of the path at once
+			handler->remaining_path = remaining;
 			g_fs_transaction_id transaction = delegate->request_discovery(
-					requester, parent, last_name(), handler);
-			requester->wait(
-					new g_waiter_fs_transaction(handler, transaction,
-							delegate));
+					requester, parent, name(), handler);
+			handler->remaining_path = 0;
+			if (!repeating) {
+				requester->wait(
+						new g_waiter_fs_transaction(handler, transaction,
+								delegate));
+			}
 			return false;
 		}
 
 		// if no driver delegate, error
 		if (parent == root) {
 			g_log_warn("%! mountpoint for '%s' does not exist", "filesystem",
-					absolute_path);
+					path);
 		} else {
 			g_log_warn(
 					"%! discovery of '%s' failed due to missing delegate on node %i",
-					"filesystem", absolute_path, parent->id);
+					"filesystem", path, parent->id);
 		}
 		handler->status = G_FS_DISCOVERY_ERROR;
 		handler->all_nodes_discovered = true;
+		if (repeating) {
+			g_fs_transaction_store::set_status(handler->get_repeated_transaction(), G_FS_TRANSACTION_FINISHED);
+			return false;
+		}
 		handler->finish_transaction(requester, 0);
 	}
 
@@ -418,8 +633,26 @@ bool g_filesystem::get_length(g_thread* task, g_fs_node* node,
 
 	g_fs_delegate* delegate = node->get_delegate();
 	if (delegate) {
-		g_fs_transaction_id transaction = delegate->request_get_length(task,
-				node, handler);
+		handler->node = node;
+
+		// when a transaction is repeated, the waiter is still on the requesters task
+		if (handler->wants_repeat_transaction()) {
+			delegate->request_get_length(task, node, handler);
+			return false;
+		}
+
+		// a cached length finishes the transaction without asking the delegate
+		g_fs_transaction_id transaction;
+		if (node->get_cached_length(&handler->length)) {
+			transaction = g_fs_transaction_store::next_transaction();
+			handler->status = G_FS_LENGTH_SUCCESSFUL;
+			handler->served_from_cache = true;
+			g_fs_transaction_store::set_status(transaction,
+					G_FS_TRANSACTION_FINISHED);
+		} else {
+			transaction = delegate->request_get_length(task, node, handler);
+		}
+
 		task->wait(new g_waiter_fs_transaction(handler, transaction, delegate));
 		return false;
 	}
@@ -430,11 +663,11 @@ bool g_filesystem::get_length(g_thread* task, g_fs_node* node,
 /**
  *
  */
-bool g_filesystem::node_for_descriptor(g_pid pid, g_fd fd, g_fs_node** out_node,
+bool g_filesystem::node_for_descriptor(g_process* process, g_fd fd, g_fs_node** out_node,
 		g_file_descriptor_content** out_fd) {
 
 	// find file descriptor
-	g_file_descriptor_content* fd_content = g_file_descriptors::get(pid, fd);
+	g_file_descriptor_content* fd_content = g_file_descriptors::get(process, fd);
 	if (fd_content == 0) {
 		return false;
 	}
@@ -534,6 +767,41 @@ g_fs_transaction_handler_start_status g_filesystem::write(g_thread* thread,
 	return G_FS_TRANSACTION_STARTED_AND_FINISHED;
 }
 
+/**
+ *
+ */
+g_fs_transaction_handler_start_status g_filesystem::flush(g_thread* thread,
+		g_fs_node* node, g_fs_transaction_handler_flush* handler) {
+
+	g_fs_delegate* delegate = node->get_delegate();
+	if (delegate == 0) {
+		g_log_warn(
+				"%! flushing failed due to missing delegate on node %i",
+				"filesystem", node->id);
+		return G_FS_TRANSACTION_START_FAILED;
+	}
+
+	// when a transaction is repeated, the waiter is still on the requesters task
+	if (handler->wants_repeat_transaction()) {
+		delegate->request_flush(thread, node, handler);
+		return G_FS_TRANSACTION_STARTED_WITH_WAITER;
+	}
+
+	g_fs_transaction_id transaction = delegate->request_flush(thread, node,
+			handler);
+
+	bool keep_waiting = g_waiter_fs_transaction::check_transaction_status(
+			thread, handler, transaction, delegate);
+
+	if (keep_waiting) {
+		thread->wait(
+				new g_waiter_fs_transaction(handler, transaction, delegate));
+		return G_FS_TRANSACTION_STARTED_WITH_WAITER;
+	}
+
+	return G_FS_TRANSACTION_STARTED_AND_FINISHED;
+}
+
 /**
  *
  */
@@ -549,12 +817,20 @@ void g_filesystem::read_directory(g_thread* thread, g_fs_virt_id node_id,
 
 	// ask driver delegate to perform operation
 	g_fs_node* node = entry->value;
+	g_fs_node_cache::touch(node);
+	handler->directory = node;
+	handler->position = position;
+
 	g_fs_delegate* delegate = node->get_delegate();
 	if (delegate) {
 		g_fs_transaction_id transaction = delegate->request_read_directory(
 				thread, node, position, handler);
-		thread->wait(
-				new g_waiter_fs_transaction(handler, transaction, delegate));
+
+		// when a transaction is repeated, the waiter is still on the requesters task
+		if (!handler->wants_repeat_transaction()) {
+			thread->wait(
+					new g_waiter_fs_transaction(handler, transaction, delegate));
+		}
 	} else {
 		// if no driver delegate, error
 		g_log_warn(
@@ -566,9 +842,30 @@ void g_filesystem::read_directory(g_thread* thread, g_fs_virt_id node_id,
 g_fd g_filesystem::clonefd(g_thread* thread, g_fd source_fd, g_pid source_pid,
 		g_fd target_fd, g_pid target_pid, g_fs_clonefd_status* out_status) {
 
+	// resolve the processes, only foreign pids require a lookup
+	g_process* own_process = thread->process;
+	g_thread* source_task = own_process->main;
+	if (source_pid != own_process->main->id) {
+		source_task = g_tasking::getTaskById(source_pid);
+	}
+	g_thread* target_task = own_process->main;
+	if (target_pid != own_process->main->id) {
+		target_task = g_tasking::getTaskById(target_pid);
+	}
+	if (source_task == 0) {
+		*out_status = G_FS_CLONEFD_INVALID_SOURCE_FD;
+		return -1;
+	}
+	if (target_task == 0) {
+		*out_status = G_FS_CLONEFD_ERROR;
+		return -1;
+	}
+	g_process* source_process = source_task->process;
+	g_process* target_process = target_task->process;
+
 	g_fs_node* source_node;
 	g_file_descriptor_content* source_fd_content;
-	if (!node_for_descriptor(source_pid, source_fd, &source_node,
+	if (!node_for_descriptor(source_process, source_fd, &source_node,
 			&source_fd_content)) {
 		*out_status = G_FS_CLONEFD_INVALID_SOURCE_FD;
 		return -1;
@@ -577,24 +874,24 @@ g_fd g_filesystem::clonefd(g_thread* thread, g_fd source_fd, g_pid source_pid,
 	g_file_descriptor_content* target_fd_content = 0;
 	g_fs_node* target_node = 0;
 	if (target_fd != -1) {
-		node_for_descriptor(target_pid, target_fd, &target_node,
+		node_for_descriptor(target_process, target_fd, &target_node,
 				&target_fd_content);
 
 		// close old file descriptor if available
 		if (target_node) {
 			g_fs_close_status close_status;
-			close(source_pid, target_node, target_fd_content, &close_status);
+			close(target_process, target_node, target_fd_content, &close_status);
 		}
 	}
 
 	// open new file descriptor
-	g_fd created = open(target_pid, source_node, 0, target_fd);
+	g_fd created = open(target_process, source_node, 0, target_fd);
 	if (created != -1) {
 
 		// clone fd contents
 		g_file_descriptor_content* created_fd_content = 0;
 		g_fs_node* created_node = 0;
-		if (!node_for_descriptor(target_pid, created, &created_node,
+		if (!node_for_descriptor(target_process, created, &created_node,
 				&created_fd_content)) {
 			*out_status = G_FS_CLONEFD_ERROR;
 			return -1;
@@ -610,29 +907,59 @@ g_fd g_filesystem::clonefd(g_thread* thread, g_fd source_fd, g_pid source_pid,
 	return -1;
 }
 
-g_fs_pipe_status g_filesystem::pipe(g_thread* thread, g_fd* out_write,
-		g_fd* out_read) {
+g_fs_pipe_status g_filesystem::pipe(g_thread* thread, uint32_t capacity,
+		g_fd* out_write, g_fd* out_read) {
+
+	g_pipe_id pipe = g_pipes::create(capacity);
+	if (pipe == -1) {
+		return G_FS_PIPE_ERROR;
+	}
 
 	g_fs_node* node = create_node();
 	node->type = G_FS_NODE_TYPE_PIPE;
 	pipe_root->add_child(node);
 
-	node->phys_fs_id = g_pipes::create();
-	*out_write = open(thread->process->main->id, node, 0);
-	*out_read = open(thread->process->main->id, node, 0);
+	node->phys_fs_id = pipe;
+	*out_write = open(thread->process, node, 0);
+	*out_read = open(thread->process, node, 0);
 	return G_FS_PIPE_SUCCESSFUL;
 }
 
-int32_t g_filesystem::stat(g_thread* thread, char* path, bool follow_symlinks,
-		g_fs_stat_attributes* stat) {
+g_event_create_status g_filesystem::create_event(g_thread* thread,
+		g_fd* out_fd) {
 
-	// TODO
-	return -1;
+	g_fs_node* node = create_node();
+	node->type = G_FS_NODE_TYPE_EVENT;
+	event_root->add_child(node);
+
+	node->phys_fs_id = g_events::create();
+	*out_fd = open(thread->process, node, 0);
+	if (*out_fd == -1) {
+		// without a reference, this destroys the event
+		g_events::remove_reference(node->phys_fs_id, thread->process->main->id);
+		g_fs_node_cache::destroy(node);
+		return G_EVENT_CREATE_ERROR;
+	}
+	return G_EVENT_CREATE_SUCCESSFUL;
 }
 
-int32_t g_filesystem::fstat(g_thread* thread, g_fd fd,
-		g_fs_stat_attributes* stat) {
+/**
+ * Nodes other than files are finished with a transaction of their own, so the
+ * requester always waits for the handler.
+ */
+void g_filesystem::stat(g_thread* thread, g_fs_node* node,
+		g_fs_transaction_handler_get_length* handler) {
+
+	if (node->type == G_FS_NODE_TYPE_FILE && !get_length(thread, node, handler)) {
+		return;
+	}
+
+	handler->node = node;
+	handler->length = 0;
+	handler->status = (node->type == G_FS_NODE_TYPE_FILE) ? G_FS_LENGTH_ERROR : G_FS_LENGTH_SUCCESSFUL;
+	handler->served_from_cache = true;
 
-	// TODO
-	return -1;
+	g_fs_transaction_id transaction = g_fs_transaction_store::next_transaction();
+	g_fs_transaction_store::set_status(transaction, G_FS_TRANSACTION_FINISHED);
+	thread->wait(new g_waiter_fs_transaction(handler, transaction, node->get_delegate()));
 }
@@ -29,6 +29,7 @@
 #include "filesystem/fs_transaction_handler_write.hpp"
 #include "filesystem/fs_transaction_handler_discovery.hpp"
 #include "filesystem/fs_transaction_handler_get_length.hpp"
+#include "filesystem/fs_transaction_handler_flush.hpp"
 
 #include "ghost/stdint.h"
 #include <tasking/tasking.hpp>
@@ -59,7 +60,13 @@ public:
 	static g_fs_node* create_node();
 
 	/**
-	 * This routine discovers (creates virtual nodes for) the given absolute path.
+	 * Removes a node that was unlinked from the tree from the global map of nodes.
+	 * The node itself is not deleted.
+	 */
+	static void remove_node(g_fs_node* node);
+
+	/**
+	 * This routine discovers (creates virtual nodes for) the given path.
 	 *
 	 * This is done by looking up all path elements as virtual nodes top-down.
 	 * If all of the path elements already exist as virtual nodes, this function immediately
@@ -72,8 +79,11 @@ public:
 	 * @param task
 	 * 		the task that is waiting for the discovery
 	 *
-	 * @param absolute_path
-	 * 		the absolute path to lookup
+	 * @param base
+	 * 		the node that a relative path starts from
+	 *
+	 * @param path
+	 * 		the absolute or relative path to lookup
 	 *
 	 * @param handler
 	 * 		a subtype of {g_fs_transaction_handler_discovery} that is notified on
@@ -84,7 +94,7 @@ public:
 	 *
 	 * @return whether the discovery is finished or not
 	 */
-	static bool discover_absolute_path(g_thread* task, char* absolute_path, g_fs_transaction_handler_discovery* handler, bool follow_symlinks = true);
+	static bool discover_path(g_thread* task, g_fs_node* base, const char* path, g_fs_transaction_handler_discovery* handler, bool follow_symlinks = true);
 
 	/**
 	 * Retrieves the length for the given node, notifying the handler once finished.
@@ -101,14 +111,38 @@ public:
 	static bool get_length(g_thread* task, g_fs_node* node, g_fs_transaction_handler_get_length* handler);
 
 	/**
-	 * Tries to resolve the node with the given absolute path. The buffer behind
-	 * "name_current" is filled with the name of the last found node (must be of at
-	 * least G_PATH_MAX bytes size).
+	 * Tries to resolve the node with the given path. An absolute path is resolved
+	 * from the root, a relative path from the base node. The path is walked in place,
+	 * "name_current" is set to the element of the path that was looked up last.
 	 *
 	 * - If the node is found, parent and child are set
 	 * - If the node is NOT found, parent is set, the child is set to 0
 	 */
-	static void find_existing(char* absolute_path, g_fs_node** out_parent, g_fs_node** out_child, char* name_current, bool follow_symlinks = true);
+	static void find_existing(g_fs_node* base, const char* path, g_fs_node** out_parent, g_fs_node** out_child, g_fs_path_slice* name_current,
+			bool follow_symlinks = true, const char** out_remaining = 0);
+
+	/**
+	 * Returns the node that the given path of the process is relative to. This is the
+	 * root for absolute paths and the working directory of the process otherwise.
+	 * Relative paths are walked from the working directory node, they are never
+	 * joined with the working directory path first.
+	 */
+	static g_fs_node* get_path_base(g_process* process, const char* path);
+
+	/**
+	 * Creates a file or folder at the given path. The parent folder must
+	 * already be discovered and its delegate must support creating nodes.
+	 *
+	 * @param base
+	 * 		the node that a relative path starts from
+	 * @param path
+	 * 		path of the node to create
+	 * @param type
+	 * 		either {G_FS_NODE_TYPE_FILE} or {G_FS_NODE_TYPE_FOLDER}
+	 *
+	 * @return the created node, or 0 if not successful
+	 */
+	static g_fs_node* create(g_fs_node* base, const char* path, g_fs_node_type type);
 
 	/**
 	 * Resolves the real path to the given node and writes it to the out buffer.
@@ -145,30 +179,14 @@ public:
 	static g_fs_register_as_delegate_status create_delegate(g_thread* thread, char* name, g_fs_phys_id phys_mountpoint_id, g_fs_virt_id* out_mountpoint_id,
 			g_address* out_transaction_storage);
 
-	static bool node_for_descriptor(g_pid pid, g_fd fd, g_fs_node** out_node, g_file_descriptor_content** out_fd);
-
-	/**
-	 * If the in path is absolute (starts with a '/') it is simply copied to the out buffer.
-	 * If the in path is a relative path, it is appended to the working directory (adding
-	 * a '/' in between) and written to the out buffer.
-	 *
-	 * @param relative_base
-	 * 		the relative base to append on relative paths
-	 *
-	 * @param in
-	 * 		the absolute or relative path
-	 *
-	 * @param out
-	 * 		the output buffer of at least {G_PATH_MAX} bytes size
-	 */
-	static void concat_as_absolute_path(char* relative_base, char* in, char* out);
+	static bool node_for_descriptor(g_process* process, g_fd fd, g_fs_node** out_node, g_file_descriptor_content** out_fd);
 
 	/**
 	 * Opens a file, creating a file descriptor for the given node within
 	 * the given process.
 	 *
-	 * @param pid
-	 * 		id of the process
+	 * @param process
+	 * 		the process
 	 *
 	 * @param node
 	 * 		the node to open
@@ -181,7 +199,7 @@ public:
 	 *
 	 * @return a file descriptor
 	 */
-	static g_fd open(g_pid pid, g_fs_node* node, int32_t flags, g_fd fd = -1);
+	static g_fd open(g_process* process, g_fs_node* node, int32_t flags, g_fd fd = -1);
 
 	/**
 	 *
@@ -198,7 +216,13 @@ public:
 	/**
 	 *
 	 */
-	static bool close(g_pid pid, g_fs_node* node, g_file_descriptor_content* fd, g_fs_close_status* out_status);
+	static bool close(g_process* process, g_fs_node* node, g_file_descriptor_content* fd, g_fs_close_status* out_status);
+
+	/**
+	 * Asks the delegate of the node to pass on all writes that it buffered for the node,
+	 * notifying the handler once finished.
+	 */
+	static g_fs_transaction_handler_start_status flush(g_thread* thread, g_fs_node* node, g_fs_transaction_handler_flush* handler);
 
 	/**
 	 *
@@ -211,19 +235,68 @@ public:
 	static g_fd clonefd(g_thread* thread, g_fd source_fd, g_pid source_pid, g_fd target_fd, g_pid target_pid, g_fs_clonefd_status* out_status);
 
 	/**
-	 *
+	 * Creates a pipe with the given capacity, zero meaning the default capacity,
+	 * and opens both of its ends.
+	 */
+	static g_fs_pipe_status pipe(g_thread* thread, uint32_t capacity, g_fd* out_write, g_fd* out_read);
+
+	/**
+	 * Creates a new event node and opens it for the process of the thread.
+	 */
+	static g_event_create_status create_event(g_thread* thread, g_fd* out_fd);
+
+	/**
+	 * Pins the node of a directory that the process has opened for reading, so that
+	 * it stays in the tree while the process iterates over it.
+	 */
+	static void open_directory(g_process* process, g_fs_node* node);
+
+	/**
+	 * Releases a directory that was opened with {open_directory}. Nodes that the
+	 * process has not opened are ignored.
+	 */
+	static void close_directory(g_process* process, g_fs_virt_id node_id);
+
+	/**
+	 * Lets the delegates that are served by the thread continue work that no
+	 * requester waits for, after the thread has changed a transaction status.
 	 */
-	static g_fs_pipe_status pipe(g_thread* thread, g_fd* out_write, g_fd* out_read);
+	static void transaction_status_changed(g_thread* thread);
 
 	/**
 	 *
 	 */
-	static void process_closed(g_pid pid);
+	static void process_closed(g_process* process);
+
+	/**
+	 * Gives the forked process a copy of each file descriptor of its parent.
+	 */
+	static void process_forked(g_process* parent, g_process* child);
 
-	// TODO
+	/**
+	 * Checks which of the requested events are possible on the node without
+	 * blocking the thread.
+	 *
+	 * @param thread
+	 * 		the polling thread
+	 *
+	 * @param node
+	 * 		the node to check
+	 *
+	 * @param events
+	 * 		the requested {g_poll_events}
+	 *
+	 * @return the events that are possible, {G_POLL_EVENT_ERROR} if the
+	 * 		node can not be polled
+	 */
+	static g_poll_events poll(g_thread* thread, g_fs_node* node, g_poll_events events);
 
-	static int32_t stat(g_thread* thread, char* path, bool follow_symlinks, g_fs_stat_attributes* stat);
-	static int32_t fstat(g_thread* thread, g_fd fd, g_fs_stat_attributes* stat);
+	/**
+	 * Fills the stat attributes of the node through the handler. The length of files
+	 * is taken from the cache or requested from the delegate like in {get_length},
+	 * other nodes have a length of zero.
+	 */
+	static void stat(g_thread* thread, g_fs_node* node, g_fs_transaction_handler_get_length* handler);
 
 };
 
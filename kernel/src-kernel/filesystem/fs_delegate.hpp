@@ -22,6 +22,7 @@
 #define GHOST_FILESYSTEM_FILESYSTEMDELEGATE
 
 #include "ghost/stdint.h"
+#include "ghost/poll.h"
 #include "utils/hash_map.hpp"
 #include "filesystem/fs_transaction_store.hpp"
 #include "filesystem/fs_descriptors.hpp"
@@ -31,6 +32,7 @@
 #include "filesystem/fs_transaction_handler_write.hpp"
 #include "filesystem/fs_transaction_handler_discovery.hpp"
 #include "filesystem/fs_transaction_handler_get_length.hpp"
+#include "filesystem/fs_transaction_handler_flush.hpp"
 #include "memory/contextual.hpp"
 
 /**
@@ -166,6 +168,151 @@ public:
 	 */
 	virtual void finish_read_directory(g_thread* requester, g_fs_transaction_handler_read_directory* handler) = 0;
 
+	/**
+	 * Takes a reference on each physical page that holds the given range of the node,
+	 * so that the pages can be mapped into a process without copying. The range may
+	 * start anywhere within its first page and is cut at the end of the node.
+	 *
+	 * @param node
+	 * 		the node to map
+	 * @param offset
+	 * 		offset within the node
+	 * @param length
+	 * 		number of bytes to map
+	 * @param out_pages
+	 * 		is filled with the physical pages
+	 * @param capacity
+	 * 		number of entries in out_pages, the range is cut so that its pages fit
+	 * @param out_count
+	 * 		is filled with the number of pages
+	 * @param out_displacement
+	 * 		is filled with the position of the first byte within the first page
+	 * @param out_length
+	 * 		is filled with the number of bytes that the pages hold, which is less than
+	 * 		the length if the range exceeds the end of the node
+	 *
+	 * @return {G_FS_MAP_SUCCESSFUL} if the pages were provided, {G_FS_MAP_NOT_RESIDENT}
+	 * 		if the contents must be read first, otherwise the error status
+	 */
+	virtual g_fs_map_status acquire_pages(g_fs_node* node, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+			uint32_t* out_count, uint32_t* out_displacement, int64_t* out_length) {
+		return G_FS_MAP_NOT_SUPPORTED;
+	}
+
+	/**
+	 * Creates a new file or folder within the given folder node. This is done
+	 * immediately; delegates that can't create nodes return 0.
+	 *
+	 * @param parent
+	 * 		the folder to create the node in
+	 * @param name
+	 * 		name of the new node
+	 * @param type
+	 * 		either {G_FS_NODE_TYPE_FILE} or {G_FS_NODE_TYPE_FOLDER}
+	 *
+	 * @return the created node, or 0 if not successful
+	 */
+	virtual g_fs_node* create_child(g_fs_node* parent, char* name, g_fs_node_type type) {
+		return 0;
+	}
+
+	/**
+	 * Sets the length of a file node. This is done immediately; delegates that
+	 * can't change the length return false.
+	 *
+	 * @return whether the length was set
+	 */
+	virtual bool truncate(g_fs_node* node, int64_t length) {
+		return false;
+	}
+
+	/**
+	 * Passes writes that the delegate buffers for the node on to where they belong and
+	 * sets the status on the handler. Delegates that don't buffer writes finish the
+	 * transaction right away.
+	 *
+	 * @param requester
+	 * 		the thread requesting the flush
+	 * @param node
+	 * 		the node to flush
+	 * @param handler
+	 * 		the finish handler
+	 *
+	 * @return the transaction id
+	 */
+	virtual g_fs_transaction_id request_flush(g_thread* requester, g_fs_node* node, g_fs_transaction_handler_flush* handler) {
+
+		g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+		handler->status = G_FS_FLUSH_SUCCESSFUL;
+		g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+		return id;
+	}
+
+	/**
+	 * Sets whether writes may be buffered before they are passed to the delegate.
+	 * Delegates that don't buffer writes ignore this.
+	 */
+	virtual void set_write_mode(g_fs_write_mode mode) {
+	}
+
+	/**
+	 * Starts passing on the writes that the delegate buffers for the node, without a
+	 * requester that waits for them. Used when a process exits while it has the node open.
+	 */
+	virtual void flush_detached(g_fs_node* node) {
+	}
+
+	/**
+	 * Called after the serving thread has changed the status of a transaction, so the
+	 * delegate can continue work that no requester waits for.
+	 */
+	virtual void transaction_status_changed() {
+	}
+
+	/**
+	 * Checks which of the requested events could currently be performed on the
+	 * node without blocking the requester. Delegates whose operations never block
+	 * the caller report all requested events.
+	 *
+	 * @param requester
+	 * 		the thread that polls
+	 * @param node
+	 * 		the node to check
+	 * @param events
+	 * 		the requested events
+	 *
+	 * @return the events that are possible
+	 */
+	virtual g_poll_events poll(g_thread* requester, g_fs_node* node, g_poll_events events) {
+		return events & (G_POLL_EVENT_READABLE | G_POLL_EVENT_WRITABLE);
+	}
+
+	/**
+	 * Returns the id of the thread that performs the transactions of this
+	 * delegate, or {G_TID_NONE} if they are performed within the kernel. Requesters
+	 * that wait for a transaction lend their time slices to this thread.
+	 */
+	virtual g_tid get_serving_thread() {
+		return G_TID_NONE;
+	}
+
+	/**
+	 * Returns how long the kernel may use attributes (like the length) of the nodes
+	 * of this delegate without asking it again. By default, nothing is cached.
+	 */
+	virtual g_fs_attributes_ttl get_attributes_ttl() {
+		return G_FS_ATTRIBUTES_TTL_NONE;
+	}
+
+	/**
+	 * Returns whether unused nodes of this delegate may be removed from the tree. This
+	 * is only possible if the delegate can discover them again at any time. By default,
+	 * nodes are kept.
+	 */
+	virtual bool can_evict_nodes() {
+		return false;
+	}
+
 };
 
 #endif
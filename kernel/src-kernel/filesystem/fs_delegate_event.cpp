@@ -0,0 +1,185 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_delegate_event.hpp"
+#include "filesystem/filesystem.hpp"
+#include "filesystem/events.hpp"
+#include "utils/string.hpp"
+#include "logger/logger.hpp"
+#include "kernel.hpp"
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_event::request_discovery(g_thread* requester, g_fs_node* parent, char* child, g_fs_transaction_handler_discovery* handler) {
+
+	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+	handler->status = G_FS_DISCOVERY_ERROR;
+	g_log_info("discovery is not supported on events");
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+	return id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_event::finish_discovery(g_thread* requester, g_fs_transaction_handler_discovery* handler) {
+	// nothing to do here
+}
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_event::request_read(g_thread* requester, g_fs_node* node, int64_t length, g_contextual<uint8_t*> buffer,
+		g_file_descriptor_content* fd, g_fs_transaction_handler_read* handler) {
+
+	// start/repeat transaction
+	g_fs_transaction_id id;
+	if (handler->wants_repeat_transaction()) {
+		id = handler->get_repeated_transaction();
+	} else {
+		id = g_fs_transaction_store::next_transaction();
+	}
+
+	g_event* event = g_events::get(node->phys_fs_id);
+	if (event && length >= (int64_t) sizeof(uint64_t)) {
+		uint64_t value = g_events::take(event);
+
+		if (value > 0) {
+			g_memory::copy(buffer(), &value, sizeof(uint64_t));
+			handler->result = sizeof(uint64_t);
+			handler->status = G_FS_READ_SUCCESSFUL;
+			g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+		} else if (node->is_blocking) {
+			g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_REPEAT);
+		} else {
+			handler->result = 0;
+			handler->status = G_FS_READ_SUCCESSFUL;
+			g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+		}
+	} else {
+		handler->result = -1;
+		handler->status = G_FS_READ_ERROR;
+		g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+	}
+
+	return id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_event::finish_read(g_thread* requester, g_fs_read_status* out_status, int64_t* out_result, g_file_descriptor_content* fd) {
+}
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_event::request_write(g_thread* requester, g_fs_node* node, int64_t length, g_contextual<uint8_t*> buffer,
+		g_file_descriptor_content* fd, g_fs_transaction_handler_write* handler) {
+
+	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+
+	g_event* event = g_events::get(node->phys_fs_id);
+	if (event && length >= (int64_t) sizeof(uint64_t)) {
+		uint64_t value;
+		g_memory::copy(&value, buffer(), sizeof(uint64_t));
+		g_events::signal(event, value);
+
+		handler->result = sizeof(uint64_t);
+		handler->status = G_FS_WRITE_SUCCESSFUL;
+	} else {
+		handler->result = -1;
+		handler->status = G_FS_WRITE_ERROR;
+	}
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+
+	return id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_event::finish_write(g_thread* requester, g_fs_write_status* out_status, int64_t* out_result, g_file_descriptor_content* fd) {
+}
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_event::request_get_length(g_thread* requester, g_fs_node* node, g_fs_transaction_handler_get_length* handler) {
+
+	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+
+	g_event* event = g_events::get(node->phys_fs_id);
+	if (event) {
+		handler->length = sizeof(uint64_t);
+		handler->status = G_FS_LENGTH_SUCCESSFUL;
+	} else {
+		handler->length = -1;
+		handler->status = G_FS_LENGTH_ERROR;
+	}
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+
+	return id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_event::finish_get_length(g_thread* requester, g_fs_transaction_handler_get_length* handler) {
+}
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_event::request_read_directory(g_thread* requester, g_fs_node* node, int position,
+		g_fs_transaction_handler_read_directory* handler) {
+
+	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+	handler->status = G_FS_READ_DIRECTORY_NOT_SUPPORTED;
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+	return id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_event::finish_read_directory(g_thread* requester, g_fs_transaction_handler_read_directory* handler) {
+}
+
+/**
+ *
+ */
+g_poll_events g_fs_delegate_event::poll(g_thread* requester, g_fs_node* node, g_poll_events events) {
+
+	g_event* event = g_events::get(node->phys_fs_id);
+	if (event == 0) {
+		return G_POLL_EVENT_ERROR;
+	}
+
+	g_poll_events result = G_POLL_EVENT_NONE;
+	if ((events & G_POLL_EVENT_READABLE) && (g_events::is_signaled(event) || !node->is_blocking)) {
+		result |= G_POLL_EVENT_READABLE;
+	}
+	if (events & G_POLL_EVENT_WRITABLE) {
+		result |= G_POLL_EVENT_WRITABLE;
+	}
+	return result;
+}
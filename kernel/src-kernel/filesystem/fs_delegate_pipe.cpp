@@ -59,22 +59,12 @@ g_fs_transaction_id g_fs_delegate_pipe::request_read(g_thread* requester, g_fs_n
 
 	g_pipe* pipe = g_pipes::get(node->phys_fs_id);
 	if (pipe) {
-		length = (pipe->size > length) ? length : pipe->size;
-
-		uint32_t endspc = ((uint32_t) pipe->buffer + pipe->capacity) - (uint32_t) pipe->read;
-
-		if (length > endspc) {
-			uint32_t remain = length - endspc;
-			g_memory::copy(buffer(), pipe->read, endspc);
-			g_memory::copy(&buffer()[endspc], pipe->buffer, remain);
-			pipe->read = (uint8_t*) ((uint32_t) pipe->buffer + remain);
-		} else {
-			g_memory::copy(buffer(), pipe->read, length);
-			pipe->read = (uint8_t*) ((uint32_t) pipe->read + length);
+		if (length > pipe->capacity) {
+			length = pipe->capacity;
 		}
+		length = g_pipes::read(pipe, buffer(), length);
 
 		if (length > 0) {
-			pipe->size -= length;
 			handler->result = length;
 			handler->status = G_FS_READ_SUCCESSFUL;
 			g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
@@ -86,6 +76,8 @@ g_fs_transaction_id g_fs_delegate_pipe::request_read(g_thread* requester, g_fs_n
 					handler->status = G_FS_READ_ERROR;
 					g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
 				} else {
+					// sleep until a writer wakes us
+					handler->repeat_on_wake(&pipe->readers);
 					g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_REPEAT);
 				}
 			} else {
@@ -125,24 +117,12 @@ g_fs_transaction_id g_fs_delegate_pipe::request_write(g_thread* requester, g_fs_
 
 	g_pipe* pipe = g_pipes::get(node->phys_fs_id);
 	if (pipe) {
-		int space = (pipe->capacity - pipe->size);
-
-		if (space > 0) {
-			length = (space > length) ? length : space;
-
-			uint32_t endspc = ((uint32_t) pipe->buffer + pipe->capacity) - (uint32_t) pipe->write;
-
-			if (length > endspc) {
-				uint32_t remain = length - endspc;
-				g_memory::copy(pipe->write, buffer(), endspc);
-				g_memory::copy(pipe->buffer, &buffer()[endspc], remain);
-				pipe->write = (uint8_t*) ((uint32_t) pipe->buffer + remain);
-			} else {
-				g_memory::copy(pipe->write, buffer(), length);
-				pipe->write = (uint8_t*) ((uint32_t) pipe->write + length);
-			}
+		if (length > pipe->capacity) {
+			length = pipe->capacity;
+		}
+		length = g_pipes::write(pipe, buffer(), length);
 
-			pipe->size += length;
+		if (length > 0) {
 			handler->result = length;
 			handler->status = G_FS_WRITE_SUCCESSFUL;
 			g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
@@ -154,6 +134,8 @@ g_fs_transaction_id g_fs_delegate_pipe::request_write(g_thread* requester, g_fs_
 					handler->status = G_FS_WRITE_ERROR;
 					g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
 				} else {
+					// sleep until a reader wakes us
+					handler->repeat_on_wake(&pipe->writers);
 					g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_REPEAT);
 				}
 			} else {
@@ -220,3 +202,28 @@ g_fs_transaction_id g_fs_delegate_pipe::request_read_directory(g_thread* request
  */
 void g_fs_delegate_pipe::finish_read_directory(g_thread* requester, g_fs_transaction_handler_read_directory* handler) {
 }
+
+/**
+ *
+ */
+g_poll_events g_fs_delegate_pipe::poll(g_thread* requester, g_fs_node* node, g_poll_events events) {
+
+	g_pipe* pipe = g_pipes::get(node->phys_fs_id);
+	if (pipe == 0) {
+		return G_POLL_EVENT_ERROR;
+	}
+
+	// if no one else has access, operations fail immediately instead of blocking
+	if (!g_pipes::has_reference_from_other_process(pipe, requester->process->main->id)) {
+		return events | G_POLL_EVENT_ERROR;
+	}
+
+	g_poll_events result = G_POLL_EVENT_NONE;
+	if ((events & G_POLL_EVENT_READABLE) && (pipe->size > 0 || !node->is_blocking)) {
+		result |= G_POLL_EVENT_READABLE;
+	}
+	if ((events & G_POLL_EVENT_WRITABLE) && (pipe->size < pipe->capacity || !node->is_blocking)) {
+		result |= G_POLL_EVENT_WRITABLE;
+	}
+	return result;
+}
@@ -89,6 +89,11 @@ public:
 	 */
 	virtual void finish_read_directory(g_thread* requester, g_fs_transaction_handler_read_directory* handler);
 
+	/**
+	 *
+	 */
+	virtual g_poll_events poll(g_thread* requester, g_fs_node* node, g_poll_events events);
+
 };
 
 #endif
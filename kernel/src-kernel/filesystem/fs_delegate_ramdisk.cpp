@@ -23,7 +23,8 @@
 #include "utils/string.hpp"
 #include "logger/logger.hpp"
 #include "kernel.hpp"
-#include "ghost/utils/local.hpp"
+#include "memory/address_space.hpp"
+#include "memory/physical/pp_reference_tracker.hpp"
 
 /**
  *
@@ -35,6 +36,8 @@ g_fs_node* g_fs_delegate_ramdisk::create_vfs_node(g_ramdisk_entry* ramdisk_node,
 
 	if (ramdisk_node->type == G_RAMDISK_ENTRY_TYPE_FILE) {
 		node->type = G_FS_NODE_TYPE_FILE;
+		node->length = ramdisk_node->datalength;
+		node->attributes_expiry = G_FS_ATTRIBUTES_EXPIRY_NEVER;
 	} else {
 		node->type = G_FS_NODE_TYPE_FOLDER;
 	}
@@ -110,6 +113,10 @@ g_fs_transaction_id g_fs_delegate_ramdisk::request_read(g_thread* requester, g_f
 	if (ramdisk_node == 0) {
 		handler->status = G_FS_READ_INVALID_FD;
 
+	} else if (ramdisk_node->datalength > 0 && g_kernel_ramdisk->getData(ramdisk_node) == 0) {
+		handler->status = G_FS_READ_ERROR;
+		g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+
 	} else {
 		int64_t copy_amount = ((fd->offset + length) >= ramdisk_node->datalength) ? (ramdisk_node->datalength - fd->offset) : length;
 		if (copy_amount > 0) {
@@ -197,36 +204,23 @@ g_fs_transaction_id g_fs_delegate_ramdisk::request_read_directory(g_thread* requ
 		handler->status = G_FS_READ_DIRECTORY_ERROR;
 
 	} else {
-		g_ramdisk_entry* rd_child = g_kernel_ramdisk->getChildAt(fs_parent->phys_fs_id, position);
-		if (rd_child) {
-			// get real path to parent
-			g_local<char> absolute(new char[G_PATH_MAX]);
-			g_filesystem::get_real_path_to_node(fs_parent, absolute());
-
-			// append child name
-			int abs_cur_len = g_string::length((const char*) absolute());
-			int childlen = g_string::length(rd_child->name);
-			g_memory::copy(&absolute()[abs_cur_len], "/", 1);
-			g_memory::copy(&absolute()[abs_cur_len + 1], rd_child->name, childlen);
-			absolute()[abs_cur_len + 1 + childlen] = 0;
-
-			// check if file exists as vfs node
-			g_fs_node* fs_childs_parent = 0;
-			g_fs_node* fs_child = 0;
-			g_local<char> current(new char[G_PATH_MAX]);
-			g_filesystem::find_existing(absolute(), &fs_childs_parent, &fs_child, current(), true);
-
-			// if not, create it
+		// add children from the position on as long as the handler takes them
+		uint32_t index = position;
+		while (index < rd_parent->childCount) {
+			g_ramdisk_entry* rd_child = rd_parent->children[index];
+
+			// look for the vfs node below the parent, create it if it doesn't exist
+			g_fs_node* fs_child = fs_parent->find_child(rd_child->name);
 			if (fs_child == 0) {
 				fs_child = create_vfs_node(rd_child, fs_parent);
 			}
 
-			// copy name to output
-			handler->child = fs_child;
-			handler->status = G_FS_READ_DIRECTORY_SUCCESSFUL;
-		} else {
-			handler->status = G_FS_READ_DIRECTORY_EOD;
+			if (!handler->add_child(fs_child)) {
+				break;
+			}
+			++index;
 		}
+		handler->finish_children(index >= rd_parent->childCount);
 	}
 
 	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
@@ -238,3 +232,49 @@ g_fs_transaction_id g_fs_delegate_ramdisk::request_read_directory(g_thread* requ
  */
 void g_fs_delegate_ramdisk::finish_read_directory(g_thread* requester, g_fs_transaction_handler_read_directory* handler) {
 }
+
+/**
+ * Ramdisk contents are mapped directly from the ramdisk module, or from the pages
+ * that a compressed file was decompressed to. In legacy images, files are not
+ * page-aligned, so the first and last page may contain bytes of other entries;
+ * the ramdisk is readable for everyone anyway.
+ */
+g_fs_map_status g_fs_delegate_ramdisk::acquire_pages(g_fs_node* node, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+		uint32_t* out_count, uint32_t* out_displacement, int64_t* out_length) {
+
+	g_ramdisk_entry* ramdisk_node = g_kernel_ramdisk->findById(node->phys_fs_id);
+	if (ramdisk_node == 0 || ramdisk_node->type != G_RAMDISK_ENTRY_TYPE_FILE) {
+		return G_FS_MAP_NOT_SUPPORTED;
+	}
+
+	if (offset < 0 || length <= 0 || offset >= ramdisk_node->datalength) {
+		return G_FS_MAP_INVALID_RANGE;
+	}
+	if (offset + length > ramdisk_node->datalength) {
+		length = ramdisk_node->datalength - offset;
+	}
+
+	uint8_t* data = g_kernel_ramdisk->getData(ramdisk_node);
+	if (data == 0) {
+		return G_FS_MAP_ERROR;
+	}
+
+	g_virtual_address start = (g_virtual_address) data + offset;
+	g_virtual_address first = PAGE_ALIGN_DOWN(start);
+	if (length > (int64_t) capacity * G_PAGE_SIZE - (start - first)) {
+		length = (int64_t) capacity * G_PAGE_SIZE - (start - first);
+	}
+	g_virtual_address end = PAGE_ALIGN_UP(start + length);
+
+	uint32_t count = 0;
+	for (g_virtual_address virt = first; virt < end; virt += G_PAGE_SIZE) {
+		g_physical_address physical = g_address_space::virtual_to_physical(virt);
+		g_pp_reference_tracker::increment(physical);
+		out_pages[count++] = physical;
+	}
+
+	*out_count = count;
+	*out_displacement = start - first;
+	*out_length = length;
+	return G_FS_MAP_SUCCESSFUL;
+}
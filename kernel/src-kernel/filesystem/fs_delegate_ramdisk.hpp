@@ -85,6 +85,20 @@ public:
 	 */
 	virtual void finish_get_length(g_thread* requester, g_fs_transaction_handler_get_length* handler);
 
+	/**
+	 * The ramdisk only changes through the kernel.
+	 */
+	virtual g_fs_attributes_ttl get_attributes_ttl() {
+		return G_FS_ATTRIBUTES_TTL_AUTHORITATIVE;
+	}
+
+	/**
+	 * Nodes are created from the entries of the ramdisk whenever they are discovered.
+	 */
+	virtual bool can_evict_nodes() {
+		return true;
+	}
+
 	/**
 	 *
 	 */
@@ -95,6 +109,12 @@ public:
 	 */
 	virtual void finish_read_directory(g_thread* requester, g_fs_transaction_handler_read_directory* handler);
 
+	/**
+	 *
+	 */
+	virtual g_fs_map_status acquire_pages(g_fs_node* node, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+			uint32_t* out_count, uint32_t* out_displacement, int64_t* out_length);
+
 };
 
 #endif
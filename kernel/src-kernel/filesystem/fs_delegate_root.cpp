@@ -131,25 +131,17 @@ g_fs_transaction_id g_fs_delegate_root::request_read_directory(g_thread* request
 
 	// find child at position
 	auto entry = fs_parent->children;
-	g_fs_node* fs_child = 0;
 	int index = 0;
-	while (entry) {
-		if (index == position) {
-			fs_child = entry->value;
-			break;
-		}
+	while (entry && index < position) {
 		++index;
 		entry = entry->next;
 	}
 
-	// if exists, successful, otherwise failed
-	if (fs_child) {
-		// copy name to output
-		handler->child = fs_child;
-		handler->status = G_FS_READ_DIRECTORY_SUCCESSFUL;
-	} else {
-		handler->status = G_FS_READ_DIRECTORY_EOD;
+	// add children from there on as long as the handler takes them
+	while (entry && handler->add_child(entry->value)) {
+		entry = entry->next;
 	}
+	handler->finish_children(entry == 0);
 
 	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
 	return id;
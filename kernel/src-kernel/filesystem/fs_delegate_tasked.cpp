@@ -20,20 +20,26 @@
 
 #include "filesystem/fs_delegate_tasked.hpp"
 #include "filesystem/filesystem.hpp"
+#include "filesystem/fs_page_cache.hpp"
+#include "filesystem/fs_write_buffer.hpp"
 #include "utils/string.hpp"
 #include "logger/logger.hpp"
 #include "kernel.hpp"
 #include "tasking/communication/message_controller.hpp"
 #include "memory/address_space.hpp"
 #include "memory/physical/pp_allocator.hpp"
-#include "ghost/utils/local.hpp"
+#include "memory/constants.hpp"
 
 /**
  *
  */
 g_fs_delegate_tasked::g_fs_delegate_tasked(g_thread* delegate_thread) :
-		transaction_storage_phys(0), delegate_thread(delegate_thread) {
+		transaction_storage(0), transaction_storage_phys(0), delegate_thread(delegate_thread), window_start(0), window_mapped_pages(0), pending_buffer(0),
+		pending_length(0), busy(false), busy_requester(0), write_mode(G_FS_WRITE_MODE_BACK), write_buffers(0), flushing(0), flush_transaction(0) {
 
+	for (int i = 0; i < G_FS_TASKED_DELEGATE_WINDOW_TABLES; i++) {
+		window_tables[i] = 0;
+	}
 }
 
 /**
@@ -53,6 +59,22 @@ bool g_fs_delegate_tasked::prepare(g_virtual_address* out_transaction_storage) {
 		return false;
 	}
 
+	window_start = delegate_thread->process->virtualRanges.allocate(G_FS_TASKED_DELEGATE_WINDOW_PAGES);
+	if (window_start == 0) {
+		g_log_warn("%! failed to allocate virtual range for request window when trying to create tasked delegate", "filesystem");
+		return false;
+	}
+
+	g_virtual_address transaction_storage_kernel = g_kernel_virt_addr_ranges->allocate(1);
+	g_virtual_address window_tables_kernel = g_kernel_virt_addr_ranges->allocate(G_FS_TASKED_DELEGATE_WINDOW_TABLES);
+	if (transaction_storage_kernel == 0 || window_tables_kernel == 0) {
+		g_log_warn("%! failed to allocate kernel virtual ranges when trying to create tasked delegate", "filesystem");
+		return false;
+	}
+	g_physical_address window_tables_phys[G_FS_TASKED_DELEGATE_WINDOW_TABLES];
+	uint32_t first_table = TABLE_IN_DIRECTORY_INDEX(window_start);
+	uint32_t last_table = TABLE_IN_DIRECTORY_INDEX(window_start + (G_FS_TASKED_DELEGATE_WINDOW_PAGES - 1) * G_PAGE_SIZE);
+
 	/**
 	 * For safety, were switching to the page directory of the process
 	 * that is registered as a delegate and then map the transaction storage.
@@ -64,30 +86,100 @@ bool g_fs_delegate_tasked::prepare(g_virtual_address* out_transaction_storage) {
 	g_page_directory current = g_address_space::get_current_space();
 	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
 	g_address_space::map(transaction_storage_address, transaction_storage_phys, DEFAULT_USER_TABLE_FLAGS, DEFAULT_USER_PAGE_FLAGS);
+
+	// create the tables that contain the window by temporarily mapping a page to it
+	g_page_directory directory = (g_page_directory) G_CONST_RECURSIVE_PAGE_DIRECTORY_ADDRESS;
+	for (uint32_t ti = first_table; ti <= last_table; ti++) {
+		g_virtual_address page = (ti == first_table) ? window_start : ti * 1024 * G_PAGE_SIZE;
+		g_address_space::map(page, transaction_storage_phys, DEFAULT_USER_TABLE_FLAGS, DEFAULT_USER_PAGE_FLAGS);
+		g_address_space::unmap(page);
+		window_tables_phys[ti - first_table] = directory[ti] & ~G_PAGE_ALIGN_MASK;
+	}
 	g_address_space::switch_to_space(current);
 	g_log_debug("%! fs delegate transaction storage created at %h of process %i", "filesystem", transaction_storage_address, delegate_thread->id);
 
+	// make the storage and the window tables accessible from the kernel space
+	g_address_space::map(transaction_storage_kernel, transaction_storage_phys, DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+	transaction_storage = (void*) transaction_storage_kernel;
+
+	for (uint32_t ti = first_table; ti <= last_table; ti++) {
+		g_virtual_address table_virt = window_tables_kernel + (ti - first_table) * G_PAGE_SIZE;
+		g_address_space::map(table_virt, window_tables_phys[ti - first_table], DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+		window_tables[ti - first_table] = (g_page_table) table_virt;
+	}
+
 	*out_transaction_storage = transaction_storage_address;
-	transaction_storage.set((void*) transaction_storage_address, delegate_thread->process->pageDirectory);
 	return true;
 }
 
 /**
  *
  */
-g_fs_transaction_id g_fs_delegate_tasked::request_discovery(g_thread* requester, g_fs_node* parent, char* child, g_fs_transaction_handler_discovery* handler) {
+void g_fs_delegate_tasked::set_window_entry(int index, uint32_t entry) {
 
-	// begin the transaction
-	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+	g_virtual_address virt = window_start + index * G_PAGE_SIZE;
+	g_page_table table = window_tables[TABLE_IN_DIRECTORY_INDEX(virt) - TABLE_IN_DIRECTORY_INDEX(window_start)];
+	table[PAGE_IN_TABLE_INDEX(virt)] = entry;
 
 	/**
-	 * Switch to the delegates space and fill the transaction storage.
+	 * Other spaces have no entries of the window in the TLB once the delegate
+	 * runs again, because it is scheduled in with a reload of its directory.
 	 */
+	if (g_address_space::get_current_space() == delegate_thread->process->pageDirectory) {
+		G_INVLPG(virt);
+	}
+}
+
+/**
+ *
+ */
+g_virtual_address g_fs_delegate_tasked::map_window(g_virtual_address buffer, int pages) {
+
+	unmap_window();
+
+	g_virtual_address virt_start = PAGE_ALIGN_DOWN(buffer);
+	for (int i = 0; i < pages; i++) {
+		set_window_entry(i, g_address_space::virtual_to_physical(virt_start + i * G_PAGE_SIZE) | DEFAULT_USER_PAGE_FLAGS);
+	}
+	window_mapped_pages = pages;
+
+	return window_start + (buffer & G_PAGE_ALIGN_MASK);
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tasked::unmap_window() {
+
+	for (int i = 0; i < window_mapped_pages; i++) {
+		set_window_entry(i, 0);
+	}
+	window_mapped_pages = 0;
+}
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_tasked::request_discovery(g_thread* requester, g_fs_node* parent, char* child, g_fs_transaction_handler_discovery* handler) {
+
+	// begin/repeat the transaction
+	g_fs_transaction_id id;
+	if (handler->wants_repeat_transaction()) {
+		id = handler->get_repeated_transaction();
+	} else {
+		id = g_fs_transaction_store::next_transaction();
+	}
+
+	// the storage is in use until a flush or another request is finished
+	if (await_idle(id, handler)) {
+		return id;
+	}
+	occupy(requester);
+
+	// fill the transaction storage
 	bool configuration_fine = true;
-	g_page_directory current = g_address_space::get_current_space();
-	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
 
-	g_fs_tasked_delegate_transaction_storage_discovery* disc = (g_fs_tasked_delegate_transaction_storage_discovery*) transaction_storage();
+	g_fs_tasked_delegate_transaction_storage_discovery* disc = (g_fs_tasked_delegate_transaction_storage_discovery*) transaction_storage;
 	int childlen = g_string::length(child);
 	if (childlen > G_FILENAME_MAX) {
 		g_log_info("tried to discover a node that has a name with an illegal length");
@@ -96,10 +188,9 @@ g_fs_transaction_id g_fs_delegate_tasked::request_discovery(g_thread* requester,
 		g_memory::copy(disc->name, child, childlen + 1);
 
 		disc->parent_phys_fs_id = parent->phys_fs_id;
+		copy_remaining_path(disc->remaining, handler->remaining_path);
 	}
 
-	g_address_space::switch_to_space(current);
-
 	// update the status / notify delegate thread
 	if (configuration_fine == false) {
 		handler->status = G_FS_DISCOVERY_ERROR;
@@ -131,23 +222,282 @@ g_fs_transaction_id g_fs_delegate_tasked::request_discovery(g_thread* requester,
 	return id;
 }
 
+/**
+ * The remaining path is only passed if the delegate can walk it as it is,
+ * otherwise the elements are discovered one by one.
+ */
+void g_fs_delegate_tasked::copy_remaining_path(char* out, const char* remaining) {
+
+	out[0] = 0;
+	if (remaining == 0) {
+		return;
+	}
+
+	int length = g_string::length(remaining);
+	if (length >= G_FS_DISCOVERY_REMAINING_MAX) {
+		return;
+	}
+
+	// relative elements must be resolved by the kernel
+	const char* element = remaining;
+	while (*element) {
+		int element_length = 0;
+		while (element[element_length] != 0 && element[element_length] != '/') {
+			++element_length;
+		}
+		if ((element_length == 1 && element[0] == '.') || (element_length == 2 && element[0] == '.' && element[1] == '.')) {
+			return;
+		}
+		element += element_length;
+		while (*element == '/') {
+			++element;
+		}
+	}
+
+	g_memory::copy(out, remaining, length + 1);
+}
+
 /**
  *
  */
-void g_fs_delegate_tasked::finish_discovery(g_thread* requester, g_fs_transaction_handler_discovery* handler) {
+g_fs_write_buffer* g_fs_delegate_tasked::find_write_buffer(g_fs_virt_id node_id) {
 
-	// save current directory
-	g_page_directory current = g_address_space::get_current_space();
+	g_fs_write_buffer* buffer = write_buffers;
+	while (buffer) {
+		if (buffer->node_id == node_id) {
+			return buffer;
+		}
+		buffer = buffer->next;
+	}
+	return 0;
+}
 
-	// First get status from transaction storage
-	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
-	g_fs_tasked_delegate_transaction_storage_discovery* dspace = (g_fs_tasked_delegate_transaction_storage_discovery*) transaction_storage();
-	g_fs_discovery_status status = dspace->result_status;
+/**
+ * There is no thread that flushes buffers in the background, so buffers that are
+ * due are flushed before the next request to the delegate is made or once the
+ * storage becomes free.
+ */
+g_fs_write_buffer* g_fs_delegate_tasked::find_due_write_buffer() {
 
-	// Now switch to the requesters space and copy status there
-	g_address_space::switch_to_space(requester->process->pageDirectory);
-	handler->status = status;
-	g_address_space::switch_to_space(current);
+	bool memory_low = g_fs_write_buffers::memory_low();
+	uint64_t now = g_tasking::getCurrentScheduler()->getMilliseconds();
+
+	g_fs_write_buffer* buffer = write_buffers;
+	while (buffer) {
+		if (buffer->length > 0 && (memory_low || buffer->detached || now - buffer->dirty_since >= G_FS_WRITE_BUFFER_MAXIMUM_AGE)) {
+			return buffer;
+		}
+		buffer = buffer->next;
+	}
+	return 0;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tasked::release_write_buffer(g_fs_write_buffer* buffer) {
+
+	g_fs_write_buffer** pos = &write_buffers;
+	while (*pos) {
+		if (*pos == buffer) {
+			*pos = buffer->next;
+			break;
+		}
+		pos = &(*pos)->next;
+	}
+	g_fs_write_buffers::release(buffer);
+}
+
+/**
+ * The buffer is mapped in the kernel, so its pages can be put into the window
+ * from within any space.
+ */
+bool g_fs_delegate_tasked::start_flush(g_fs_write_buffer* buffer) {
+
+	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+	int required_pages = (buffer->length + G_PAGE_SIZE - 1) / G_PAGE_SIZE;
+
+	g_fs_tasked_delegate_transaction_storage_write* disc = (g_fs_tasked_delegate_transaction_storage_write*) transaction_storage;
+	disc->offset = buffer->offset;
+	disc->length = buffer->length;
+	disc->phys_fs_id = buffer->phys_fs_id;
+	disc->mapping_start = window_start;
+	disc->mapping_pages = required_pages;
+	disc->mapped_buffer = (void*) map_window((g_virtual_address) buffer->data, required_pages);
+
+	g_message_empty (request);
+	request.type = G_FS_TASKED_DELEGATE_REQUEST_TYPE_WRITE;
+	request.parameterA = id;
+
+	if (g_message_controller::send(delegate_thread->id, &request) != G_MESSAGE_SEND_STATUS_SUCCESSFUL) {
+		g_log_warn("%! failed to send buffered writes of node %i to fs delegate", "filesystem", buffer->node_id);
+		unmap_window();
+		g_fs_transaction_store::remove_transaction(id);
+		return false;
+	}
+
+	flushing = buffer;
+	flush_transaction = id;
+	return true;
+}
+
+/**
+ * After a short write, the rest of the data is moved to the start of the buffer
+ * and flushed with the next request.
+ */
+void g_fs_delegate_tasked::complete_flush() {
+
+	g_fs_tasked_delegate_transaction_storage_write* storage = (g_fs_tasked_delegate_transaction_storage_write*) transaction_storage;
+	int64_t written = storage->result_write;
+	g_fs_write_status status = storage->result_status;
+
+	unmap_window();
+	g_fs_transaction_store::remove_transaction(flush_transaction);
+
+	g_fs_write_buffer* buffer = flushing;
+	flushing = 0;
+
+	if (status == G_FS_WRITE_SUCCESSFUL && written == buffer->length) {
+		g_fs_write_buffers::flushed(buffer->length);
+		release_write_buffer(buffer);
+
+	} else if (status == G_FS_WRITE_SUCCESSFUL && written > 0 && written < buffer->length) {
+		g_fs_write_buffers::flushed(written);
+		g_memory::copy(buffer->data, buffer->data + written, buffer->length - written);
+		buffer->offset += written;
+		buffer->length -= written;
+
+	} else {
+		g_log_warn("%! failed to flush %i buffered bytes of node %i, status %i", "filesystem", buffer->length, buffer->node_id, status);
+
+		// nobody is left to report the error to
+		if (buffer->detached) {
+			release_write_buffer(buffer);
+		} else {
+			buffer->length = 0;
+			buffer->failed = true;
+		}
+	}
+}
+
+/**
+ *
+ */
+bool g_fs_delegate_tasked::await_idle(g_fs_transaction_id id, g_fs_transaction_handler* handler) {
+
+	if (flushing) {
+		if (g_fs_transaction_store::get_status(flush_transaction) != G_FS_TRANSACTION_FINISHED) {
+			g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_REPEAT);
+			handler->repeat_on_wake(g_fs_transaction_store::get_queue(flush_transaction));
+			return true;
+		}
+		complete_flush();
+	}
+
+	if (busy) {
+		// a requester that died before taking its result doesn't block the delegate
+		if (g_tasking::getTaskById(busy_requester) == 0) {
+			unmap_window();
+			pending_buffer = 0;
+			pending_length = 0;
+			release();
+
+		} else {
+			g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_REPEAT);
+			handler->repeat_on_wake(&idle_queue);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tasked::occupy(g_thread* requester) {
+
+	busy = true;
+	busy_requester = requester->id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tasked::release() {
+
+	busy = false;
+	idle_queue.wake_all();
+	progress_flushes();
+}
+
+/**
+ * Buffers of nodes that were left open by an exiting process are marked as due, so
+ * they are flushed as soon as the storage is free.
+ */
+void g_fs_delegate_tasked::progress_flushes() {
+
+	if (flushing) {
+		if (g_fs_transaction_store::get_status(flush_transaction) != G_FS_TRANSACTION_FINISHED) {
+			return;
+		}
+		complete_flush();
+	}
+
+	if (busy) {
+		return;
+	}
+
+	g_fs_write_buffer* due = find_due_write_buffer();
+	if (due) {
+		start_flush(due);
+	}
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tasked::flush_detached(g_fs_node* node) {
+
+	g_fs_write_buffer* buffer = find_write_buffer(node->id);
+	if (buffer == 0 || buffer->length == 0) {
+		return;
+	}
+
+	buffer->detached = true;
+	progress_flushes();
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tasked::transaction_status_changed() {
+
+	progress_flushes();
+}
+
+/**
+ *
+ */
+bool g_fs_delegate_tasked::flush_before(g_fs_write_buffer* buffer, g_fs_transaction_id id, g_fs_transaction_handler* handler) {
+
+	if (!start_flush(buffer)) {
+		return false;
+	}
+
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_REPEAT);
+	handler->repeat_on_wake(g_fs_transaction_store::get_queue(flush_transaction));
+	return true;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tasked::finish_discovery(g_thread* requester, g_fs_transaction_handler_discovery* handler) {
+
+	g_fs_tasked_delegate_transaction_storage_discovery* dspace = (g_fs_tasked_delegate_transaction_storage_discovery*) transaction_storage;
+	handler->status = dspace->result_status;
+	release();
 }
 
 /**
@@ -164,45 +514,122 @@ g_fs_transaction_id g_fs_delegate_tasked::request_read(g_thread* requester, g_fs
 		id = g_fs_transaction_store::next_transaction();
 	}
 
-	// save current directory
-	g_page_directory current = g_address_space::get_current_space();
+	// a repeated transaction decides about reading ahead again
+	if (handler->readahead_buffer) {
+		handler->release_readahead_buffer();
+	}
+	int64_t readahead = handler->wants_repeat_transaction() ? 0 : fd->track_read(length);
+
+	// buffered writes of the node must reach the delegate before it is read
+	if (await_idle(id, handler)) {
+		return id;
+	}
+
+	g_fs_write_buffer* due = find_write_buffer(node->id);
+	if (due == 0 || due->length == 0) {
+		due = find_due_write_buffer();
+	}
+	if (due) {
+		if (!flush_before(due, id, handler)) {
+			occupy(requester);
+			g_fs_tasked_delegate_transaction_storage_read* rspace = (g_fs_tasked_delegate_transaction_storage_read*) transaction_storage;
+			rspace->result_read = -1;
+			rspace->result_status = G_FS_READ_BUSY;
+			g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+		}
+		return id;
+	}
 
 	/**
-	 * First we switch to the requesters space and copy everything that we need below to the stack,
-	 * then get the physical addresses of the area where the requesters buffer is:
+	 * Requests are usually made from within the requesters space, otherwise we switch there.
+	 * If the requested range is cached, it is copied to the requesters buffer and the
+	 * transaction is finished without asking the delegate.
 	 */
-	g_address_space::switch_to_space(requester->process->pageDirectory);
+	g_page_directory current = g_address_space::get_current_space();
+	bool switched = (current != requester->process->pageDirectory);
+	if (switched) {
+		g_address_space::switch_to_space(requester->process->pageDirectory);
+	}
 
-	int required_pages = PAGE_ALIGN_UP(length) / G_PAGE_SIZE + 1;
-	g_local < g_physical_address > phys_pages(new g_physical_address[required_pages]);
-	g_virtual_address virt_start = PAGE_ALIGN_DOWN((g_virtual_address ) buffer());
-	uint32_t offset_in_first_page = ((g_virtual_address) buffer()) & G_PAGE_ALIGN_MASK;
+	int64_t cached_length;
+	if (g_fs_page_cache::read(node->id, fd->offset, length, buffer(), &cached_length)) {
+		if (switched) {
+			g_address_space::switch_to_space(current);
+		}
 
-	for (int i = 0; i < required_pages; i++) {
-		phys_pages()[i] = g_address_space::virtual_to_physical(virt_start + i * G_PAGE_SIZE);
+		fd->offset += cached_length;
+		handler->result = cached_length;
+		handler->status = G_FS_READ_SUCCESSFUL;
+		handler->served_from_cache = true;
+		g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+		return id;
 	}
 
 	/**
-	 * Now we switch into the delegates space, copy the required data to the
-	 * transaction storage and map all physical pages from the requesters space
-	 * to the delegates space.
+	 * Sequential reads are extended by the read-ahead window of the descriptor, so that they end
+	 * on a page boundary. The delegate then reads into zeroed kernel pages instead of the requesters
+	 * buffer; the handler copies the requested part once the transaction is finished and the rest
+	 * remains in the page cache.
 	 */
-	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
+	int64_t request_length = length;
+	g_virtual_address readahead_buffer = 0;
+	int required_pages = 0;
+
+	if (readahead > 0 && g_pp_allocator::getFreePageCount() >= G_FS_PAGE_CACHE_MINIMUM_FREE_PAGES) {
+		int64_t end = fd->offset + length + readahead;
+		end -= end % G_PAGE_SIZE;
+
+		if (end > fd->offset + length) {
+			required_pages = (end - fd->offset + G_PAGE_SIZE - 1) / G_PAGE_SIZE;
+			if (required_pages <= G_FS_TASKED_DELEGATE_WINDOW_PAGES) {
+				readahead_buffer = g_kernel_virt_addr_ranges->allocate(required_pages);
+			}
+			if (readahead_buffer) {
+				request_length = end - fd->offset;
+			}
+		}
+	}
 
-	g_fs_tasked_delegate_transaction_storage_read* disc = (g_fs_tasked_delegate_transaction_storage_read*) transaction_storage();
-	disc->offset = fd->offset;
-	disc->length = length;
-	disc->phys_fs_id = node->phys_fs_id;
+	g_virtual_address target;
+	if (readahead_buffer) {
+		for (int i = 0; i < required_pages; i++) {
+			g_address_space::map(readahead_buffer + i * G_PAGE_SIZE, g_pp_allocator::allocate(), DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+		}
+		g_memory::setBytes((void*) readahead_buffer, 0, required_pages * G_PAGE_SIZE);
 
-	g_virtual_address mapped_virt = delegate_thread->process->virtualRanges.allocate(required_pages);
-	for (int i = 0; i < required_pages; i++) {
-		g_address_space::map(mapped_virt + i * G_PAGE_SIZE, phys_pages()[i], DEFAULT_USER_TABLE_FLAGS, DEFAULT_USER_PAGE_FLAGS);
+		handler->readahead_buffer = readahead_buffer;
+		handler->readahead_pages = required_pages;
+		handler->readahead_requested = length;
+		target = readahead_buffer;
+
+	} else {
+		target = (g_virtual_address) buffer();
+		if ((target & G_PAGE_ALIGN_MASK) + request_length > G_FS_TASKED_DELEGATE_WINDOW_PAGES * G_PAGE_SIZE) {
+			request_length = G_FS_TASKED_DELEGATE_WINDOW_PAGES * G_PAGE_SIZE - (target & G_PAGE_ALIGN_MASK);
+		}
+		required_pages = ((target & G_PAGE_ALIGN_MASK) + request_length + G_PAGE_SIZE - 1) / G_PAGE_SIZE;
 	}
-	disc->mapping_start = mapped_virt;
+
+	/**
+	 * Fill the transaction storage and map the pages of the target buffer to the window
+	 * in the delegates space. Both is done via the kernel mappings, so there is no need
+	 * to switch to the delegates space.
+	 */
+	occupy(requester);
+	g_fs_tasked_delegate_transaction_storage_read* disc = (g_fs_tasked_delegate_transaction_storage_read*) transaction_storage;
+	disc->offset = fd->offset;
+	disc->length = request_length;
+	disc->phys_fs_id = node->phys_fs_id;
+	disc->mapping_start = window_start;
 	disc->mapping_pages = required_pages;
-	disc->mapped_buffer = (void*) (mapped_virt + offset_in_first_page);
+	disc->mapped_buffer = (void*) map_window(target, required_pages);
 
-	g_address_space::switch_to_space(current);
+	pending_buffer = (uint8_t*) target;
+	pending_length = request_length;
+
+	if (switched) {
+		g_address_space::switch_to_space(current);
+	}
 
 	// send message to the task delegate
 	g_message_empty (request);
@@ -234,31 +661,42 @@ g_fs_transaction_id g_fs_delegate_tasked::request_read(g_thread* requester, g_fs
  */
 void g_fs_delegate_tasked::finish_read(g_thread* requester, g_fs_read_status* out_status, int64_t* out_result, g_file_descriptor_content* fd) {
 
-	// save current directory
-	g_page_directory current = g_address_space::get_current_space();
-
-	// Get values from transaction storage and unmap the mapping
-	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
-
-	g_fs_tasked_delegate_transaction_storage_read* rspace = (g_fs_tasked_delegate_transaction_storage_read*) transaction_storage();
+	g_fs_tasked_delegate_transaction_storage_read* rspace = (g_fs_tasked_delegate_transaction_storage_read*) transaction_storage;
 	int64_t length_read = rspace->result_read;
 	g_fs_read_status status = rspace->result_status;
 
-	for (int i = 0; i < rspace->mapping_pages; i++) {
-		g_address_space::unmap(rspace->mapping_start + i * G_PAGE_SIZE);
+	unmap_window();
+
+	// the target buffer is either a read-ahead buffer or in the requesters space
+	g_page_directory current = g_address_space::get_current_space();
+	bool switched = (current != requester->process->pageDirectory);
+	if (switched) {
+		g_address_space::switch_to_space(requester->process->pageDirectory);
 	}
-	delegate_thread->process->virtualRanges.free(rspace->mapping_start);
 
-	// Now switch to the requesters space and copy data there
-	g_address_space::switch_to_space(requester->process->pageDirectory);
+	// a short read may happen anywhere in the file, the end is only known from the length
+	if (status == G_FS_READ_SUCCESSFUL && length_read > 0 && length_read <= pending_length) {
+		bool eof = false;
+		int64_t node_length;
+		g_fs_node* node = g_filesystem::get_node_by_id(fd->node_id);
+		if (node && node->get_cached_length(&node_length)) {
+			eof = (fd->offset + length_read >= node_length);
+		}
+		g_fs_page_cache::fill(fd->node_id, fd->offset, pending_buffer, length_read, eof);
+	}
+
+	if (switched) {
+		g_address_space::switch_to_space(current);
+	}
+	pending_buffer = 0;
+	pending_length = 0;
+	release();
 
 	*out_result = length_read;
 	*out_status = status;
 	if (length_read >= 0) {
 		fd->offset += length_read;
 	}
-
-	g_address_space::switch_to_space(current);
 }
 
 /**
@@ -275,45 +713,92 @@ g_fs_transaction_id g_fs_delegate_tasked::request_write(g_thread* requester, g_f
 		id = g_fs_transaction_store::next_transaction();
 	}
 
-	// save current directory
+	// cached contents of the node become invalid
+	g_fs_page_cache::invalidate(node->id);
+
+	// writes reach the delegate in order, so no write passes the buffered ones
+	if (await_idle(id, handler)) {
+		return id;
+	}
+
+	g_fs_write_buffer* due = find_due_write_buffer();
+	g_fs_write_buffer* write_buffer = find_write_buffer(node->id);
+	bool buffering = (write_mode == G_FS_WRITE_MODE_BACK && length > 0 && length < G_FS_WRITE_BUFFER_SIZE);
+
+	if (due == 0 && write_buffer && write_buffer->length > 0) {
+		bool continues = (fd->offset == write_buffer->offset + write_buffer->length && write_buffer->length + length <= G_FS_WRITE_BUFFER_SIZE);
+		if (!buffering || !continues) {
+			due = write_buffer;
+		}
+	}
+
+	g_fs_tasked_delegate_transaction_storage_write* disc = (g_fs_tasked_delegate_transaction_storage_write*) transaction_storage;
+	if (due) {
+		if (!flush_before(due, id, handler)) {
+			occupy(requester);
+			disc->result_write = -1;
+			disc->result_status = G_FS_WRITE_BUSY;
+			g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+		}
+		return id;
+	}
+	occupy(requester);
+
+	if (buffering && write_buffer == 0) {
+		write_buffer = g_fs_write_buffers::create(node->id, node->phys_fs_id);
+		if (write_buffer) {
+			write_buffer->next = write_buffers;
+			write_buffers = write_buffer;
+		}
+	}
+
 	g_page_directory current = g_address_space::get_current_space();
+	bool switched = (current != requester->process->pageDirectory);
+	if (switched) {
+		g_address_space::switch_to_space(requester->process->pageDirectory);
+	}
 
-	/**
-	 * First we switch to the requesters space and copy everything that we need below to the stack,
-	 * then get the physical addresses of the area where the requesters buffer is:
-	 */
-	g_address_space::switch_to_space(requester->process->pageDirectory);
+	// the write is taken into the buffer and finished as if the delegate had done it
+	if (buffering && write_buffer) {
+		if (write_buffer->length == 0) {
+			write_buffer->offset = fd->offset;
+			write_buffer->dirty_since = g_tasking::getCurrentScheduler()->getMilliseconds();
+			write_buffer->detached = false;
+		}
+		g_memory::copy(write_buffer->data + write_buffer->length, buffer(), length);
+		write_buffer->length += length;
 
-	int required_pages = PAGE_ALIGN_UP(length) / G_PAGE_SIZE + 1;
-	g_local < g_physical_address > phys_pages(new g_physical_address[required_pages]);
-	g_virtual_address virt_start = PAGE_ALIGN_DOWN((g_virtual_address ) buffer());
-	uint32_t offset_in_first_page = ((g_virtual_address) buffer()) & G_PAGE_ALIGN_MASK;
+		if (switched) {
+			g_address_space::switch_to_space(current);
+		}
+		g_fs_write_buffers::buffered();
 
-	for (int i = 0; i < required_pages; i++) {
-		phys_pages()[i] = g_address_space::virtual_to_physical(virt_start + i * G_PAGE_SIZE);
+		disc->result_write = length;
+		disc->result_status = G_FS_WRITE_SUCCESSFUL;
+		g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+		return id;
 	}
 
 	/**
-	 * Now we switch into the delegates space, copy the required data to the
-	 * transaction storage and map all physical pages from the requesters space
-	 * to the delegates space.
+	 * The pages of the requesters buffer are mapped to the window in the delegates space,
+	 * a write that doesn't fit the window is shortened.
 	 */
-	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
+	g_virtual_address source = (g_virtual_address) buffer();
+	if ((source & G_PAGE_ALIGN_MASK) + length > G_FS_TASKED_DELEGATE_WINDOW_PAGES * G_PAGE_SIZE) {
+		length = G_FS_TASKED_DELEGATE_WINDOW_PAGES * G_PAGE_SIZE - (source & G_PAGE_ALIGN_MASK);
+	}
+	int required_pages = ((source & G_PAGE_ALIGN_MASK) + length + G_PAGE_SIZE - 1) / G_PAGE_SIZE;
 
-	g_fs_tasked_delegate_transaction_storage_write* disc = (g_fs_tasked_delegate_transaction_storage_write*) transaction_storage();
 	disc->offset = fd->offset;
 	disc->length = length;
 	disc->phys_fs_id = node->phys_fs_id;
-
-	g_virtual_address mapped_virt = delegate_thread->process->virtualRanges.allocate(required_pages);
-	for (int i = 0; i < required_pages; i++) {
-		g_address_space::map(mapped_virt + i * G_PAGE_SIZE, phys_pages()[i], DEFAULT_USER_TABLE_FLAGS, DEFAULT_USER_PAGE_FLAGS);
-	}
-	disc->mapping_start = mapped_virt;
+	disc->mapping_start = window_start;
 	disc->mapping_pages = required_pages;
-	disc->mapped_buffer = (void*) (mapped_virt + offset_in_first_page);
+	disc->mapped_buffer = (void*) map_window(source, required_pages);
 
-	g_address_space::switch_to_space(current);
+	if (switched) {
+		g_address_space::switch_to_space(current);
+	}
 
 	// send message to the task delegate
 	g_message_empty (request);
@@ -346,31 +831,18 @@ g_fs_transaction_id g_fs_delegate_tasked::request_write(g_thread* requester, g_f
  */
 void g_fs_delegate_tasked::finish_write(g_thread* requester, g_fs_write_status* out_status, int64_t* out_result, g_file_descriptor_content* fd) {
 
-	// save current directory
-	g_page_directory current = g_address_space::get_current_space();
-
-	// Get values from transaction storage and unmap the mapping
-	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
-
-	g_fs_tasked_delegate_transaction_storage_write* storage = (g_fs_tasked_delegate_transaction_storage_write*) transaction_storage();
+	g_fs_tasked_delegate_transaction_storage_write* storage = (g_fs_tasked_delegate_transaction_storage_write*) transaction_storage;
 	int64_t length_write = storage->result_write;
 	g_fs_read_status status = storage->result_status;
 
-	for (int i = 0; i < storage->mapping_pages; i++) {
-		g_address_space::unmap(storage->mapping_start + i * G_PAGE_SIZE);
-	}
-	delegate_thread->process->virtualRanges.free(storage->mapping_start);
-
-	// Now switch to the requesters space and copy data there
-	g_address_space::switch_to_space(requester->process->pageDirectory);
+	unmap_window();
+	release();
 
 	*out_result = length_write;
 	*out_status = status;
 	if (length_write >= 0) {
 		fd->offset += length_write;
 	}
-
-	g_address_space::switch_to_space(current);
 }
 
 /**
@@ -378,20 +850,24 @@ void g_fs_delegate_tasked::finish_write(g_thread* requester, g_fs_write_status*
  */
 g_fs_transaction_id g_fs_delegate_tasked::request_get_length(g_thread* requester, g_fs_node* node, g_fs_transaction_handler_get_length* handler) {
 
-	// the ramdisk handler is doing it's work immediately and doesn't request another process
-	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+	// begin/repeat the transaction
+	g_fs_transaction_id id;
+	if (handler->wants_repeat_transaction()) {
+		id = handler->get_repeated_transaction();
+	} else {
+		id = g_fs_transaction_store::next_transaction();
+	}
 
-	/**
-	 * Switch to the delegates space and fill the transaction storage.
-	 */
-	g_page_directory current = g_address_space::get_current_space();
-	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
+	// the storage is in use until a flush or another request is finished
+	if (await_idle(id, handler)) {
+		return id;
+	}
+	occupy(requester);
 
-	g_fs_tasked_delegate_transaction_storage_get_length* disc = (g_fs_tasked_delegate_transaction_storage_get_length*) transaction_storage();
+	// fill the transaction storage
+	g_fs_tasked_delegate_transaction_storage_get_length* disc = (g_fs_tasked_delegate_transaction_storage_get_length*) transaction_storage;
 	disc->phys_fs_id = node->phys_fs_id;
 
-	g_address_space::switch_to_space(current);
-
 	// update the status / notify delegate thread
 	g_message_empty (request);
 	request.type = G_FS_TASKED_DELEGATE_REQUEST_TYPE_GET_LENGTH;
@@ -422,23 +898,55 @@ g_fs_transaction_id g_fs_delegate_tasked::request_get_length(g_thread* requester
  */
 void g_fs_delegate_tasked::finish_get_length(g_thread* requester, g_fs_transaction_handler_get_length* handler) {
 
-	// save current directory
-	g_page_directory current = g_address_space::get_current_space();
+	g_fs_tasked_delegate_transaction_storage_get_length* storage = (g_fs_tasked_delegate_transaction_storage_get_length*) transaction_storage;
+	handler->length = storage->result_length;
+	handler->status = storage->result_status;
+	release();
 
-	// Get values from transaction storage and unmap the mapping
-	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
+	// data that is still buffered extends the file
+	if (handler->status == G_FS_LENGTH_SUCCESSFUL && handler->node) {
+		g_fs_write_buffer* buffer = find_write_buffer(handler->node->id);
+		if (buffer && buffer->length > 0 && buffer->offset + buffer->length > handler->length) {
+			handler->length = buffer->offset + buffer->length;
+		}
+	}
+}
 
-	g_fs_tasked_delegate_transaction_storage_get_length* storage = (g_fs_tasked_delegate_transaction_storage_get_length*) transaction_storage();
-	int64_t length = storage->result_length;
-	g_fs_read_status status = storage->result_status;
+/**
+ * A flush that failed while nobody waited for it is reported here, the buffer is
+ * dropped afterwards.
+ */
+g_fs_transaction_id g_fs_delegate_tasked::request_flush(g_thread* requester, g_fs_node* node, g_fs_transaction_handler_flush* handler) {
 
-	// Now switch to the requesters space and copy data there
-	g_address_space::switch_to_space(requester->process->pageDirectory);
+	g_fs_transaction_id id;
+	if (handler->wants_repeat_transaction()) {
+		id = handler->get_repeated_transaction();
+	} else {
+		id = g_fs_transaction_store::next_transaction();
+	}
 
-	handler->length = length;
-	handler->status = status;
+	if (await_idle(id, handler)) {
+		return id;
+	}
 
-	g_address_space::switch_to_space(current);
+	g_fs_write_buffer* buffer = find_write_buffer(node->id);
+	if (buffer && buffer->length > 0) {
+		if (!flush_before(buffer, id, handler)) {
+			handler->status = G_FS_FLUSH_BUSY;
+			g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+		}
+		return id;
+	}
+
+	handler->status = G_FS_FLUSH_SUCCESSFUL;
+	if (buffer) {
+		if (buffer->failed) {
+			handler->status = G_FS_FLUSH_ERROR;
+		}
+		release_write_buffer(buffer);
+	}
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+	return id;
 }
 
 /**
@@ -447,19 +955,26 @@ void g_fs_delegate_tasked::finish_get_length(g_thread* requester, g_fs_transacti
 g_fs_transaction_id g_fs_delegate_tasked::request_read_directory(g_thread* requester, g_fs_node* node, int position,
 		g_fs_transaction_handler_read_directory* handler) {
 
-	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+	// begin/repeat the transaction
+	g_fs_transaction_id id;
+	if (handler->wants_repeat_transaction()) {
+		id = handler->get_repeated_transaction();
+	} else {
+		id = g_fs_transaction_store::next_transaction();
+	}
 
-	/**
-	 * Switch to the delegates space and fill the transaction storage.
-	 */
-	g_page_directory current = g_address_space::get_current_space();
-	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
+	// the storage is in use until a flush or another request is finished
+	if (await_idle(id, handler)) {
+		return id;
+	}
+	occupy(requester);
 
-	g_fs_tasked_delegate_transaction_storage_read_directory* disc = (g_fs_tasked_delegate_transaction_storage_read_directory*) transaction_storage();
+	// fill the transaction storage
+	g_fs_tasked_delegate_transaction_storage_read_directory* disc = (g_fs_tasked_delegate_transaction_storage_read_directory*) transaction_storage;
 	disc->parent_phys_fs_id = node->phys_fs_id;
 	disc->position = position;
-
-	g_address_space::switch_to_space(current);
+	disc->maximum = handler->get_capacity();
+	disc->result_count = 0;
 
 	// update the status / notify delegate thread
 	g_message_empty (request);
@@ -491,22 +1006,48 @@ g_fs_transaction_id g_fs_delegate_tasked::request_read_directory(g_thread* reque
  */
 void g_fs_delegate_tasked::finish_read_directory(g_thread* requester, g_fs_transaction_handler_read_directory* handler) {
 
-	// save current directory
-	g_page_directory current = g_address_space::get_current_space();
-
-	// Get values from transaction storage and unmap the mapping
-	g_address_space::switch_to_space(delegate_thread->process->pageDirectory);
-
-	g_fs_tasked_delegate_transaction_storage_read_directory* storage = (g_fs_tasked_delegate_transaction_storage_read_directory*) transaction_storage();
-	g_fs_virt_id virt_id = storage->result_child;
+	g_fs_tasked_delegate_transaction_storage_read_directory* storage = (g_fs_tasked_delegate_transaction_storage_read_directory*) transaction_storage;
 	g_fs_read_directory_status status = storage->result_status;
 
-	// Now switch to the requesters space and copy data there
-	g_address_space::switch_to_space(requester->process->pageDirectory);
+	// delegates that don't read batches only fill the single child
+	uint32_t result_count = storage->result_count;
+	if (result_count > handler->get_capacity()) {
+		result_count = handler->get_capacity();
+	}
 
-	handler->child = g_filesystem::get_node_by_id(virt_id);
-	handler->status = status;
+	if (status == G_FS_READ_DIRECTORY_SUCCESSFUL) {
+		if (result_count == 0) {
+			handler->add_child(g_filesystem::get_node_by_id(storage->result_child));
+		} else {
+			for (uint32_t i = 0; i < result_count; i++) {
+				if (!handler->add_child(g_filesystem::get_node_by_id(storage->result_children[i]))) {
+					break;
+				}
+			}
+		}
+		status = handler->count > 0 ? G_FS_READ_DIRECTORY_SUCCESSFUL : G_FS_READ_DIRECTORY_ERROR;
+	}
 
-	g_address_space::switch_to_space(current);
+	handler->status = status;
+	release();
 }
 
+
+/**
+ * Only contents that are entirely in the page cache are mapped directly, the
+ * cache then shares its pages with the mapping.
+ */
+g_fs_map_status g_fs_delegate_tasked::acquire_pages(g_fs_node* node, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+		uint32_t* out_count, uint32_t* out_displacement, int64_t* out_length) {
+
+	if (offset < 0 || length <= 0) {
+		return G_FS_MAP_INVALID_RANGE;
+	}
+
+	if (!g_fs_page_cache::acquire(node->id, offset, length, out_pages, capacity, out_count, out_length)) {
+		return G_FS_MAP_NOT_RESIDENT;
+	}
+
+	*out_displacement = offset % G_PAGE_SIZE;
+	return G_FS_MAP_SUCCESSFUL;
+}
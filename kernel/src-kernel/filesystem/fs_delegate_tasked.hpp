@@ -23,18 +23,152 @@
 
 #include "ghost/stdint.h"
 #include "filesystem/fs_delegate.hpp"
+#include "filesystem/fs_write_buffer.hpp"
 #include "tasking/tasking.hpp"
+#include "tasking/wait/wait_queue.hpp"
 #include "memory/contextual.hpp"
+#include "memory/paging.hpp"
+
+/**
+ * Number of pages in the window that is reserved in the delegates address space for
+ * the buffers of read and write requests. Longer requests are shortened to fit.
+ */
+#define G_FS_TASKED_DELEGATE_WINDOW_PAGES	256
+#define G_FS_TASKED_DELEGATE_WINDOW_TABLES	(G_FS_TASKED_DELEGATE_WINDOW_PAGES / 1024 + 2)
+
+/**
+ * Time-to-live of cached attributes of nodes on a tasked delegate, unless the
+ * delegate sets it for a node.
+ */
+#define G_FS_TASKED_DELEGATE_ATTRIBUTES_TTL	1000
 
 /**
  *
  */
 class g_fs_delegate_tasked: public g_fs_delegate {
 private:
-	g_contextual<void*> transaction_storage;
+	/**
+	 * The transaction storage is mapped in the delegates space and in the kernel space,
+	 * so it can be accessed from any address space.
+	 */
+	void* transaction_storage;
 	g_physical_address transaction_storage_phys;
 	g_thread* delegate_thread;
 
+	/**
+	 * Range in the delegates space where the buffer of the current request is mapped.
+	 * The page tables that contain this range are mapped to the kernel space, so the
+	 * window can be filled without switching to the delegates space.
+	 */
+	g_virtual_address window_start;
+	g_page_table window_tables[G_FS_TASKED_DELEGATE_WINDOW_TABLES];
+	int window_mapped_pages;
+
+	/**
+	 * The buffer (valid in the requesters space) that the current read is done to,
+	 * used to fill the page cache once the read is finished.
+	 */
+	uint8_t* pending_buffer;
+	int64_t pending_length;
+
+	/**
+	 * The transaction storage, the window and the pending read belong to one request
+	 * from sending it until its result was taken by the respective finish function.
+	 * Other requests are set to repeat meanwhile and wait on the idle queue.
+	 */
+	bool busy;
+	g_tid busy_requester;
+	g_wait_queue idle_queue;
+
+	/**
+	 * Marks the storage as used by the request of the requester.
+	 */
+	void occupy(g_thread* requester);
+
+	/**
+	 * Marks the storage as free and wakes the requests that wait for it.
+	 */
+	void release();
+
+	/**
+	 * Maps the pages behind the buffer (which must be accessible in the current space)
+	 * to the window and returns the address of the buffer within the delegates space.
+	 */
+	g_virtual_address map_window(g_virtual_address buffer, int pages);
+
+	/**
+	 * Removes all pages that are currently mapped to the window.
+	 */
+	void unmap_window();
+
+	/**
+	 * Writes the page table entry for the page with the given index in the window.
+	 */
+	void set_window_entry(int index, uint32_t entry);
+
+	/**
+	 * Copies the path that follows the discovered name to the transaction storage.
+	 */
+	void copy_remaining_path(char* out, const char* remaining);
+
+	/**
+	 * Write-back buffers of the nodes of this delegate. At most one buffer is flushed at
+	 * a time, with a transaction of its own; requests that must wait for it are set to
+	 * repeat once that transaction is finished.
+	 */
+	g_fs_write_mode write_mode;
+	g_fs_write_buffer* write_buffers;
+	g_fs_write_buffer* flushing;
+	g_fs_transaction_id flush_transaction;
+
+	/**
+	 * Returns the buffer of the node, or 0 if it has none.
+	 */
+	g_fs_write_buffer* find_write_buffer(g_fs_virt_id node_id);
+
+	/**
+	 * Returns a dirty buffer that must be flushed because it is too old or memory is low.
+	 */
+	g_fs_write_buffer* find_due_write_buffer();
+
+	/**
+	 *
+	 */
+	void release_write_buffer(g_fs_write_buffer* buffer);
+
+	/**
+	 * Sends the contents of the buffer to the delegate as a write request.
+	 *
+	 * @return whether the request was sent
+	 */
+	bool start_flush(g_fs_write_buffer* buffer);
+
+	/**
+	 * Takes the result of the finished flush transaction.
+	 */
+	void complete_flush();
+
+	/**
+	 * Lets the transaction repeat once the flush in progress is finished and no
+	 * other request uses the storage.
+	 *
+	 * @return whether the transaction has to wait
+	 */
+	bool await_idle(g_fs_transaction_id id, g_fs_transaction_handler* handler);
+
+	/**
+	 * Starts flushing the buffer and lets the transaction repeat once that is finished.
+	 *
+	 * @return whether the flush was started
+	 */
+	bool flush_before(g_fs_write_buffer* buffer, g_fs_transaction_id id, g_fs_transaction_handler* handler);
+
+	/**
+	 * Takes the result of a finished flush and, if the storage is free, starts flushing
+	 * the next buffer that is due.
+	 */
+	void progress_flushes();
+
 public:
 	/**
 	 *
@@ -47,9 +181,23 @@ public:
 	virtual ~g_fs_delegate_tasked() {
 	}
 
+	/**
+	 *
+	 */
+	virtual g_tid get_serving_thread() {
+		return delegate_thread->id;
+	}
+
+	/**
+	 *
+	 */
+	virtual g_fs_attributes_ttl get_attributes_ttl() {
+		return G_FS_TASKED_DELEGATE_ATTRIBUTES_TTL;
+	}
+
 	/**
 	 * Prepares the task delegate by setting up a transaction storage
-	 * within the delegates address space.
+	 * and the window for request buffers within the delegates address space.
 	 *
 	 * @param out_transaction_storage
 	 * 		is filled with the address of the transaction storage within
@@ -60,7 +208,8 @@ public:
 	bool prepare(g_virtual_address* out_transaction_storage);
 
 	/**
-	 *
+	 * Passes the name and the remaining path, so the delegate can discover
+	 * multiple elements within one transaction.
 	 */
 	virtual g_fs_transaction_id request_discovery(g_thread* requester, g_fs_node* parent, char* child, g_fs_transaction_handler_discovery* handler);
 
@@ -70,9 +219,9 @@ public:
 	virtual void finish_discovery(g_thread* requester, g_fs_transaction_handler_discovery* handler);
 
 	/**
-	 * This implementation first sets up a transaction storage in the delegates address
-	 * space containing the read request data and the maps the pages that contain the
-	 * requesters buffer into the delegates address space.
+	 * This implementation fills the transaction storage with the read request data
+	 * and maps the pages that contain the requesters buffer into the window in the
+	 * delegates address space. Requests that don't fit the window are shortened.
 	 *
 	 * Also, the pointer to the call data struct is put into the {g_fs_transaction_store}.
 	 * Once the transaction is finished, the {g_waiter_fs_read} calls this delegate to
@@ -89,7 +238,10 @@ public:
 	virtual void finish_read(g_thread* requester, g_fs_read_status* out_status, int64_t* out_result, g_file_descriptor_content* fd);
 
 	/**
-	 * The write implementation is very similar to read.
+	 * The write implementation is very similar to read. In write-back mode, writes that are
+	 * smaller than a write buffer are collected in the buffer of the node and finished right
+	 * away, as long as they continue the buffered range. The buffer is flushed first if a
+	 * write doesn't continue it, doesn't fit into it or is not buffered.
 	 */
 	virtual g_fs_transaction_id request_write(g_thread* requester, g_fs_node* node, int64_t length, g_contextual<uint8_t*> buffer,
 			g_file_descriptor_content* fd, g_fs_transaction_handler_write* handler);
@@ -109,6 +261,28 @@ public:
 	 */
 	virtual void finish_get_length(g_thread* requester, g_fs_transaction_handler_get_length* handler);
 
+	/**
+	 * Flushes the buffer of the node and reports a flush of it that failed before.
+	 */
+	virtual g_fs_transaction_id request_flush(g_thread* requester, g_fs_node* node, g_fs_transaction_handler_flush* handler);
+
+	/**
+	 *
+	 */
+	virtual void flush_detached(g_fs_node* node);
+
+	/**
+	 *
+	 */
+	virtual void transaction_status_changed();
+
+	/**
+	 *
+	 */
+	virtual void set_write_mode(g_fs_write_mode mode) {
+		write_mode = mode;
+	}
+
 	/**
 	 *
 	 */
@@ -119,6 +293,12 @@ public:
 	 */
 	virtual void finish_read_directory(g_thread* requester, g_fs_transaction_handler_read_directory* handler);
 
+	/**
+	 *
+	 */
+	virtual g_fs_map_status acquire_pages(g_fs_node* node, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+			uint32_t* out_count, uint32_t* out_displacement, int64_t* out_length);
+
 };
 
 #endif
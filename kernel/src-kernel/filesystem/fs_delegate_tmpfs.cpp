@@ -0,0 +1,254 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_delegate_tmpfs.hpp"
+#include "filesystem/filesystem.hpp"
+#include "utils/string.hpp"
+#include "logger/logger.hpp"
+
+/**
+ *
+ */
+g_fs_node* g_fs_delegate_tmpfs::create_vfs_node(g_tmpfs_node* tmpfs_node, g_fs_node* parent) {
+
+	g_fs_node* node = g_filesystem::create_node();
+	node->phys_fs_id = tmpfs_node->id;
+	node->type = tmpfs_node->type;
+
+	node->name = new char[g_string::length(tmpfs_node->name) + 1];
+	g_string::copy(node->name, tmpfs_node->name);
+
+	// add it to the parent
+	parent->add_child(node);
+
+	return node;
+}
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_tmpfs::request_discovery(g_thread* requester, g_fs_node* parent, char* child, g_fs_transaction_handler_discovery* handler) {
+
+	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+
+	g_tmpfs_node* tmpfs_parent = g_tmpfs::get(parent->phys_fs_id);
+	g_tmpfs_node* tmpfs_child = tmpfs_parent ? g_tmpfs::find_child(tmpfs_parent, child) : 0;
+	if (tmpfs_child) {
+		create_vfs_node(tmpfs_child, parent);
+		handler->status = G_FS_DISCOVERY_SUCCESSFUL;
+	} else {
+		handler->status = G_FS_DISCOVERY_NOT_FOUND;
+	}
+
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+	return id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tmpfs::finish_discovery(g_thread* requester, g_fs_transaction_handler_discovery* handler) {
+}
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_tmpfs::request_read(g_thread* requester, g_fs_node* node, int64_t length, g_contextual<uint8_t*> buffer,
+		g_file_descriptor_content* fd, g_fs_transaction_handler_read* handler) {
+
+	// start/repeat transaction
+	g_fs_transaction_id id;
+	if (handler->wants_repeat_transaction()) {
+		id = handler->get_repeated_transaction();
+	} else {
+		id = g_fs_transaction_store::next_transaction();
+	}
+
+	g_tmpfs_node* file = g_tmpfs::get(node->phys_fs_id);
+	if (file == 0 || file->type != G_FS_NODE_TYPE_FILE) {
+		handler->status = G_FS_READ_INVALID_FD;
+
+	} else {
+		int64_t read = g_tmpfs::read(file, fd->offset, buffer(), length);
+		fd->offset += read;
+		handler->result = read;
+		handler->status = G_FS_READ_SUCCESSFUL;
+	}
+
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+	return id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tmpfs::finish_read(g_thread* requester, g_fs_read_status* out_status, int64_t* out_result, g_file_descriptor_content* fd) {
+}
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_tmpfs::request_write(g_thread* requester, g_fs_node* node, int64_t length, g_contextual<uint8_t*> buffer,
+		g_file_descriptor_content* fd, g_fs_transaction_handler_write* handler) {
+
+	// start/repeat transaction
+	g_fs_transaction_id id;
+	if (handler->wants_repeat_transaction()) {
+		id = handler->get_repeated_transaction();
+	} else {
+		id = g_fs_transaction_store::next_transaction();
+	}
+
+	g_tmpfs_node* file = g_tmpfs::get(node->phys_fs_id);
+	if (file == 0 || file->type != G_FS_NODE_TYPE_FILE) {
+		handler->result = -1;
+		handler->status = G_FS_WRITE_INVALID_FD;
+
+	} else {
+		int64_t written = g_tmpfs::write(file, fd->offset, buffer(), length);
+		if (written >= 0) {
+			fd->offset += written;
+			handler->result = written;
+			handler->status = G_FS_WRITE_SUCCESSFUL;
+		} else {
+			handler->result = -1;
+			handler->status = G_FS_WRITE_ERROR;
+		}
+	}
+
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+	return id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tmpfs::finish_write(g_thread* requester, g_fs_write_status* out_status, int64_t* out_result, g_file_descriptor_content* fd) {
+}
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_tmpfs::request_get_length(g_thread* requester, g_fs_node* node, g_fs_transaction_handler_get_length* handler) {
+
+	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+
+	g_tmpfs_node* file = g_tmpfs::get(node->phys_fs_id);
+	if (file == 0) {
+		handler->status = G_FS_LENGTH_NOT_FOUND;
+		handler->length = 0;
+	} else {
+		handler->status = G_FS_LENGTH_SUCCESSFUL;
+		handler->length = file->length;
+	}
+
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+	return id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tmpfs::finish_get_length(g_thread* requester, g_fs_transaction_handler_get_length* handler) {
+}
+
+/**
+ *
+ */
+g_fs_transaction_id g_fs_delegate_tmpfs::request_read_directory(g_thread* requester, g_fs_node* fs_parent, int position,
+		g_fs_transaction_handler_read_directory* handler) {
+
+	g_fs_transaction_id id = g_fs_transaction_store::next_transaction();
+
+	g_tmpfs_node* tmpfs_parent = g_tmpfs::get(fs_parent->phys_fs_id);
+	if (tmpfs_parent == 0 || tmpfs_parent->type != G_FS_NODE_TYPE_FOLDER) {
+		handler->status = G_FS_READ_DIRECTORY_ERROR;
+
+	} else {
+		// add children from the position on as long as the handler takes them
+		uint32_t index = position;
+		while (index < tmpfs_parent->child_count) {
+			g_tmpfs_node* tmpfs_child = tmpfs_parent->children[index];
+
+			g_fs_node* fs_child = fs_parent->find_child(tmpfs_child->name);
+			if (fs_child == 0) {
+				fs_child = create_vfs_node(tmpfs_child, fs_parent);
+			}
+
+			if (!handler->add_child(fs_child)) {
+				break;
+			}
+			++index;
+		}
+		handler->finish_children(index >= tmpfs_parent->child_count);
+	}
+
+	g_fs_transaction_store::set_status(id, G_FS_TRANSACTION_FINISHED);
+	return id;
+}
+
+/**
+ *
+ */
+void g_fs_delegate_tmpfs::finish_read_directory(g_thread* requester, g_fs_transaction_handler_read_directory* handler) {
+}
+
+/**
+ * The pages are shared with the mapping, so writes to the file are visible in
+ * shared mappings of it.
+ */
+g_fs_map_status g_fs_delegate_tmpfs::acquire_pages(g_fs_node* node, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+		uint32_t* out_count, uint32_t* out_displacement, int64_t* out_length) {
+
+	g_tmpfs_node* file = g_tmpfs::get(node->phys_fs_id);
+	if (file == 0) {
+		return G_FS_MAP_NOT_SUPPORTED;
+	}
+	return g_tmpfs::acquire_pages(file, offset, length, out_pages, capacity, out_count, out_displacement, out_length);
+}
+
+/**
+ *
+ */
+g_fs_node* g_fs_delegate_tmpfs::create_child(g_fs_node* parent, char* name, g_fs_node_type type) {
+
+	g_tmpfs_node* tmpfs_parent = g_tmpfs::get(parent->phys_fs_id);
+	if (tmpfs_parent == 0) {
+		return 0;
+	}
+
+	g_tmpfs_node* tmpfs_child = g_tmpfs::create(tmpfs_parent, name, type);
+	if (tmpfs_child == 0) {
+		return 0;
+	}
+	return create_vfs_node(tmpfs_child, parent);
+}
+
+/**
+ *
+ */
+bool g_fs_delegate_tmpfs::truncate(g_fs_node* node, int64_t length) {
+
+	g_tmpfs_node* file = g_tmpfs::get(node->phys_fs_id);
+	if (file == 0) {
+		return false;
+	}
+	return g_tmpfs::truncate(file, length);
+}
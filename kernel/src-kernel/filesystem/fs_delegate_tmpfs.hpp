@@ -0,0 +1,131 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_FILESYSTEMTMPFSDELEGATE
+#define GHOST_FILESYSTEM_FILESYSTEMTMPFSDELEGATE
+
+#include "ghost/stdint.h"
+#include "memory/contextual.hpp"
+#include "filesystem/fs_delegate.hpp"
+#include "filesystem/tmpfs.hpp"
+
+/**
+ * Delegate for the memory-backed {g_tmpfs}. All operations are performed
+ * immediately within the kernel.
+ */
+class g_fs_delegate_tmpfs: public g_fs_delegate {
+private:
+	/**
+	 *
+	 */
+	g_fs_node* create_vfs_node(g_tmpfs_node* tmpfs_node, g_fs_node* parent);
+
+public:
+	/**
+	 *
+	 */
+	virtual ~g_fs_delegate_tmpfs() {
+	}
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_id request_discovery(g_thread* requester, g_fs_node* parent, char* child, g_fs_transaction_handler_discovery* handler);
+
+	/**
+	 *
+	 */
+	virtual void finish_discovery(g_thread* requester, g_fs_transaction_handler_discovery* handler);
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_id request_read(g_thread* requester, g_fs_node* node, int64_t length, g_contextual<uint8_t*> buffer, g_file_descriptor_content* fd,
+			g_fs_transaction_handler_read* handler);
+
+	/**
+	 *
+	 */
+	virtual void finish_read(g_thread* requester, g_fs_read_status* out_status, int64_t* out_result, g_file_descriptor_content* fd);
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_id request_write(g_thread* requester, g_fs_node* node, int64_t length, g_contextual<uint8_t*> buffer,
+			g_file_descriptor_content* fd, g_fs_transaction_handler_write* handler);
+
+	/**
+	 *
+	 */
+	virtual void finish_write(g_thread* requester, g_fs_write_status* out_status, int64_t* out_result, g_file_descriptor_content* fd);
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_id request_get_length(g_thread* requester, g_fs_node* node, g_fs_transaction_handler_get_length* handler);
+
+	/**
+	 *
+	 */
+	virtual void finish_get_length(g_thread* requester, g_fs_transaction_handler_get_length* handler);
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_id request_read_directory(g_thread* requester, g_fs_node* node, int position, g_fs_transaction_handler_read_directory* handler);
+
+	/**
+	 *
+	 */
+	virtual void finish_read_directory(g_thread* requester, g_fs_transaction_handler_read_directory* handler);
+
+	/**
+	 *
+	 */
+	virtual g_fs_map_status acquire_pages(g_fs_node* node, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+			uint32_t* out_count, uint32_t* out_displacement, int64_t* out_length);
+
+	/**
+	 *
+	 */
+	virtual g_fs_node* create_child(g_fs_node* parent, char* name, g_fs_node_type type);
+
+	/**
+	 *
+	 */
+	virtual bool truncate(g_fs_node* node, int64_t length);
+
+	/**
+	 * The tmpfs only changes through the kernel.
+	 */
+	virtual g_fs_attributes_ttl get_attributes_ttl() {
+		return G_FS_ATTRIBUTES_TTL_AUTHORITATIVE;
+	}
+
+	/**
+	 * Nodes are created from the entries of the tmpfs whenever they are discovered.
+	 */
+	virtual bool can_evict_nodes() {
+		return true;
+	}
+
+};
+
+#endif
@@ -21,103 +21,190 @@
 #include <filesystem/fs_descriptors.hpp>
 #include <logger/logger.hpp>
 
-static g_hash_map<g_pid, g_file_descriptor_table*>* process_descriptor_table_map;
+/**
+ *
+ */
+g_file_descriptor_table::g_file_descriptor_table() {
+	entries = new g_file_descriptor_content*[G_FS_DESCRIPTOR_TABLE_INITIAL_SIZE];
+	size = G_FS_DESCRIPTOR_TABLE_INITIAL_SIZE;
+	for (uint32_t i = 0; i < size; i++) {
+		entries[i] = 0;
+	}
+	free_hint = G_FS_DESCRIPTOR_FIRST_AUTOMATIC;
+}
 
 /**
  *
  */
-void g_file_descriptors::initialize() {
-	process_descriptor_table_map = new g_hash_map<g_pid, g_file_descriptor_table*>();
+g_file_descriptor_table::~g_file_descriptor_table() {
+	for (uint32_t i = 0; i < size; i++) {
+		if (entries[i]) {
+			delete entries[i];
+		}
+	}
+	delete[] entries;
 }
 
 /**
  *
  */
-g_file_descriptor_content* g_file_descriptors::create_descriptor(g_file_descriptor_table* table, g_fd override_fd) {
-	g_fd descriptor;
-	if (override_fd == -1) {
-		descriptor = table->nextFileDescriptor++;
+int64_t g_file_descriptor_content::track_read(int64_t length) {
+
+	if (offset == readahead_expected_offset) {
+		if (readahead_window == 0) {
+			readahead_window = G_FS_READAHEAD_MINIMUM_WINDOW;
+		} else if (readahead_window < G_FS_READAHEAD_MAXIMUM_WINDOW) {
+			readahead_window *= 2;
+		}
 	} else {
-		descriptor = override_fd;
+		readahead_window = 0;
 	}
 
-	g_file_descriptor_content* desc = new g_file_descriptor_content;
-	desc->id = descriptor;
-	desc->offset = 0;
-	table->descriptors.put(descriptor, desc);
-	return desc;
+	readahead_expected_offset = offset + length;
+	return readahead_window;
+}
+
+/**
+ * Grows the table so that it has at least the given size.
+ */
+bool g_file_descriptors::ensure_size(g_file_descriptor_table* table, uint32_t size) {
+
+	if (size <= table->size) {
+		return true;
+	}
+	if (size > G_FS_DESCRIPTOR_TABLE_MAXIMUM_SIZE) {
+		return false;
+	}
+
+	uint32_t new_size = table->size;
+	while (new_size < size) {
+		new_size *= 2;
+	}
+	if (new_size > G_FS_DESCRIPTOR_TABLE_MAXIMUM_SIZE) {
+		new_size = G_FS_DESCRIPTOR_TABLE_MAXIMUM_SIZE;
+	}
+
+	g_file_descriptor_content** entries = new g_file_descriptor_content*[new_size];
+	for (uint32_t i = 0; i < table->size; i++) {
+		entries[i] = table->entries[i];
+	}
+	for (uint32_t i = table->size; i < new_size; i++) {
+		entries[i] = 0;
+	}
+
+	delete[] table->entries;
+	table->entries = entries;
+	table->size = new_size;
+	return true;
 }
 
 /**
  *
  */
-g_fd g_file_descriptors::map(g_pid pid, g_fs_virt_id node_id, g_fd fd) {
+g_fd g_file_descriptors::map(g_process* process, g_fs_virt_id node_id, g_fd fd) {
+
+	g_file_descriptor_table* table = process->fileDescriptors;
 
-	g_file_descriptor_table* process_table = get_process_table(pid);
+	g_fd descriptor = fd;
+	if (descriptor == -1) {
+		// take the lowest free descriptor
+		descriptor = table->free_hint;
+		while ((uint32_t) descriptor < table->size && table->entries[descriptor]) {
+			++descriptor;
+		}
+	}
+
+	if (descriptor < 0 || !ensure_size(table, descriptor + 1) || table->entries[descriptor]) {
+		return -1;
+	}
 
-	g_file_descriptor_content* desc = create_descriptor(process_table, fd);
+	g_file_descriptor_content* desc = new g_file_descriptor_content;
+	desc->id = descriptor;
+	desc->offset = 0;
 	desc->node_id = node_id;
+	desc->readahead_expected_offset = 0;
+	desc->readahead_window = 0;
+	table->entries[descriptor] = desc;
+
+	if (fd == -1) {
+		table->free_hint = descriptor + 1;
+	}
 
-	return desc->id;
+	return descriptor;
 }
 
 /**
  *
  */
-void g_file_descriptors::unmap(g_pid pid, g_fd fd) {
+void g_file_descriptors::unmap(g_process* process, g_fd fd) {
+
+	g_file_descriptor_table* table = process->fileDescriptors;
+
+	if (fd >= 0 && (uint32_t) fd < table->size && table->entries[fd]) {
+		delete table->entries[fd];
+		table->entries[fd] = 0;
 
-	g_file_descriptor_table* process_table = get_process_table(pid);
-	auto entry = process_table->descriptors.get(fd);
-	if (entry) {
-		auto content = entry->value;
-		process_table->descriptors.remove(content->id);
-		delete content;
+		if (fd >= G_FS_DESCRIPTOR_FIRST_AUTOMATIC && (uint32_t) fd < table->free_hint) {
+			table->free_hint = fd;
+		}
 	}
+
 }
 
 /**
  *
  */
-void g_file_descriptors::unmap_all(g_pid pid) {
+void g_file_descriptors::unmap_all(g_process* process) {
 
-	g_file_descriptor_table* process_table = get_process_table(pid);
+	g_file_descriptor_table* table = process->fileDescriptors;
 
-	for (auto iter = process_table->descriptors.begin(); iter != process_table->descriptors.end(); ++iter) {
-		g_file_descriptor_content* content = iter->value;
-		delete content;
+	for (uint32_t i = 0; i < table->size; i++) {
+		if (table->entries[i]) {
+			delete table->entries[i];
+			table->entries[i] = 0;
+		}
 	}
+	table->free_hint = G_FS_DESCRIPTOR_FIRST_AUTOMATIC;
 
-	process_descriptor_table_map->remove(pid);
-	delete process_table;
 }
 
 /**
  *
  */
-g_file_descriptor_table* g_file_descriptors::get_process_table(g_pid pid) {
+g_file_descriptor_content* g_file_descriptors::get(g_process* process, g_fd fd) {
 
-	auto entry = process_descriptor_table_map->get(pid);
+	g_file_descriptor_table* table = process->fileDescriptors;
 
-	g_file_descriptor_table* table = 0;
-	if (entry == 0) {
-		table = new g_file_descriptor_table;
-		process_descriptor_table_map->put(pid, table);
-	} else {
-		table = entry->value;
+	g_file_descriptor_content* content = 0;
+	if (fd >= 0 && (uint32_t) fd < table->size) {
+		content = table->entries[fd];
 	}
 
-	return table;
+	return content;
 }
 
 /**
  *
  */
-g_file_descriptor_content* g_file_descriptors::get(g_pid pid, g_fd fd) {
-
-	g_file_descriptor_table* process_table = get_process_table(pid);
-	auto entry = process_table->descriptors.get(fd);
-	if (entry) {
-		return entry->value;
+void g_file_descriptors::clone_all(g_process* source, g_process* target) {
+
+	g_file_descriptor_table* source_table = source->fileDescriptors;
+	g_file_descriptor_table* target_table = target->fileDescriptors;
+
+	ensure_size(target_table, source_table->size);
+	for (uint32_t i = 0; i < source_table->size; i++) {
+		g_file_descriptor_content* content = source_table->entries[i];
+		if (content == 0 || target_table->entries[i]) {
+			continue;
+		}
+
+		g_file_descriptor_content* clone = new g_file_descriptor_content;
+		clone->id = content->id;
+		clone->readahead_expected_offset = 0;
+		clone->readahead_window = 0;
+		content->clone_into(clone);
+		target_table->entries[i] = clone;
 	}
-	return 0;
+	target_table->free_hint = source_table->free_hint;
+
 }
@@ -23,9 +23,15 @@
 
 #include "ghost/fs.h"
 #include "filesystem/pipes.hpp"
-#include <utils/hash_map.hpp>
 #include <tasking/process.hpp>
 
+/**
+ * Bounds of the read-ahead window. The window starts at the minimum once reads
+ * on a descriptor are sequential and doubles with each further sequential read.
+ */
+#define G_FS_READAHEAD_MINIMUM_WINDOW	0x4000
+#define G_FS_READAHEAD_MAXIMUM_WINDOW	0x20000
+
 /**
  *
  */
@@ -34,18 +40,51 @@ struct g_file_descriptor_content {
 	int64_t offset;
 	g_fs_virt_id node_id;
 
+	/**
+	 * Access pattern detection for read-ahead: the offset at which the next read
+	 * is expected if reading is sequential, and the current window size.
+	 */
+	int64_t readahead_expected_offset;
+	int64_t readahead_window;
+
 	void clone_into(g_file_descriptor_content* other) {
 		other->offset = offset;
 		other->node_id = node_id;
 	}
+
+	/**
+	 * Records a read of the given length at the current offset and adapts
+	 * the read-ahead window to the access pattern.
+	 *
+	 * @return the number of bytes to read ahead, zero if reading is not sequential
+	 */
+	int64_t track_read(int64_t length);
 };
 
 /**
- *
+ * Size bounds of the descriptor table of a process. The table grows by
+ * doubling; descriptors beyond the maximum can not be created.
+ */
+#define G_FS_DESCRIPTOR_TABLE_INITIAL_SIZE	16
+#define G_FS_DESCRIPTOR_TABLE_MAXIMUM_SIZE	0x10000
+
+/**
+ * The first descriptor that is handed out automatically; the ones below are
+ * reserved for stdin/stdout/stderr and only used when requested explicitly.
+ */
+#define G_FS_DESCRIPTOR_FIRST_AUTOMATIC		3
+
+/**
+ * Descriptor table of a process, indexed by the descriptor. "free_hint" is the
+ * lowest automatic descriptor that may be free, there is no free one below.
  */
 struct g_file_descriptor_table {
-	g_fd nextFileDescriptor = 3; // skips stdin/stdout/stderr
-	g_hash_map<g_fd, g_file_descriptor_content*> descriptors;
+	g_file_descriptor_content** entries;
+	uint32_t size;
+	uint32_t free_hint;
+
+	g_file_descriptor_table();
+	~g_file_descriptor_table();
 };
 
 /**
@@ -53,16 +92,37 @@ struct g_file_descriptor_table {
  */
 class g_file_descriptors {
 private:
-	static g_file_descriptor_content* create_descriptor(g_file_descriptor_table* table, g_fd override_fd = -1);
+	static bool ensure_size(g_file_descriptor_table* table, uint32_t size);
+
 public:
-	static void initialize();
+	/**
+	 * Creates a descriptor for the node. If no descriptor is given, the lowest
+	 * free one is used.
+	 *
+	 * @return the descriptor, or -1 if it is in use or out of range
+	 */
+	static g_fd map(g_process* process, g_fs_virt_id node_id, g_fd fd = -1);
+
+	/**
+	 *
+	 */
+	static void unmap(g_process* process, g_fd fd);
+
+	/**
+	 * Removes all descriptors of the process.
+	 */
+	static void unmap_all(g_process* process);
 
-	static g_fd map(g_pid pid, g_fs_virt_id node_id, g_fd fd = -1);
-	static void unmap(g_pid pid, g_fd fd);
-	static void unmap_all(g_pid pid);
+	/**
+	 *
+	 */
+	static g_file_descriptor_content* get(g_process* process, g_fd fd);
 
-	static g_file_descriptor_content* get(g_pid pid, g_fd fd);
-	static g_file_descriptor_table* get_process_table(g_pid pid);
+	/**
+	 * Copies all descriptors of the source process into the empty table of the
+	 * target process, keeping their numbers and offsets.
+	 */
+	static void clone_all(g_process* source, g_process* target);
 };
 
 #endif
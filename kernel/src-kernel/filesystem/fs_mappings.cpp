@@ -0,0 +1,171 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_mappings.hpp"
+#include "memory/physical/pp_allocator.hpp"
+#include "memory/physical/pp_reference_tracker.hpp"
+#include "memory/temporary_paging_util.hpp"
+#include "memory/address_space.hpp"
+#include "logger/logger.hpp"
+
+/**
+ *
+ */
+static g_address_range* find_range(g_process* process, g_virtual_address address) {
+
+	g_address_range* range = process->virtualRanges.getRanges();
+	while (range) {
+		if (range->used && address >= range->base && address < range->base + range->pages * G_PAGE_SIZE) {
+			return range;
+		}
+		range = range->next;
+	}
+	return 0;
+}
+
+/**
+ *
+ */
+void g_fs_mappings::release_pages(g_virtual_address base, uint32_t count) {
+
+	for (uint32_t i = 0; i < count; i++) {
+		g_virtual_address virt = base + i * G_PAGE_SIZE;
+		g_physical_address physical = g_address_space::virtual_to_physical(virt);
+
+		g_address_space::unmap(virt);
+		if (g_pp_reference_tracker::decrement(physical) == 0) {
+			g_pp_allocator::free(physical);
+		}
+	}
+}
+
+/**
+ *
+ */
+g_virtual_address g_fs_mappings::create(g_process* process, g_physical_address* pages, uint32_t count, g_fs_map_flags flags) {
+
+	uint8_t range_flags = G_PROC_VIRTUAL_RANGE_FLAG_FILE_MAPPING;
+	if (flags & G_FS_MAP_PRIVATE) {
+		range_flags |= G_PROC_VIRTUAL_RANGE_FLAG_COPY_ON_WRITE;
+	}
+
+	g_virtual_address base = process->virtualRanges.allocate(count, range_flags);
+	if (base == 0) {
+		return 0;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		g_address_space::map(base + i * G_PAGE_SIZE, pages[i], DEFAULT_USER_TABLE_FLAGS, G_FS_MAPPING_READ_ONLY_PAGE_FLAGS);
+	}
+	return base;
+}
+
+/**
+ *
+ */
+g_virtual_address g_fs_mappings::create_anonymous(g_process* process, uint32_t count) {
+
+	g_virtual_address base = process->virtualRanges.allocate(count, G_PROC_VIRTUAL_RANGE_FLAG_FILE_MAPPING);
+	if (base == 0) {
+		return 0;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		g_physical_address physical = g_pp_allocator::allocate();
+		if (physical == 0) {
+			g_log_warn("%! went out of memory while creating a mapping of %i pages", "mappings", count);
+			release_pages(base, i);
+			process->virtualRanges.free(base);
+			return 0;
+		}
+
+		g_virtual_address virt = base + i * G_PAGE_SIZE;
+		g_address_space::map(virt, physical, DEFAULT_USER_TABLE_FLAGS, DEFAULT_USER_PAGE_FLAGS);
+		g_pp_reference_tracker::increment(physical);
+		g_memory::setBytes((void*) virt, 0, G_PAGE_SIZE);
+	}
+	return base;
+}
+
+/**
+ *
+ */
+void g_fs_mappings::protect(g_process* process, g_virtual_address base) {
+
+	g_address_range* range = find_range(process, base);
+	if (range == 0) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < range->pages; i++) {
+		g_virtual_address virt = range->base + i * G_PAGE_SIZE;
+		g_address_space::map(virt, g_address_space::virtual_to_physical(virt), DEFAULT_USER_TABLE_FLAGS, G_FS_MAPPING_READ_ONLY_PAGE_FLAGS, true);
+	}
+}
+
+/**
+ *
+ */
+bool g_fs_mappings::release(g_process* process, g_virtual_address base) {
+
+	g_address_range* range = find_range(process, base);
+	if (range == 0 || range->base != PAGE_ALIGN_DOWN(base) || (range->flags & G_PROC_VIRTUAL_RANGE_FLAG_FILE_MAPPING) == 0) {
+		return false;
+	}
+
+	g_virtual_address range_base = range->base;
+	release_pages(range_base, range->pages);
+	process->virtualRanges.free(range_base);
+	return true;
+}
+
+/**
+ *
+ */
+bool g_fs_mappings::handle_copy_on_write(g_process* process, g_virtual_address address) {
+
+	g_address_range* range = find_range(process, address);
+	if (range == 0 || (range->flags & G_PROC_VIRTUAL_RANGE_FLAG_COPY_ON_WRITE) == 0) {
+		return false;
+	}
+
+	g_virtual_address virt = PAGE_ALIGN_DOWN(address);
+	g_physical_address shared = g_address_space::virtual_to_physical(virt);
+	if (shared == 0) {
+		return false;
+	}
+
+	// copy the shared page to a new page of the process
+	g_physical_address copy = g_pp_allocator::allocate();
+	if (copy == 0) {
+		return false;
+	}
+	g_virtual_address copy_temp = g_temporary_paging_util::map(copy);
+	g_memory::copy((uint8_t*) copy_temp, (uint8_t*) virt, G_PAGE_SIZE);
+	g_temporary_paging_util::unmap(copy_temp);
+
+	g_address_space::map(virt, copy, DEFAULT_USER_TABLE_FLAGS, DEFAULT_USER_PAGE_FLAGS, true);
+	g_pp_reference_tracker::increment(copy);
+
+	if (g_pp_reference_tracker::decrement(shared) == 0) {
+		g_pp_allocator::free(shared);
+	}
+	return true;
+}
@@ -0,0 +1,94 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_FSMAPPINGS
+#define GHOST_FILESYSTEM_FSMAPPINGS
+
+#include "ghost/stdint.h"
+#include "ghost/fs.h"
+#include "memory/paging.hpp"
+#include "tasking/process.hpp"
+
+/**
+ * Maximum number of pages of a single file mapping.
+ */
+#define G_FS_MAPPING_MAXIMUM_PAGES			0x4000
+
+/**
+ * Page flags for mapped file pages that may not be written directly.
+ */
+#define G_FS_MAPPING_READ_ONLY_PAGE_FLAGS	(G_PAGE_PRESENT | G_PAGE_USERSPACE)
+
+/**
+ * Memory mappings of file contents into processes. Mapped pages are reference
+ * counted: the owner of the contents (the ramdisk or the page cache) holds a
+ * reference, and each mapping holds another one. Private mappings are mapped
+ * read-only and copied on the first write to a page.
+ *
+ * All functions operate on the current address space, which must be the one
+ * of the given process.
+ */
+class g_fs_mappings {
+public:
+
+	/**
+	 * Maps the given physical pages into the process. Takes over the references
+	 * that the caller holds on the pages.
+	 *
+	 * @return the base of the mapping or zero if there was no virtual range
+	 */
+	static g_virtual_address create(g_process* process, g_physical_address* pages, uint32_t count, g_fs_map_flags flags);
+
+	/**
+	 * Creates a mapping of zeroed, writable pages that are owned by the mapping.
+	 * Used when the contents of a file must be read into the mapping first.
+	 *
+	 * @return the base of the mapping or zero if out of memory
+	 */
+	static g_virtual_address create_anonymous(g_process* process, uint32_t count);
+
+	/**
+	 * Makes all pages of an anonymous mapping read-only.
+	 */
+	static void protect(g_process* process, g_virtual_address base);
+
+	/**
+	 * Unmaps the mapping that starts at the given base and drops its references.
+	 *
+	 * @return whether there was a file mapping at the base
+	 */
+	static bool release(g_process* process, g_virtual_address base);
+
+	/**
+	 * Unmaps the pages and drops their references, without freeing the range.
+	 */
+	static void release_pages(g_virtual_address base, uint32_t count);
+
+	/**
+	 * Handles a write to a page of a private mapping by giving the process a
+	 * copy of the page.
+	 *
+	 * @return whether the address was within a private mapping
+	 */
+	static bool handle_copy_on_write(g_process* process, g_virtual_address address);
+
+};
+
+#endif
@@ -0,0 +1,175 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_name_cache.hpp"
+#include "logger/logger.hpp"
+#include "memory/memory.hpp"
+
+static g_fs_name_cache_entry* buckets[G_FS_NAME_CACHE_BUCKETS] = { 0 };
+static g_fs_name_cache_statistics statistics = { 0, 0, 0, 0 };
+
+/**
+ *
+ */
+static uint32_t bucket_of(g_fs_virt_id parent_id, uint32_t hash) {
+	return (hash ^ (parent_id * 2654435761U)) % G_FS_NAME_CACHE_BUCKETS;
+}
+
+/**
+ *
+ */
+static void free_entry(g_fs_name_cache_entry* entry) {
+	delete[] entry->name;
+	delete entry;
+	--statistics.entries;
+}
+
+/**
+ * FNV-1a hash of the name.
+ */
+uint32_t g_fs_name_cache::hash(g_fs_path_slice* name) {
+
+	uint32_t hash = 2166136261U;
+	for (int i = 0; i < name->length; i++) {
+		hash ^= (uint8_t) name->start[i];
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+/**
+ *
+ */
+bool g_fs_name_cache::lookup(g_fs_node* parent, g_fs_path_slice* name, g_fs_node** out_node) {
+
+	uint32_t name_hash = hash(name);
+	g_fs_name_cache_entry* entry = buckets[bucket_of(parent->id, name_hash)];
+
+	while (entry) {
+		if (entry->parent_id == parent->id && entry->hash == name_hash && g_fs_path::equals(entry->name, name)) {
+			if (entry->node) {
+				++statistics.hits;
+			} else {
+				++statistics.negative_hits;
+			}
+			*out_node = entry->node;
+			return true;
+		}
+		entry = entry->next;
+	}
+
+	++statistics.misses;
+	return false;
+}
+
+/**
+ *
+ */
+void g_fs_name_cache::insert(g_fs_node* parent, g_fs_path_slice* name, g_fs_node* node) {
+
+	uint32_t name_hash = hash(name);
+	uint32_t bucket = bucket_of(parent->id, name_hash);
+
+	// replace an existing entry for the same name
+	invalidate(parent, name);
+
+	g_fs_name_cache_entry* entry = new g_fs_name_cache_entry();
+	entry->parent_id = parent->id;
+	entry->hash = name_hash;
+	entry->name = new char[name->length + 1];
+	g_memory::copy(entry->name, name->start, name->length);
+	entry->name[name->length] = 0;
+	entry->node = node;
+	entry->next = buckets[bucket];
+	buckets[bucket] = entry;
+	++statistics.entries;
+
+	if (node == 0) {
+		parent->has_negative_names = true;
+	}
+
+	// evict the oldest entries of a full bucket
+	int depth = 1;
+	g_fs_name_cache_entry* last = entry;
+	while (last->next) {
+		if (depth == G_FS_NAME_CACHE_BUCKET_DEPTH) {
+			g_fs_name_cache_entry* evicted = last->next;
+			last->next = evicted->next;
+			free_entry(evicted);
+		} else {
+			last = last->next;
+			++depth;
+		}
+	}
+}
+
+/**
+ *
+ */
+void g_fs_name_cache::invalidate(g_fs_node* parent, g_fs_path_slice* name) {
+
+	uint32_t name_hash = hash(name);
+	g_fs_name_cache_entry** pos = &buckets[bucket_of(parent->id, name_hash)];
+
+	while (*pos) {
+		g_fs_name_cache_entry* entry = *pos;
+		if (entry->parent_id == parent->id && entry->hash == name_hash && g_fs_path::equals(entry->name, name)) {
+			*pos = entry->next;
+			free_entry(entry);
+			return;
+		}
+		pos = &entry->next;
+	}
+}
+
+/**
+ *
+ */
+void g_fs_name_cache::invalidate_node(g_fs_node* node) {
+
+	for (uint32_t i = 0; i < G_FS_NAME_CACHE_BUCKETS; i++) {
+		g_fs_name_cache_entry** pos = &buckets[i];
+
+		while (*pos) {
+			g_fs_name_cache_entry* entry = *pos;
+			if (entry->parent_id == node->id || entry->node == node) {
+				*pos = entry->next;
+				free_entry(entry);
+			} else {
+				pos = &entry->next;
+			}
+		}
+	}
+}
+
+/**
+ *
+ */
+g_fs_name_cache_statistics g_fs_name_cache::get_statistics() {
+	return statistics;
+}
+
+/**
+ *
+ */
+void g_fs_name_cache::dump() {
+
+	g_log_info("%! %i hits, %i negative hits, %i misses, %i entries", "namecache", statistics.hits, statistics.negative_hits, statistics.misses, statistics.entries);
+}
@@ -0,0 +1,110 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_FSNAMECACHE
+#define GHOST_FILESYSTEM_FSNAMECACHE
+
+#include "ghost/stdint.h"
+#include "filesystem/fs_node.hpp"
+#include "filesystem/fs_path.hpp"
+
+/**
+ * Number of buckets in the name cache and maximum number of entries that
+ * are kept per bucket before the least recently inserted one is evicted.
+ */
+#define G_FS_NAME_CACHE_BUCKETS			1024
+#define G_FS_NAME_CACHE_BUCKET_DEPTH	4
+
+/**
+ * Entry in the name cache. A negative entry (node is 0) records that the
+ * parent has no child with the given name.
+ */
+struct g_fs_name_cache_entry {
+	g_fs_virt_id parent_id;
+	uint32_t hash;
+	char* name;
+	g_fs_node* node;
+
+	g_fs_name_cache_entry* next;
+};
+
+/**
+ * Lookup counters of the name cache.
+ */
+struct g_fs_name_cache_statistics {
+	uint32_t hits;
+	uint32_t negative_hits;
+	uint32_t misses;
+	uint32_t entries;
+};
+
+/**
+ * Global cache for child lookups in the virtual filesystem tree, keyed by
+ * the id of the parent node and the hash of the child name.
+ */
+class g_fs_name_cache {
+public:
+
+	/**
+	 * Looks up the child with the given name in the cache.
+	 *
+	 * @param parent	the parent node
+	 * @param name		the child name
+	 * @param out_node	is filled with the child, or 0 for a negative entry
+	 * @return whether an entry was found
+	 */
+	static bool lookup(g_fs_node* parent, g_fs_path_slice* name, g_fs_node** out_node);
+
+	/**
+	 * Stores the result of a lookup. Passing 0 as the node creates a
+	 * negative entry.
+	 */
+	static void insert(g_fs_node* parent, g_fs_path_slice* name, g_fs_node* node);
+
+	/**
+	 * Removes the entry for the name below the parent, if any. Must be called
+	 * whenever a child is added to or removed from the parent.
+	 */
+	static void invalidate(g_fs_node* parent, g_fs_path_slice* name);
+
+	/**
+	 * Removes all entries that have the node as their parent or child. This walks
+	 * the whole cache, removing a single name with {invalidate} is preferred.
+	 */
+	static void invalidate_node(g_fs_node* node);
+
+	/**
+	 *
+	 */
+	static g_fs_name_cache_statistics get_statistics();
+
+	/**
+	 * Writes the lookup counters to the log.
+	 */
+	static void dump();
+
+	/**
+	 *
+	 */
+	static uint32_t hash(g_fs_path_slice* name);
+
+};
+
+#endif
@@ -19,13 +19,18 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "filesystem/fs_node.hpp"
+#include "filesystem/fs_name_cache.hpp"
+#include "filesystem/fs_node_cache.hpp"
+#include "filesystem/fs_delegate.hpp"
 #include "utils/string.hpp"
+#include "tasking/tasking.hpp"
 
 /**
  *
  */
 g_fs_node::g_fs_node() :
-		delegate(0), type(G_FS_NODE_TYPE_NONE), id(0), phys_fs_id(0), name(0), parent(0), children(0), is_blocking(true) {
+		delegate(0), type(G_FS_NODE_TYPE_NONE), id(0), phys_fs_id(0), name(0), parent(0), children(0), is_blocking(true), has_negative_names(false), length(0), attributes_expiry(0),
+		modified(0), attributes_ttl(G_FS_ATTRIBUTES_TTL_DELEGATE), pins(0), evictable(false), lru_previous(0), lru_next(0), last_used(0) {
 }
 
 /**
@@ -33,15 +38,117 @@ g_fs_node::g_fs_node() :
  */
 g_fs_node* g_fs_node::find_child(char* name) {
 
+	g_fs_path_slice element = { name, g_string::length(name) };
+	return find_child(&element);
+}
+
+/**
+ *
+ */
+g_fs_node* g_fs_node::find_child(g_fs_path_slice* name) {
+
+	g_fs_node* cached;
+	if (g_fs_name_cache::lookup(this, name, &cached)) {
+		if (cached) {
+			g_fs_node_cache::touch(cached);
+		}
+		return cached;
+	}
+
+	g_fs_node* found = 0;
 	g_list_entry<g_fs_node*>* n = children;
 	while (n) {
-		if (n->value->name != 0 && g_string::equals(n->value->name, name)) {
-			return n->value;
+		if (n->value->name != 0 && g_fs_path::equals(n->value->name, name)) {
+			found = n->value;
+			break;
 		}
 		n = n->next;
 	}
 
-	return 0;
+	// remember the result, a miss is stored as a negative entry
+	g_fs_name_cache::insert(this, name, found);
+	if (found) {
+		g_fs_node_cache::touch(found);
+	}
+	return found;
+}
+
+/**
+ *
+ */
+bool g_fs_node::get_cached_length(int64_t* out_length) {
+
+	if (attributes_expiry == 0) {
+		return false;
+	}
+	if (attributes_expiry != G_FS_ATTRIBUTES_EXPIRY_NEVER && attributes_expiry <= g_tasking::getCurrentScheduler()->getMilliseconds()) {
+		attributes_expiry = 0;
+		return false;
+	}
+
+	*out_length = length;
+	return true;
+}
+
+/**
+ *
+ */
+void g_fs_node::cache_length(int64_t new_length) {
+
+	g_fs_attributes_ttl ttl = attributes_ttl;
+	if (ttl == G_FS_ATTRIBUTES_TTL_DELEGATE) {
+		g_fs_delegate* node_delegate = get_delegate();
+		ttl = node_delegate ? node_delegate->get_attributes_ttl() : G_FS_ATTRIBUTES_TTL_NONE;
+	}
+
+	length = new_length;
+	if (ttl == G_FS_ATTRIBUTES_TTL_NONE) {
+		attributes_expiry = 0;
+	} else if (ttl == G_FS_ATTRIBUTES_TTL_AUTHORITATIVE) {
+		attributes_expiry = G_FS_ATTRIBUTES_EXPIRY_NEVER;
+	} else {
+		attributes_expiry = g_tasking::getCurrentScheduler()->getMilliseconds() + ttl;
+	}
+}
+
+/**
+ * A write can only make the node longer, a valid cached length is therefore
+ * kept up to date without asking the delegate.
+ */
+void g_fs_node::written(int64_t end) {
+
+	modified = g_tasking::getCurrentScheduler()->getMilliseconds();
+
+	int64_t cached;
+	if (get_cached_length(&cached) && end > cached) {
+		length = end;
+	}
+}
+
+/**
+ *
+ */
+void g_fs_node::invalidate_attributes() {
+	attributes_expiry = 0;
+}
+
+/**
+ *
+ */
+void g_fs_node::pin() {
+	++pins;
+}
+
+/**
+ * The node is marked as used when it is released, so that it is not evicted
+ * right after being closed.
+ */
+void g_fs_node::unpin() {
+
+	if (pins > 0) {
+		--pins;
+	}
+	g_fs_node_cache::touch(this);
 }
 
 /**
@@ -72,9 +179,45 @@ void g_fs_node::add_child(g_fs_node* child) {
 
 	child->parent = this;
 
+	// drop a negative entry that may exist for this name
+	if (child->name) {
+		g_fs_path_slice name = { child->name, g_string::length(child->name) };
+		g_fs_name_cache::invalidate(this, &name);
+	}
+
 	g_list_entry<g_fs_node*>* entry = new g_list_entry<g_fs_node*>();
 	entry->value = child;
 
 	entry->next = children;
 	children = entry;
+
+	g_fs_node_cache::linked(child);
+}
+
+/**
+ *
+ */
+void g_fs_node::remove_child(g_fs_node* child) {
+
+	g_list_entry<g_fs_node*>** pos = &children;
+	while (*pos) {
+		g_list_entry<g_fs_node*>* entry = *pos;
+		if (entry->value == child) {
+			*pos = entry->next;
+			delete entry;
+			break;
+		}
+		pos = &entry->next;
+	}
+
+	child->parent = 0;
+
+	// only evicted leaves are removed, so no entries below the child have a node
+	if (child->name) {
+		g_fs_path_slice name = { child->name, g_string::length(child->name) };
+		g_fs_name_cache::invalidate(this, &name);
+	}
+	if (child->has_negative_names) {
+		g_fs_name_cache::invalidate_node(child);
+	}
 }
@@ -24,9 +24,20 @@
 #include "ghost/stdint.h"
 #include "ghost/fs.h"
 #include "utils/list_entry.hpp"
+#include "filesystem/fs_path.hpp"
 
 class g_fs_delegate;
 
+/**
+ * Time-to-live of a node that uses the default of its delegate
+ */
+#define G_FS_ATTRIBUTES_TTL_DELEGATE	((g_fs_attributes_ttl) -2)
+
+/**
+ * Expiry time of authoritative attributes
+ */
+#define G_FS_ATTRIBUTES_EXPIRY_NEVER	((uint64_t) -1)
+
 /**
  *
  */
@@ -48,10 +59,68 @@ public:
 	g_fs_node* parent;
 	g_list_entry<g_fs_node*>* children;
 	void add_child(g_fs_node* child);
+	void remove_child(g_fs_node* child);
 
 	bool is_blocking;
 
 	g_fs_node* find_child(char* name);
+
+	/**
+	 * Looks up the child with the name given by the path element.
+	 */
+	g_fs_node* find_child(g_fs_path_slice* name);
+
+	/**
+	 * Whether the name cache may hold negative entries for names below this node.
+	 */
+	bool has_negative_names;
+
+	/**
+	 * Cached attributes. The length is valid until the expiry time (in milliseconds
+	 * since boot), which is G_FS_ATTRIBUTES_EXPIRY_NEVER for authoritative attributes.
+	 */
+	int64_t length;
+	uint64_t attributes_expiry;
+	uint64_t modified;
+	g_fs_attributes_ttl attributes_ttl;
+
+	/**
+	 * Returns whether the cached length is still valid and writes it to the out parameter.
+	 */
+	bool get_cached_length(int64_t* out_length);
+
+	/**
+	 * Caches the length for the time-to-live of this node, or the default of the delegate.
+	 */
+	void cache_length(int64_t length);
+
+	/**
+	 * Updates the cached attributes after a write through the kernel that ended at
+	 * the given offset.
+	 */
+	void written(int64_t end);
+
+	/**
+	 * Drops the cached attributes.
+	 */
+	void invalidate_attributes();
+
+	/**
+	 * Number of file descriptors and working directories that refer to this node.
+	 * Pinned nodes are never evicted from the tree.
+	 */
+	uint32_t pins;
+	void pin();
+	void unpin();
+
+	/**
+	 * Position in the least recently used list of the node cache, only valid
+	 * while the node is evictable.
+	 */
+	bool evictable;
+	g_fs_node* lru_previous;
+	g_fs_node* lru_next;
+	uint64_t last_used;
 };
 
 #endif
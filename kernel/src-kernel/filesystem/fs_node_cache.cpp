@@ -0,0 +1,208 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_node_cache.hpp"
+#include "filesystem/fs_delegate.hpp"
+#include "filesystem/filesystem.hpp"
+#include "tasking/tasking.hpp"
+#include "utils/string.hpp"
+#include "logger/logger.hpp"
+
+static g_fs_node_cache_statistics statistics = { 0, 0, 0, 0 };
+
+/**
+ * Least recently used nodes are at the head, recently used at the tail.
+ */
+static g_fs_node* lru_head = 0;
+static g_fs_node* lru_tail = 0;
+
+/**
+ *
+ */
+static uint32_t linked_memory(g_fs_node* node) {
+
+	uint32_t memory = sizeof(g_list_entry<g_fs_node*> );
+	if (node->name) {
+		memory += g_string::length(node->name) + 1;
+	}
+	return memory;
+}
+
+/**
+ *
+ */
+static void lru_append(g_fs_node* node) {
+
+	node->lru_previous = lru_tail;
+	node->lru_next = 0;
+	if (lru_tail) {
+		lru_tail->lru_next = node;
+	} else {
+		lru_head = node;
+	}
+	lru_tail = node;
+}
+
+/**
+ *
+ */
+static void lru_remove(g_fs_node* node) {
+
+	if (node->lru_previous) {
+		node->lru_previous->lru_next = node->lru_next;
+	} else {
+		lru_head = node->lru_next;
+	}
+	if (node->lru_next) {
+		node->lru_next->lru_previous = node->lru_previous;
+	} else {
+		lru_tail = node->lru_previous;
+	}
+	node->lru_previous = 0;
+	node->lru_next = 0;
+}
+
+/**
+ * Unlinks the node from its parent and deletes it. The delegate discovers
+ * it again when it is accessed the next time.
+ */
+static void evict(g_fs_node* node) {
+
+	lru_remove(node);
+	node->evictable = false;
+	--statistics.evictable;
+	++statistics.evictions;
+
+	g_fs_node_cache::destroy(node);
+}
+
+/**
+ * Walks the nodes from the least recently used one and evicts those that are
+ * unpinned leaves, stopping at the first node that is younger than the minimum age.
+ */
+static uint32_t evict_unused(uint32_t count) {
+
+	uint64_t now = g_tasking::getCurrentScheduler()->getMilliseconds();
+	uint32_t evicted = 0;
+
+	g_fs_node* node = lru_head;
+	while (node && evicted < count) {
+		if (now - node->last_used < G_FS_NODE_CACHE_MINIMUM_AGE) {
+			break;
+		}
+
+		g_fs_node* next = node->lru_next;
+		if (node->pins == 0 && node->children == 0) {
+			evict(node);
+			++evicted;
+		}
+		node = next;
+	}
+	return evicted;
+}
+
+/**
+ *
+ */
+void g_fs_node_cache::created(g_fs_node* node) {
+
+	++statistics.nodes;
+	statistics.memory += sizeof(g_fs_node);
+}
+
+/**
+ * Mountpoints, pipes and events are never evicted, neither are nodes of delegates
+ * that could not discover them again with the same id.
+ */
+void g_fs_node_cache::linked(g_fs_node* node) {
+
+	statistics.memory += linked_memory(node);
+
+	if (node->type == G_FS_NODE_TYPE_FILE || node->type == G_FS_NODE_TYPE_FOLDER) {
+		g_fs_delegate* delegate = node->get_delegate();
+
+		if (delegate && delegate->can_evict_nodes()) {
+			node->evictable = true;
+			node->last_used = g_tasking::getCurrentScheduler()->getMilliseconds();
+			lru_append(node);
+			++statistics.evictable;
+		}
+	}
+
+	if (statistics.nodes > G_FS_NODE_CACHE_MAXIMUM_NODES) {
+		evict_unused(statistics.nodes - G_FS_NODE_CACHE_MAXIMUM_NODES);
+	}
+}
+
+/**
+ *
+ */
+void g_fs_node_cache::destroy(g_fs_node* node) {
+
+	statistics.memory -= linked_memory(node) + sizeof(g_fs_node);
+	--statistics.nodes;
+
+	node->parent->remove_child(node);
+	g_filesystem::remove_node(node);
+
+	if (node->name) {
+		delete[] node->name;
+	}
+	delete node;
+}
+
+/**
+ *
+ */
+void g_fs_node_cache::touch(g_fs_node* node) {
+
+	if (!node->evictable) {
+		return;
+	}
+
+	node->last_used = g_tasking::getCurrentScheduler()->getMilliseconds();
+	if (node != lru_tail) {
+		lru_remove(node);
+		lru_append(node);
+	}
+}
+
+/**
+ *
+ */
+uint32_t g_fs_node_cache::shrink(uint32_t nodes) {
+	return evict_unused(nodes);
+}
+
+/**
+ *
+ */
+g_fs_node_cache_statistics g_fs_node_cache::get_statistics() {
+	return statistics;
+}
+
+/**
+ *
+ */
+void g_fs_node_cache::dump() {
+
+	g_log_info("%! %i nodes, %i evictable, %i evictions, %i bytes", "nodecache", statistics.nodes, statistics.evictable, statistics.evictions,
+			statistics.memory);
+}
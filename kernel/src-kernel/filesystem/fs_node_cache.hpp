@@ -0,0 +1,97 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_FSNODECACHE
+#define GHOST_FILESYSTEM_FSNODECACHE
+
+#include "ghost/stdint.h"
+#include "filesystem/fs_node.hpp"
+
+/**
+ * Number of virtual nodes above which unused nodes are evicted from the tree, and
+ * the time in milliseconds that a node must have been unused before it may be evicted.
+ * The minimum age keeps nodes alive that were just discovered and are still referred
+ * to by the operation that discovered them.
+ */
+#define G_FS_NODE_CACHE_MAXIMUM_NODES	4096
+#define G_FS_NODE_CACHE_MINIMUM_AGE		1000
+
+/**
+ * Counters of the node cache. The memory is an estimate of the kernel heap used
+ * by the nodes, their names and the entries that link them to their parents.
+ */
+struct g_fs_node_cache_statistics {
+	uint32_t nodes;
+	uint32_t evictable;
+	uint32_t evictions;
+	uint32_t memory;
+};
+
+/**
+ * Keeps the number of virtual nodes in the filesystem tree bounded. Nodes of delegates
+ * that can discover them again are kept in a least recently used list; once there are
+ * more nodes than {G_FS_NODE_CACHE_MAXIMUM_NODES}, the oldest of them that are leaves
+ * of the tree and not pinned by a file descriptor or a working directory are evicted.
+ */
+class g_fs_node_cache {
+public:
+
+	/**
+	 * Counts a node that was created.
+	 */
+	static void created(g_fs_node* node);
+
+	/**
+	 * Called once the node was linked to its parent. The node becomes evictable if its
+	 * delegate allows it, then nodes are evicted if the tree has grown too large.
+	 */
+	static void linked(g_fs_node* node);
+
+	/**
+	 * Unlinks a node that is not evictable from its parent and deletes it. Used for
+	 * nodes whose object is gone, like events that are no longer referenced.
+	 */
+	static void destroy(g_fs_node* node);
+
+	/**
+	 * Marks the node as recently used.
+	 */
+	static void touch(g_fs_node* node);
+
+	/**
+	 * Evicts up to the given number of least recently used nodes.
+	 *
+	 * @return the number of nodes that were evicted
+	 */
+	static uint32_t shrink(uint32_t nodes);
+
+	/**
+	 *
+	 */
+	static g_fs_node_cache_statistics get_statistics();
+
+	/**
+	 * Writes the counters to the log.
+	 */
+	static void dump();
+
+};
+
+#endif
@@ -0,0 +1,407 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_page_cache.hpp"
+#include "memory/physical/pp_allocator.hpp"
+#include "memory/physical/pp_reference_tracker.hpp"
+#include "memory/address_space.hpp"
+#include "kernel.hpp"
+#include "memory/memory.hpp"
+#include "logger/logger.hpp"
+
+static g_fs_cached_page* buckets[G_FS_PAGE_CACHE_BUCKETS] = { 0 };
+static g_fs_page_cache_statistics statistics = { 0, 0, 0, 0 };
+
+/**
+ * Least recently used pages are at the head, recently used at the tail.
+ */
+static g_fs_cached_page* lru_head = 0;
+static g_fs_cached_page* lru_tail = 0;
+
+/**
+ *
+ */
+static uint32_t bucket_of(g_fs_virt_id node_id, uint64_t index) {
+	return (uint32_t) ((node_id * 2654435761U) ^ index) % G_FS_PAGE_CACHE_BUCKETS;
+}
+
+/**
+ *
+ */
+static void lru_remove(g_fs_cached_page* page) {
+
+	if (page->lru_previous) {
+		page->lru_previous->lru_next = page->lru_next;
+	} else {
+		lru_head = page->lru_next;
+	}
+	if (page->lru_next) {
+		page->lru_next->lru_previous = page->lru_previous;
+	} else {
+		lru_tail = page->lru_previous;
+	}
+	page->lru_previous = 0;
+	page->lru_next = 0;
+}
+
+/**
+ *
+ */
+static void lru_append(g_fs_cached_page* page) {
+
+	page->lru_previous = lru_tail;
+	page->lru_next = 0;
+	if (lru_tail) {
+		lru_tail->lru_next = page;
+	} else {
+		lru_head = page;
+	}
+	lru_tail = page;
+}
+
+/**
+ *
+ */
+static g_fs_cached_page* find(g_fs_virt_id node_id, uint64_t index) {
+
+	g_fs_cached_page* page = buckets[bucket_of(node_id, index)];
+	while (page) {
+		if (page->node_id == node_id && page->index == index) {
+			return page;
+		}
+		page = page->next_in_bucket;
+	}
+	return 0;
+}
+
+/**
+ * Takes the page out of its bucket and the LRU list.
+ */
+static void detach(g_fs_cached_page* page) {
+
+	g_fs_cached_page** pos = &buckets[bucket_of(page->node_id, page->index)];
+	while (*pos) {
+		if (*pos == page) {
+			*pos = page->next_in_bucket;
+			break;
+		}
+		pos = &(*pos)->next_in_bucket;
+	}
+	lru_remove(page);
+}
+
+/**
+ * Gives the page a physical page of its own and maps it into the kernel.
+ */
+static bool allocate_frame(g_fs_cached_page* page) {
+
+	g_physical_address physical = g_pp_allocator::allocate();
+	if (physical == 0) {
+		return false;
+	}
+
+	g_virtual_address virt = g_kernel_virt_addr_ranges->allocate(1);
+	if (virt == 0) {
+		g_pp_allocator::free(physical);
+		return false;
+	}
+
+	g_address_space::map(virt, physical, DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+	g_pp_reference_tracker::increment(physical);
+
+	page->data = (uint8_t*) virt;
+	page->physical = physical;
+	return true;
+}
+
+/**
+ * Drops the reference of the cache on the physical page. The physical page is
+ * only freed if no mapping uses it anymore.
+ */
+static void release_frame(g_fs_cached_page* page) {
+
+	g_address_space::unmap((g_virtual_address) page->data);
+	g_kernel_virt_addr_ranges->free((g_virtual_address) page->data);
+
+	if (g_pp_reference_tracker::decrement(page->physical) == 0) {
+		g_pp_allocator::free(page->physical);
+	}
+
+	page->data = 0;
+	page->physical = 0;
+}
+
+/**
+ *
+ */
+static void destroy(g_fs_cached_page* page) {
+
+	detach(page);
+	release_frame(page);
+	delete page;
+	--statistics.pages;
+}
+
+/**
+ * Provides a page for the given position, recycling the least recently used page
+ * if the cache is full or physical memory is getting low.
+ */
+static g_fs_cached_page* obtain(g_fs_virt_id node_id, uint64_t index) {
+
+	g_fs_cached_page* page;
+	bool low_memory = g_pp_allocator::getFreePageCount() < G_FS_PAGE_CACHE_MINIMUM_FREE_PAGES;
+
+	if ((statistics.pages >= G_FS_PAGE_CACHE_MAXIMUM_PAGES || low_memory) && lru_head) {
+		page = lru_head;
+		detach(page);
+		++statistics.evictions;
+
+		// the old physical page might still be mapped, so it is not reused
+		release_frame(page);
+		if (!allocate_frame(page)) {
+			delete page;
+			--statistics.pages;
+			return 0;
+		}
+
+	} else if (low_memory) {
+		return 0;
+
+	} else {
+		page = new g_fs_cached_page();
+		if (!allocate_frame(page)) {
+			delete page;
+			return 0;
+		}
+		++statistics.pages;
+	}
+
+	page->node_id = node_id;
+	page->index = index;
+	page->length = 0;
+
+	uint32_t bucket = bucket_of(node_id, index);
+	page->next_in_bucket = buckets[bucket];
+	buckets[bucket] = page;
+	lru_append(page);
+	return page;
+}
+
+/**
+ *
+ */
+bool g_fs_page_cache::read(g_fs_virt_id node_id, int64_t offset, int64_t length, uint8_t* target, int64_t* out_read) {
+
+	if (offset < 0 || length <= 0) {
+		++statistics.misses;
+		return false;
+	}
+
+	// check that the entire range is available first
+	int64_t end = offset + length;
+	int64_t position = offset;
+	while (position < end) {
+		g_fs_cached_page* page = find(node_id, position / G_PAGE_SIZE);
+		if (page == 0) {
+			++statistics.misses;
+			return false;
+		}
+
+		int64_t page_end = (position / G_PAGE_SIZE) * G_PAGE_SIZE + page->length;
+		if (page->length < G_PAGE_SIZE) {
+			// the file ends within this page
+			if (page_end < end) {
+				end = (page_end > offset) ? page_end : offset;
+			}
+			break;
+		}
+		position = page_end;
+	}
+
+	// copy the data
+	position = offset;
+	while (position < end) {
+		g_fs_cached_page* page = find(node_id, position / G_PAGE_SIZE);
+		uint32_t offset_in_page = position % G_PAGE_SIZE;
+		int64_t copy_amount = G_PAGE_SIZE - offset_in_page;
+		if (copy_amount > end - position) {
+			copy_amount = end - position;
+		}
+
+		g_memory::copy(&target[position - offset], &page->data[offset_in_page], copy_amount);
+		position += copy_amount;
+
+		lru_remove(page);
+		lru_append(page);
+	}
+
+	++statistics.hits;
+	*out_read = end - offset;
+	return true;
+}
+
+/**
+ *
+ */
+void g_fs_page_cache::fill(g_fs_virt_id node_id, int64_t offset, uint8_t* data, int64_t length, bool eof) {
+
+	if (offset < 0 || length <= 0) {
+		return;
+	}
+
+	int64_t end = offset + length;
+	uint64_t index = (offset + G_PAGE_SIZE - 1) / G_PAGE_SIZE;
+
+	while (true) {
+		int64_t page_start = index * G_PAGE_SIZE;
+		if (page_start >= end) {
+			break;
+		}
+
+		// only the last page of the file may be stored partially
+		uint32_t page_length = G_PAGE_SIZE;
+		if (page_start + G_PAGE_SIZE > end) {
+			if (!eof) {
+				break;
+			}
+			page_length = end - page_start;
+		}
+
+		g_fs_cached_page* page = find(node_id, index);
+		if (page) {
+			lru_remove(page);
+			lru_append(page);
+		} else {
+			page = obtain(node_id, index);
+			if (page == 0) {
+				break;
+			}
+		}
+
+		g_memory::copy(page->data, &data[page_start - offset], page_length);
+		if (page_length < G_PAGE_SIZE) {
+			g_memory::setBytes(&page->data[page_length], 0, G_PAGE_SIZE - page_length);
+		}
+		page->length = page_length;
+		++index;
+	}
+}
+
+/**
+ *
+ */
+bool g_fs_page_cache::acquire(g_fs_virt_id node_id, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+		uint32_t* out_count, int64_t* out_length) {
+
+	if (offset < 0 || length <= 0 || capacity == 0) {
+		++statistics.misses;
+		return false;
+	}
+	if (length > (int64_t) capacity * G_PAGE_SIZE - offset % G_PAGE_SIZE) {
+		length = (int64_t) capacity * G_PAGE_SIZE - offset % G_PAGE_SIZE;
+	}
+
+	// check that the entire range is available first
+	uint64_t first = offset / G_PAGE_SIZE;
+	uint64_t last = (offset + length - 1) / G_PAGE_SIZE;
+	uint64_t end = offset + length;
+	for (uint64_t index = first; index <= last; index++) {
+		g_fs_cached_page* page = find(node_id, index);
+		if (page == 0) {
+			++statistics.misses;
+			return false;
+		}
+
+		// the file ends within this page
+		if (page->length < G_PAGE_SIZE) {
+			if (index * G_PAGE_SIZE + page->length <= (uint64_t) offset) {
+				++statistics.misses;
+				return false;
+			}
+			last = index;
+			if (index * G_PAGE_SIZE + page->length < end) {
+				end = index * G_PAGE_SIZE + page->length;
+			}
+			break;
+		}
+	}
+
+	uint32_t count = 0;
+	for (uint64_t index = first; index <= last; index++) {
+		g_fs_cached_page* page = find(node_id, index);
+		g_pp_reference_tracker::increment(page->physical);
+		out_pages[count++] = page->physical;
+
+		lru_remove(page);
+		lru_append(page);
+	}
+
+	++statistics.hits;
+	*out_count = count;
+	*out_length = end - offset;
+	return true;
+}
+
+/**
+ *
+ */
+void g_fs_page_cache::invalidate(g_fs_virt_id node_id, int64_t offset, int64_t length) {
+
+	uint64_t first = offset / G_PAGE_SIZE;
+	uint64_t last = (length < 0) ? (uint64_t) -1 : (offset + length - 1) / G_PAGE_SIZE;
+
+	g_fs_cached_page* page = lru_head;
+	while (page) {
+		g_fs_cached_page* next = page->lru_next;
+		if (page->node_id == node_id && page->index >= first && page->index <= last) {
+			destroy(page);
+		}
+		page = next;
+	}
+}
+
+/**
+ *
+ */
+uint32_t g_fs_page_cache::shrink(uint32_t pages) {
+
+	uint32_t freed = 0;
+	while (freed < pages && lru_head) {
+		destroy(lru_head);
+		++statistics.evictions;
+		++freed;
+	}
+	return freed;
+}
+
+/**
+ *
+ */
+g_fs_page_cache_statistics g_fs_page_cache::get_statistics() {
+	return statistics;
+}
+
+/**
+ *
+ */
+void g_fs_page_cache::dump() {
+
+	g_log_info("%! %i hits, %i misses, %i evictions, %i pages", "pagecache", statistics.hits, statistics.misses, statistics.evictions, statistics.pages);
+}
@@ -0,0 +1,148 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_FSPAGECACHE
+#define GHOST_FILESYSTEM_FSPAGECACHE
+
+#include "ghost/stdint.h"
+#include "ghost/fs.h"
+#include "memory/paging.hpp"
+
+/**
+ * Number of hash buckets and maximum number of pages held by the page cache.
+ * When fewer than {G_FS_PAGE_CACHE_MINIMUM_FREE_PAGES} physical pages are left,
+ * the cache stops growing and recycles its least recently used pages instead.
+ */
+#define G_FS_PAGE_CACHE_BUCKETS				512
+#define G_FS_PAGE_CACHE_MAXIMUM_PAGES		1024
+#define G_FS_PAGE_CACHE_MINIMUM_FREE_PAGES	256
+
+/**
+ * A cached page of a node. The length is smaller than the page size only for
+ * the last page of a file, the file ends behind its last valid byte and the
+ * rest of the page is zeroed.
+ *
+ * Each page is a physical page of its own that is mapped into the kernel at
+ * {data}. The cache holds a reference on it, mappings of the file take further
+ * references, so a page that is dropped from the cache stays alive as long as
+ * it is mapped somewhere.
+ */
+struct g_fs_cached_page {
+	g_fs_virt_id node_id;
+	uint64_t index;
+	uint32_t length;
+	uint8_t* data;
+	g_physical_address physical;
+
+	g_fs_cached_page* next_in_bucket;
+	g_fs_cached_page* lru_previous;
+	g_fs_cached_page* lru_next;
+};
+
+/**
+ * Counters of the page cache.
+ */
+struct g_fs_page_cache_statistics {
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t evictions;
+	uint32_t pages;
+};
+
+/**
+ * Kernel page cache for the contents of nodes that are served by tasked delegates,
+ * indexed by the virtual node id and the page index within the node. Pages are filled
+ * from the results of finished read transactions, so repeated reads can be served
+ * without a round-trip to the delegate.
+ */
+class g_fs_page_cache {
+public:
+
+	/**
+	 * Copies the requested range to the target if it is entirely cached. The range is
+	 * cut at the end of the file when the last page of the file is cached.
+	 *
+	 * @param node_id	the node to read from
+	 * @param offset	offset within the node
+	 * @param length	number of bytes to read
+	 * @param target	the target buffer, must be accessible in the current space
+	 * @param out_read	is filled with the number of bytes read
+	 * @return whether the read could be served from the cache
+	 */
+	static bool read(g_fs_virt_id node_id, int64_t offset, int64_t length, uint8_t* target, int64_t* out_read);
+
+	/**
+	 * Stores the result of a finished read in the cache. Only pages that are covered
+	 * entirely by the data are stored, or partially if the read reached the end of
+	 * the file.
+	 *
+	 * @param node_id	the node that was read
+	 * @param offset	offset that was read from
+	 * @param data		the data that was read, must be accessible in the current space
+	 * @param length	number of bytes that were read
+	 * @param eof		whether the read is known to have ended at the end of the file,
+	 * 					only then a partial last page is stored
+	 */
+	static void fill(g_fs_virt_id node_id, int64_t offset, uint8_t* data, int64_t length, bool eof);
+
+	/**
+	 * Takes a reference on each physical page that holds the range, if the range is
+	 * entirely cached. The range is cut at the end of the file when the last page of
+	 * the file is cached.
+	 *
+	 * @param node_id	the node to map
+	 * @param offset	offset within the node
+	 * @param length	number of bytes to map
+	 * @param out_pages	is filled with the physical pages
+	 * @param capacity	number of entries in out_pages, the range is cut so that
+	 * 					its pages fit
+	 * @param out_count	is filled with the number of pages
+	 * @param out_length	is filled with the length of the range after cutting it
+	 * @return whether the range was available
+	 */
+	static bool acquire(g_fs_virt_id node_id, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+			uint32_t* out_count, int64_t* out_length);
+
+	/**
+	 * Drops all cached pages of the node that overlap with the range. A negative
+	 * length drops all pages of the node.
+	 */
+	static void invalidate(g_fs_virt_id node_id, int64_t offset = 0, int64_t length = -1);
+
+	/**
+	 * Frees up to the given number of least recently used pages.
+	 *
+	 * @return the number of pages that were freed
+	 */
+	static uint32_t shrink(uint32_t pages);
+
+	/**
+	 *
+	 */
+	static g_fs_page_cache_statistics get_statistics();
+
+	/**
+	 * Writes the counters to the log.
+	 */
+	static void dump();
+
+};
+
+#endif
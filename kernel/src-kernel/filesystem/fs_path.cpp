@@ -0,0 +1,77 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_path.hpp"
+
+/**
+ *
+ */
+const char* g_fs_path::skip_separators(const char* position) {
+
+	while (*position == '/') {
+		++position;
+	}
+	return position;
+}
+
+/**
+ *
+ */
+bool g_fs_path::next_element(const char** position, g_fs_path_slice* out) {
+
+	const char* start = skip_separators(*position);
+
+	int length = 0;
+	while (start[length] != 0 && start[length] != '/') {
+		++length;
+	}
+
+	out->start = start;
+	out->length = length;
+	*position = start + length;
+	return length > 0;
+}
+
+/**
+ *
+ */
+bool g_fs_path::is_current(g_fs_path_slice* element) {
+	return element->length == 1 && element->start[0] == '.';
+}
+
+/**
+ *
+ */
+bool g_fs_path::is_parent(g_fs_path_slice* element) {
+	return element->length == 2 && element->start[0] == '.' && element->start[1] == '.';
+}
+
+/**
+ *
+ */
+bool g_fs_path::equals(const char* name, g_fs_path_slice* element) {
+
+	for (int i = 0; i < element->length; i++) {
+		if (name[i] != element->start[i]) {
+			return false;
+		}
+	}
+	return name[element->length] == 0;
+}
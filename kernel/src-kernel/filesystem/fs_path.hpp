@@ -0,0 +1,73 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_FSPATH
+#define GHOST_FILESYSTEM_FSPATH
+
+#include "ghost/stdint.h"
+
+/**
+ * Part of a path string that is not null-terminated, used to walk paths
+ * without copying their elements.
+ */
+struct g_fs_path_slice {
+	const char* start;
+	int length;
+};
+
+/**
+ *
+ */
+class g_fs_path {
+public:
+
+	/**
+	 * Reads the next element of a path. Separating slashes are skipped, the
+	 * position is moved behind the element.
+	 *
+	 * @param position	current position in the path
+	 * @param out		is filled with the element
+	 * @return whether an element was found
+	 */
+	static bool next_element(const char** position, g_fs_path_slice* out);
+
+	/**
+	 * Skips the slashes at the given position.
+	 */
+	static const char* skip_separators(const char* position);
+
+	/**
+	 * @return whether the element is "."
+	 */
+	static bool is_current(g_fs_path_slice* element);
+
+	/**
+	 * @return whether the element is ".."
+	 */
+	static bool is_parent(g_fs_path_slice* element);
+
+	/**
+	 * Compares a null-terminated name with the element.
+	 */
+	static bool equals(const char* name, g_fs_path_slice* element);
+
+};
+
+#endif
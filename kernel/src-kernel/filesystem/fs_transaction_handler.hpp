@@ -25,6 +25,7 @@
 #include "tasking/thread.hpp"
 
 class g_fs_delegate;
+class g_wait_queue;
 
 /**
  * Status for waiter
@@ -57,6 +58,7 @@ const g_fs_transaction_handler_start_status G_FS_TRANSACTION_STARTED_WITH_WAITER
 class g_fs_transaction_handler {
 private:
 	g_fs_transaction_id repeat_transaction = G_FS_TRANSACTION_NO_REPEAT_ID;
+	g_wait_queue* repeat_queue = 0;
 
 public:
 	virtual ~g_fs_transaction_handler() {
@@ -90,6 +92,22 @@ public:
 		return this->repeat_transaction;
 	}
 
+	/**
+	 * A delegate that sets the transaction to repeat can name the queue that is
+	 * woken once repeating may succeed. The waiter then sleeps on this queue
+	 * instead of repeating the transaction every time the thread is scheduled.
+	 */
+	void repeat_on_wake(g_wait_queue* queue) {
+		this->repeat_queue = queue;
+	}
+
+	/**
+	 *
+	 */
+	g_wait_queue* get_repeat_queue() {
+		return this->repeat_queue;
+	}
+
 	/**
 	 *
 	 */
@@ -24,6 +24,15 @@
 
 #include "logger/logger.hpp"
 
+/**
+ *
+ */
+g_fs_transaction_handler_start_status g_fs_transaction_handler_discovery::start_transaction(g_thread* thread) {
+
+	g_filesystem::discover_path(thread, base, path, this);
+	return G_FS_TRANSACTION_STARTED_WITH_WAITER;
+}
+
 /**
  *
  */
@@ -39,8 +48,9 @@ g_fs_transaction_handler_status g_fs_transaction_handler_discovery::finish_trans
 
 		// if discovering the next node was successful, go on with discovering
 		if (status == G_FS_DISCOVERY_SUCCESSFUL) {
+			prepare_transaction_repeat(G_FS_TRANSACTION_NO_REPEAT_ID);
 
-			bool entire_path_discovered = g_filesystem::discover_absolute_path(thread, absolute_path, this);
+			bool entire_path_discovered = g_filesystem::discover_path(thread, base, path, this);
 			if (!entire_path_discovered) {
 				return G_FS_TRANSACTION_HANDLING_KEEP_WAITING;
 			}
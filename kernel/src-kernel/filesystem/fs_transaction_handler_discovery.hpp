@@ -34,27 +34,49 @@ class g_fs_transaction_handler_discovery: public g_fs_transaction_handler {
 public:
 	g_fs_discovery_status status = G_FS_DISCOVERY_ERROR;
 	g_fs_node* node = 0;
-	char* absolute_path;
 	bool all_nodes_discovered = false;
 
+	/**
+	 * Path that is discovered and the node that it is relative to. The base is
+	 * pinned, so that it stays in the tree while the discovery is ongoing.
+	 */
+	g_fs_node* base;
+	char* path;
+
+	/**
+	 * Path elements that follow the name that is currently discovered. Only
+	 * valid while the discovery is requested from the delegate.
+	 */
+	const char* remaining_path = 0;
+
 	/**
 	 *
 	 */
-	g_fs_transaction_handler_discovery(char* absolute_path_in) {
+	g_fs_transaction_handler_discovery(g_fs_node* base_in, const char* path_in) :
+			base(base_in) {
+
+		// clone incoming path, it is walked again when the discovery continues
+		int len_path = g_string::length(path_in);
+		path = new char[len_path + 1];
+		g_string::copy(path, path_in);
 
-		// clone incoming path
-		int len_abs = g_string::length(absolute_path_in);
-		absolute_path = new char[len_abs + 1];
-		g_string::copy(absolute_path, absolute_path_in);
+		base->pin();
 	}
 
 	/**
 	 *
 	 */
 	~g_fs_transaction_handler_discovery() {
-		delete absolute_path;
+		base->unpin();
+		delete[] path;
 	}
 
+	/**
+	 * Asks the delegate again for the element that is discovered, used when
+	 * the delegate has set the transaction to repeat.
+	 */
+	virtual g_fs_transaction_handler_start_status start_transaction(g_thread* thread);
+
 	/**
 	 *
 	 */
@@ -0,0 +1,67 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_TRANSACTION_HANDLER_DISCOVERY_CREATE_DIRECTORY
+#define GHOST_FILESYSTEM_TRANSACTION_HANDLER_DISCOVERY_CREATE_DIRECTORY
+
+#include "filesystem/fs_transaction_handler_discovery.hpp"
+#include "filesystem/fs_node.hpp"
+#include "memory/contextual.hpp"
+
+/**
+ * Discovers the path first, so that an existing node is not created again and
+ * the parent is known to the virtual filesystem.
+ */
+class g_fs_transaction_handler_discovery_create_directory: public g_fs_transaction_handler_discovery {
+public:
+	g_contextual<g_syscall_fs_create_directory*> data;
+
+	/**
+	 *
+	 */
+	g_fs_transaction_handler_discovery_create_directory(g_fs_node* base_in, const char* path_in, g_contextual<g_syscall_fs_create_directory*> data) :
+			g_fs_transaction_handler_discovery(base_in, path_in), data(data) {
+	}
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_handler_status perform_afterwork(g_thread* thread) {
+
+		if (status == G_FS_DISCOVERY_SUCCESSFUL) {
+			data()->status = G_FS_CREATE_DIRECTORY_EXISTS;
+
+		} else if (status == G_FS_DISCOVERY_NOT_FOUND) {
+			if (g_filesystem::create(base, path, G_FS_NODE_TYPE_FOLDER)) {
+				data()->status = G_FS_CREATE_DIRECTORY_SUCCESSFUL;
+			} else {
+				data()->status = G_FS_CREATE_DIRECTORY_ERROR;
+			}
+
+		} else {
+			data()->status = G_FS_CREATE_DIRECTORY_ERROR;
+		}
+
+		return G_FS_TRANSACTION_HANDLING_DONE;
+	}
+
+};
+
+#endif
@@ -37,8 +37,8 @@ public:
 	/**
 	 *
 	 */
-	g_fs_transaction_handler_discovery_get_length(char* absolute_path_in, g_contextual<g_syscall_fs_length*> data) :
-			g_fs_transaction_handler_discovery(absolute_path_in), data(data) {
+	g_fs_transaction_handler_discovery_get_length(g_fs_node* base_in, const char* path_in, g_contextual<g_syscall_fs_length*> data) :
+			g_fs_transaction_handler_discovery(base_in, path_in), data(data) {
 
 	}
 
@@ -24,6 +24,7 @@
 #include "filesystem/fs_transaction_handler_discovery.hpp"
 #include "filesystem/fs_node.hpp"
 #include "filesystem/fs_descriptors.hpp"
+#include "filesystem/fs_delegate.hpp"
 #include "memory/contextual.hpp"
 #include "logger/logger.hpp"
 
@@ -37,8 +38,8 @@ public:
 	/**
 	 *
 	 */
-	g_fs_transaction_handler_discovery_open(char* absolute_path_in, g_contextual<g_syscall_fs_open*> data) :
-			g_fs_transaction_handler_discovery(absolute_path_in), data(data) {
+	g_fs_transaction_handler_discovery_open(g_fs_node* base_in, const char* path_in, g_contextual<g_syscall_fs_open*> data) :
+			g_fs_transaction_handler_discovery(base_in, path_in), data(data) {
 
 	}
 
@@ -47,8 +48,22 @@ public:
 	 */
 	virtual g_fs_transaction_handler_status perform_afterwork(g_thread* thread) {
 
+		// create missing files if requested and supported by the delegate
+		if (status == G_FS_DISCOVERY_NOT_FOUND && (data()->flags & G_FILE_FLAG_MODE_CREATE)) {
+			node = g_filesystem::create(base, path, G_FS_NODE_TYPE_FILE);
+			if (node) {
+				status = G_FS_DISCOVERY_SUCCESSFUL;
+			}
+
+		} else if (status == G_FS_DISCOVERY_SUCCESSFUL && (data()->flags & G_FILE_FLAG_MODE_TRUNCATE) && node->type == G_FS_NODE_TYPE_FILE) {
+			g_fs_delegate* delegate = node->get_delegate();
+			if (delegate && delegate->truncate(node, 0)) {
+				node->invalidate_attributes();
+			}
+		}
+
 		if (status == G_FS_DISCOVERY_SUCCESSFUL) {
-			data()->fd = g_filesystem::open(thread->process->main->id, node, data()->flags);
+			data()->fd = g_filesystem::open(thread->process, node, data()->flags);
 			data()->status = G_FS_OPEN_SUCCESSFUL;
 
 		} else if (status == G_FS_DISCOVERY_NOT_FOUND) {
@@ -37,8 +37,8 @@ public:
 	/**
 	 *
 	 */
-	g_fs_transaction_handler_discovery_open_directory(char* absolute_path_in, g_contextual<g_syscall_fs_open_directory*> data) :
-			g_fs_transaction_handler_discovery(absolute_path_in), data(data) {
+	g_fs_transaction_handler_discovery_open_directory(g_fs_node* base_in, const char* path_in, g_contextual<g_syscall_fs_open_directory*> data) :
+			g_fs_transaction_handler_discovery(base_in, path_in), data(data) {
 
 	}
 
@@ -48,6 +48,8 @@ public:
 	virtual g_fs_transaction_handler_status perform_afterwork(g_thread* thread) {
 
 		if (status == G_FS_DISCOVERY_SUCCESSFUL) {
+			g_filesystem::open_directory(thread->process, node);
+
 			// fill the call iterator with the node id & reset position
 			data()->iterator->node_id = node->id;
 			data()->iterator->position = 0;
@@ -25,7 +25,6 @@
 #include "filesystem/fs_node.hpp"
 #include "filesystem/fs_descriptors.hpp"
 #include "memory/contextual.hpp"
-#include "ghost/utils/local.hpp"
 #include "logger/logger.hpp"
 
 /**
@@ -38,8 +37,8 @@ public:
 	/**
 	 *
 	 */
-	g_fs_transaction_handler_discovery_set_cwd(char* absolute_path_in, g_contextual<g_syscall_fs_set_working_directory*> data) :
-			g_fs_transaction_handler_discovery(absolute_path_in), data(data) {
+	g_fs_transaction_handler_discovery_set_cwd(g_fs_node* base_in, const char* path_in, g_contextual<g_syscall_fs_set_working_directory*> data) :
+			g_fs_transaction_handler_discovery(base_in, path_in), data(data) {
 
 	}
 
@@ -50,9 +49,16 @@ public:
 
 		if (status == G_FS_DISCOVERY_SUCCESSFUL) {
 			if (!(node->type == G_FS_NODE_TYPE_PIPE || node->type == G_FS_NODE_TYPE_FILE)) {
-				g_local<char> node_realpath(new char[G_PATH_MAX]);
-				g_filesystem::get_real_path_to_node(node, node_realpath());
-				g_string::copy(thread->process->workingDirectory, node_realpath());
+				// the canonical path is only built once, relative paths start from the node
+				g_filesystem::get_real_path_to_node(node, thread->process->workingDirectory);
+
+				// the working directory keeps its node in the tree
+				node->pin();
+				if (thread->process->workingDirectoryNode) {
+					thread->process->workingDirectoryNode->unpin();
+				}
+				thread->process->workingDirectoryNode = node;
+
 				data()->result = G_SET_WORKING_DIRECTORY_SUCCESSFUL;
 				g_log_info("%! cwd of process %i is now '%s'", "filesystem", thread->process->main->id, thread->process->workingDirectory);
 			} else {
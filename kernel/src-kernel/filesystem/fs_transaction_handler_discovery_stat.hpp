@@ -0,0 +1,63 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_TRANSACTION_HANDLER_DISCOVERY_STAT
+#define GHOST_FILESYSTEM_TRANSACTION_HANDLER_DISCOVERY_STAT
+
+#include "filesystem/fs_transaction_handler_discovery.hpp"
+#include "filesystem/fs_transaction_handler_get_length_stat.hpp"
+#include "filesystem/fs_node.hpp"
+#include "memory/contextual.hpp"
+
+/**
+ *
+ */
+class g_fs_transaction_handler_discovery_stat: public g_fs_transaction_handler_discovery {
+public:
+	g_contextual<g_syscall_fs_stat*> data;
+
+	/**
+	 *
+	 */
+	g_fs_transaction_handler_discovery_stat(g_fs_node* base_in, const char* path_in, g_contextual<g_syscall_fs_stat*> data) :
+			g_fs_transaction_handler_discovery(base_in, path_in), data(data) {
+
+	}
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_handler_status perform_afterwork(g_thread* thread) {
+
+		if (status == G_FS_DISCOVERY_SUCCESSFUL) {
+			g_contextual<g_fs_stat_attributes*> attributes(&data()->stats, thread->process->pageDirectory);
+			g_contextual<int32_t*> result(&data()->result, thread->process->pageDirectory);
+			g_filesystem::stat(thread, node, new g_fs_transaction_handler_get_length_stat(node, attributes, result));
+			return G_FS_TRANSACTION_HANDLING_KEEP_WAITING;
+
+		} else {
+			data()->result = -1;
+			return G_FS_TRANSACTION_HANDLING_DONE;
+		}
+	}
+
+};
+
+#endif
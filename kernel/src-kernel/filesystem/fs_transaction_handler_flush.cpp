@@ -0,0 +1,37 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_transaction_handler_flush.hpp"
+#include "filesystem/filesystem.hpp"
+
+/**
+ *
+ */
+g_fs_transaction_handler_start_status g_fs_transaction_handler_flush::start_transaction(g_thread* thread) {
+	return g_filesystem::flush(thread, node, this);
+}
+
+/**
+ *
+ */
+g_fs_transaction_handler_status g_fs_transaction_handler_flush::finish_transaction(g_thread* thread, g_fs_delegate* delegate) {
+	perform_afterwork(thread);
+	return G_FS_TRANSACTION_HANDLING_DONE;
+}
@@ -0,0 +1,57 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_TRANSACTION_HANDLER_FLUSH
+#define GHOST_FILESYSTEM_TRANSACTION_HANDLER_FLUSH
+
+#include "filesystem/fs_transaction_handler.hpp"
+#include "filesystem/fs_node.hpp"
+
+/**
+ * Handler for passing the buffered writes of a node on to its delegate. The
+ * delegate sets the status directly, so there is nothing to finish on its side.
+ */
+class g_fs_transaction_handler_flush: public g_fs_transaction_handler {
+public:
+	g_fs_transaction_handler_flush(g_fs_node* node) :
+			node(node) {
+	}
+
+	g_fs_node* node;
+	g_fs_flush_status status = G_FS_FLUSH_ERROR;
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_handler_start_status start_transaction(g_thread* thread);
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_handler_status finish_transaction(g_thread* thread, g_fs_delegate* delegate);
+
+	/**
+	 *
+	 */
+	virtual void perform_afterwork(g_thread* thread) = 0;
+
+};
+
+#endif
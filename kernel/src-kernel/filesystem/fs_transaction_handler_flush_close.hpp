@@ -0,0 +1,67 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_TRANSACTION_HANDLER_FLUSH_CLOSE
+#define GHOST_FILESYSTEM_TRANSACTION_HANDLER_FLUSH_CLOSE
+
+#include "filesystem/fs_transaction_handler_flush.hpp"
+#include "filesystem/filesystem.hpp"
+#include "memory/contextual.hpp"
+
+/**
+ * Closes the file descriptor once the buffered writes of its node are flushed. The
+ * descriptor is looked up again, because the process could have closed it meanwhile.
+ * A failed flush is reported as an error although the descriptor is closed.
+ */
+class g_fs_transaction_handler_flush_close: public g_fs_transaction_handler_flush {
+public:
+	g_fd fd;
+	g_contextual<g_syscall_fs_close*> data;
+
+	/**
+	 *
+	 */
+	g_fs_transaction_handler_flush_close(g_fs_node* node, g_fd fd, g_contextual<g_syscall_fs_close*> data) :
+			g_fs_transaction_handler_flush(node), fd(fd), data(data) {
+	}
+
+	/**
+	 *
+	 */
+	virtual void perform_afterwork(g_thread* thread) {
+
+		g_fs_node* fd_node;
+		g_file_descriptor_content* fd_content;
+		if (!g_filesystem::node_for_descriptor(thread->process, fd, &fd_node, &fd_content)) {
+			data()->status = G_FS_CLOSE_INVALID_FD;
+			return;
+		}
+
+		g_fs_close_status close_status;
+		data()->result = g_filesystem::close(thread->process, fd_node, fd_content, &close_status);
+		if (close_status == G_FS_CLOSE_SUCCESSFUL && status != G_FS_FLUSH_SUCCESSFUL) {
+			close_status = G_FS_CLOSE_ERROR;
+		}
+		data()->status = close_status;
+	}
+
+};
+
+#endif
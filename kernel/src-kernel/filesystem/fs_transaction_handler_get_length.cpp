@@ -20,12 +20,30 @@
 
 #include "filesystem/fs_delegate.hpp"
 #include "filesystem/fs_transaction_handler_get_length.hpp"
+#include "filesystem/filesystem.hpp"
+
+/**
+ *
+ */
+g_fs_transaction_handler_start_status g_fs_transaction_handler_get_length::start_transaction(g_thread* thread) {
+
+	if (g_filesystem::get_length(thread, node, this)) {
+		return G_FS_TRANSACTION_START_FAILED;
+	}
+	return G_FS_TRANSACTION_STARTED_WITH_WAITER;
+}
 
 /**
  *
  */
 g_fs_transaction_handler_status g_fs_transaction_handler_get_length::finish_transaction(g_thread* thread, g_fs_delegate* delegate) {
-	delegate->finish_get_length(thread, this);
+	if (!served_from_cache) {
+		delegate->finish_get_length(thread, this);
+
+		if (status == G_FS_LENGTH_SUCCESSFUL && node) {
+			node->cache_length(length);
+		}
+	}
 
 	perform_afterwork(thread);
 	return G_FS_TRANSACTION_HANDLING_DONE;
@@ -34,6 +34,23 @@ public:
 	g_fs_length_status status = G_FS_LENGTH_ERROR;
 	int64_t length;
 
+	/**
+	 * The node whose length is requested, its cached length is updated once the
+	 * delegate has answered.
+	 */
+	g_fs_node* node = 0;
+
+	/**
+	 * Set when the length was taken from the attributes of the node, the delegate
+	 * then has nothing to finish.
+	 */
+	bool served_from_cache = false;
+
+	/**
+	 * Asks the delegate again, used when the delegate has set the transaction to repeat.
+	 */
+	virtual g_fs_transaction_handler_start_status start_transaction(g_thread* thread);
+
 	/**
 	 *
 	 */
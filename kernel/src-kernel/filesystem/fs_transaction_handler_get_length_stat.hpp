@@ -0,0 +1,72 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_TRANSACTION_HANDLER_GET_LENGTH_STAT
+#define GHOST_FILESYSTEM_TRANSACTION_HANDLER_GET_LENGTH_STAT
+
+#include "filesystem/fs_transaction_handler_get_length.hpp"
+#include "filesystem/fs_node.hpp"
+#include "memory/contextual.hpp"
+
+/**
+ * Fills the stat attributes of a node once its length is known. The node is
+ * pinned, so that it stays in the tree while the delegate is asked for the length.
+ */
+class g_fs_transaction_handler_get_length_stat: public g_fs_transaction_handler_get_length {
+public:
+	g_contextual<g_fs_stat_attributes*> attributes;
+	g_contextual<int32_t*> result;
+
+	/**
+	 *
+	 */
+	g_fs_transaction_handler_get_length_stat(g_fs_node* node_in, g_contextual<g_fs_stat_attributes*> attributes, g_contextual<int32_t*> result) :
+			attributes(attributes), result(result) {
+		node = node_in;
+		node->pin();
+	}
+
+	/**
+	 *
+	 */
+	~g_fs_transaction_handler_get_length_stat() {
+		node->unpin();
+	}
+
+	/**
+	 *
+	 */
+	virtual void perform_afterwork(g_thread* thread) {
+
+		if (status == G_FS_LENGTH_SUCCESSFUL) {
+			attributes()->mode = 0;
+			attributes()->type = node->type;
+			attributes()->length = length;
+			attributes()->modified = node->modified;
+			*result() = 0;
+
+		} else {
+			*result() = -1;
+		}
+	}
+
+};
+
+#endif
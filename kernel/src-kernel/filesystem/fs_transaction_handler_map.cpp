@@ -0,0 +1,62 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_transaction_handler_map.hpp"
+#include "filesystem/fs_mappings.hpp"
+
+/**
+ *
+ */
+static g_fs_io_vector* create_segment(g_virtual_address base, uint32_t length) {
+
+	g_fs_io_vector* segment = new g_fs_io_vector[1];
+	segment->buffer = (void*) base;
+	segment->length = length;
+	return segment;
+}
+
+/**
+ *
+ */
+g_fs_transaction_handler_map::g_fs_transaction_handler_map(g_fs_node* node, g_file_descriptor_content* fd, g_process* process, g_virtual_address base,
+		uint32_t length, int64_t offset, g_fs_map_flags flags, g_contextual<g_syscall_fs_map*> map_data) :
+		g_fs_transaction_handler_read_vector(node, fd, create_segment(base, length), 1, offset, g_contextual<g_syscall_fs_read_vector*>()), process(
+				process), base(base), flags(flags), map_data(map_data) {
+}
+
+/**
+ *
+ */
+void g_fs_transaction_handler_map::complete() {
+
+	// nothing could be read at the offset, the mapping is useless
+	if (total <= 0) {
+		g_fs_mappings::release(process, base);
+		map_data()->status = (status == G_FS_READ_SUCCESSFUL) ? G_FS_MAP_INVALID_RANGE : G_FS_MAP_ERROR;
+		return;
+	}
+
+	if ((flags & G_FS_MAP_PRIVATE) == 0) {
+		g_fs_mappings::protect(process, base);
+	}
+
+	map_data()->address = (void*) base;
+	map_data()->status = G_FS_MAP_SUCCESSFUL;
+}
@@ -0,0 +1,48 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_TRANSACTION_HANDLER_MAP
+#define GHOST_FILESYSTEM_TRANSACTION_HANDLER_MAP
+
+#include "filesystem/fs_transaction_handler_read_vector.hpp"
+
+/**
+ * Fills a mapping with the contents of a file when the delegate can not provide
+ * the pages directly. The contents are read into the anonymous pages of the
+ * mapping as a positional read; shared mappings are made read-only afterwards.
+ */
+class g_fs_transaction_handler_map: public g_fs_transaction_handler_read_vector {
+public:
+	g_fs_transaction_handler_map(g_fs_node* node, g_file_descriptor_content* fd, g_process* process, g_virtual_address base, uint32_t length,
+			int64_t offset, g_fs_map_flags flags, g_contextual<g_syscall_fs_map*> map_data);
+
+	g_process* process;
+	g_virtual_address base;
+	g_fs_map_flags flags;
+	g_contextual<g_syscall_fs_map*> map_data;
+
+protected:
+	/**
+	 *
+	 */
+	virtual void complete();
+};
+
+#endif
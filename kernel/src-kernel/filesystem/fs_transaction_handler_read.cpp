@@ -21,6 +21,8 @@
 #include "filesystem/fs_delegate.hpp"
 #include "filesystem/fs_transaction_handler_read.hpp"
 #include "filesystem/filesystem.hpp"
+#include "memory/physical/pp_allocator.hpp"
+#include "kernel.hpp"
 
 /**
  *
@@ -38,9 +40,47 @@ g_fs_transaction_handler_start_status g_fs_transaction_handler_read::start_trans
  *
  */
 g_fs_transaction_handler_status g_fs_transaction_handler_read::finish_transaction(g_thread* thread, g_fs_delegate* delegate) {
-	delegate->finish_read(thread, &status, &result, fd);
+
+	finish_read_into(thread, delegate, data()->buffer);
 
 	data()->result = result;
 	data()->status = status;
 	return G_FS_TRANSACTION_HANDLING_DONE;
 }
+
+/**
+ *
+ */
+void g_fs_transaction_handler_read::finish_read_into(g_thread* thread, g_fs_delegate* delegate, uint8_t* target) {
+	if (!served_from_cache) {
+		delegate->finish_read(thread, &status, &result, fd);
+	}
+
+	// only the requested part of a read-ahead goes to the requester
+	if (readahead_buffer) {
+		if (status == G_FS_READ_SUCCESSFUL && result > 0) {
+			int64_t served = (result > readahead_requested) ? readahead_requested : result;
+			g_memory::copy(target, (void*) readahead_buffer, served);
+			fd->offset -= result - served;
+			result = served;
+		}
+		release_readahead_buffer();
+	}
+}
+
+/**
+ *
+ */
+void g_fs_transaction_handler_read::release_readahead_buffer() {
+
+	for (int i = 0; i < readahead_pages; i++) {
+		g_virtual_address virt = readahead_buffer + i * G_PAGE_SIZE;
+		g_physical_address phys = g_address_space::virtual_to_physical(virt);
+		g_address_space::unmap(virt);
+		g_pp_allocator::free(phys);
+	}
+	g_kernel_virt_addr_ranges->free(readahead_buffer);
+
+	readahead_buffer = 0;
+	readahead_pages = 0;
+}
@@ -42,6 +42,21 @@ public:
 	g_file_descriptor_content* fd;
 	g_contextual<g_syscall_fs_read*> data;
 
+	/**
+	 * Set by the delegate when the result was taken from the page cache,
+	 * the delegate then has nothing to finish.
+	 */
+	bool served_from_cache = false;
+
+	/**
+	 * When the delegate reads ahead, it reads into these kernel pages instead of
+	 * the requesters buffer. Once the transaction is finished, the requested part
+	 * is copied to the requester and the pages are released.
+	 */
+	g_virtual_address readahead_buffer = 0;
+	int readahead_pages = 0;
+	int64_t readahead_requested = 0;
+
 	/**
 	 *
 	 */
@@ -52,6 +67,17 @@ public:
 	 */
 	virtual g_fs_transaction_handler_status finish_transaction(g_thread* thread, g_fs_delegate* delegate);
 
+	/**
+	 * Lets the delegate finish the read and moves the result of a read-ahead
+	 * to the given target buffer. Leaves status and result in the handler.
+	 */
+	void finish_read_into(g_thread* thread, g_fs_delegate* delegate, uint8_t* target);
+
+	/**
+	 *
+	 */
+	void release_readahead_buffer();
+
 };
 
 #endif
@@ -20,9 +20,47 @@
 
 #include "filesystem/fs_delegate.hpp"
 #include "filesystem/fs_transaction_handler_read_directory.hpp"
+#include "filesystem/filesystem.hpp"
 
 #include "logger/logger.hpp"
 
+/**
+ *
+ */
+bool g_fs_transaction_handler_read_directory::add_child(g_fs_node* child) {
+
+	if (child == 0 || count > 0) {
+		return false;
+	}
+
+	this->child = child;
+	count = 1;
+	return true;
+}
+
+/**
+ *
+ */
+void g_fs_transaction_handler_read_directory::finish_children(bool end_reached) {
+
+	if (count > 0) {
+		status = G_FS_READ_DIRECTORY_SUCCESSFUL;
+	} else if (end_reached) {
+		status = G_FS_READ_DIRECTORY_EOD;
+	} else {
+		status = G_FS_READ_DIRECTORY_ERROR;
+	}
+}
+
+/**
+ *
+ */
+g_fs_transaction_handler_start_status g_fs_transaction_handler_read_directory::start_transaction(g_thread* thread) {
+
+	g_filesystem::read_directory(thread, directory->id, position, this);
+	return G_FS_TRANSACTION_STARTED_WITH_WAITER;
+}
+
 /**
  *
  */
@@ -33,6 +33,13 @@ class g_fs_transaction_handler_read_directory: public g_fs_transaction_handler {
 public:
 	g_fs_read_directory_status status = G_FS_READ_DIRECTORY_ERROR;
 	g_fs_node* child;
+	uint32_t count = 0;
+
+	/**
+	 * The directory and the position that are read, kept to repeat the request.
+	 */
+	g_fs_node* directory = 0;
+	int position = 0;
 
 	g_contextual<g_syscall_fs_read_directory*> data;
 
@@ -43,6 +50,39 @@ public:
 			child(0), data(data) {
 	}
 
+	/**
+	 *
+	 */
+	virtual ~g_fs_transaction_handler_read_directory() {
+	}
+
+	/**
+	 * Adds a child that the delegate has read. Delegates that can read several
+	 * entries at once add children in order until this returns false.
+	 *
+	 * @return whether the child was taken
+	 */
+	virtual bool add_child(g_fs_node* child);
+
+	/**
+	 * @return the maximum number of children that the delegate should read
+	 */
+	virtual uint32_t get_capacity() {
+		return 1;
+	}
+
+	/**
+	 * Sets the status after a delegate has added children. Reading was successful
+	 * if any child was taken; otherwise the end of the directory was reached, or no
+	 * entry fitted into the requesters buffer.
+	 */
+	void finish_children(bool end_reached);
+
+	/**
+	 * Asks the delegate again, used when the delegate has set the transaction to repeat.
+	 */
+	virtual g_fs_transaction_handler_start_status start_transaction(g_thread* thread);
+
 	/**
 	 *
 	 */
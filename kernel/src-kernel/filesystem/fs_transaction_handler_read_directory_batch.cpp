@@ -0,0 +1,116 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_delegate.hpp"
+#include "filesystem/fs_transaction_handler_read_directory_batch.hpp"
+
+#include "logger/logger.hpp"
+#include "utils/string.hpp"
+
+/**
+ * The number of children is limited by the number of the smallest records
+ * that fit into the buffer.
+ */
+g_fs_transaction_handler_read_directory_batch::g_fs_transaction_handler_read_directory_batch(uint32_t length,
+		g_contextual<g_syscall_fs_read_directory_batch*> batch_data) :
+		g_fs_transaction_handler_read_directory(g_contextual<g_syscall_fs_read_directory*>()), length(length), batch_data(batch_data) {
+
+	capacity = length / get_record_length("");
+	if (capacity > G_FS_READ_DIRECTORY_BATCH_MAXIMUM) {
+		capacity = G_FS_READ_DIRECTORY_BATCH_MAXIMUM;
+	}
+	children = capacity > 0 ? new g_fs_node*[capacity] : 0;
+}
+
+/**
+ *
+ */
+g_fs_transaction_handler_read_directory_batch::~g_fs_transaction_handler_read_directory_batch() {
+	if (children) {
+		delete[] children;
+	}
+}
+
+/**
+ *
+ */
+uint32_t g_fs_transaction_handler_read_directory_batch::get_record_length(const char* name) {
+
+	uint32_t record_length = sizeof(g_fs_directory_record) + g_string::length(name) + 1;
+	return (record_length + 3) & ~3;
+}
+
+/**
+ *
+ */
+bool g_fs_transaction_handler_read_directory_batch::add_child(g_fs_node* child) {
+
+	if (child == 0 || count >= capacity) {
+		return false;
+	}
+
+	uint32_t record_length = get_record_length(child->name);
+	if (used + record_length > length) {
+		return false;
+	}
+
+	children[count++] = child;
+	used += record_length;
+	return true;
+}
+
+/**
+ *
+ */
+g_fs_transaction_handler_status g_fs_transaction_handler_read_directory_batch::finish_transaction(g_thread* thread, g_fs_delegate* delegate) {
+
+	if (delegate) {
+		delegate->finish_read_directory(thread, this);
+	}
+
+	g_syscall_fs_read_directory_batch* data = batch_data();
+	data->status = status;
+	data->count = 0;
+	data->used = 0;
+
+	if (status == G_FS_READ_DIRECTORY_SUCCESSFUL) {
+		uint8_t* buffer = (uint8_t*) data->buffer;
+		uint32_t offset = 0;
+
+		for (uint32_t i = 0; i < count; i++) {
+			g_fs_node* child = children[i];
+			uint32_t record_length = get_record_length(child->name);
+
+			g_fs_directory_record* record = (g_fs_directory_record*) &buffer[offset];
+			record->node_id = child->id;
+			record->type = child->type;
+			record->length = record_length;
+			g_memory::copy(record->name, child->name, g_string::length(child->name) + 1);
+
+			offset += record_length;
+		}
+
+		data->iterator->position += count;
+		data->count = count;
+		data->used = offset;
+	}
+
+	return G_FS_TRANSACTION_HANDLING_DONE;
+}
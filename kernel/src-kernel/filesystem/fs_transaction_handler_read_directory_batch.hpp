@@ -0,0 +1,66 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_TRANSACTION_HANDLER_READ_DIRECTORY_BATCH
+#define GHOST_FILESYSTEM_TRANSACTION_HANDLER_READ_DIRECTORY_BATCH
+
+#include "filesystem/fs_transaction_handler_read_directory.hpp"
+
+/**
+ * Handler for a batched directory read. The delegate adds as many children as
+ * fit into the requesters buffer; once the transaction is finished, they are
+ * written to the buffer as packed {g_fs_directory_record} entries.
+ */
+class g_fs_transaction_handler_read_directory_batch: public g_fs_transaction_handler_read_directory {
+public:
+	g_fs_transaction_handler_read_directory_batch(uint32_t length, g_contextual<g_syscall_fs_read_directory_batch*> batch_data);
+	virtual ~g_fs_transaction_handler_read_directory_batch();
+
+	g_fs_node** children;
+	uint32_t capacity;
+	uint32_t length;
+	uint32_t used = 0;
+
+	g_contextual<g_syscall_fs_read_directory_batch*> batch_data;
+
+	/**
+	 *
+	 */
+	virtual bool add_child(g_fs_node* child);
+
+	/**
+	 *
+	 */
+	virtual uint32_t get_capacity() {
+		return capacity;
+	}
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_handler_status finish_transaction(g_thread* thread, g_fs_delegate* delegate);
+
+	/**
+	 * @return the length of the record for a child with the given name
+	 */
+	static uint32_t get_record_length(const char* name);
+};
+
+#endif
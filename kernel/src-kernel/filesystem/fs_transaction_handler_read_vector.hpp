@@ -0,0 +1,81 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_TRANSACTION_HANDLER_READ_VECTOR
+#define GHOST_FILESYSTEM_TRANSACTION_HANDLER_READ_VECTOR
+
+#include "filesystem/fs_transaction_handler_read.hpp"
+
+/**
+ * Handler for a vectored read. The segments are read one after another, each
+ * as a regular read transaction on the delegate, so no delegate needs to know
+ * about vectors. Segments that the delegate finishes immediately are handled
+ * inline; otherwise a waiter is attached and reading continues once the
+ * transaction has finished.
+ *
+ * For positional reads, the handler reads through a private cursor copy of the
+ * file descriptor so that the offset of the real descriptor stays untouched.
+ */
+class g_fs_transaction_handler_read_vector: public g_fs_transaction_handler_read {
+public:
+	g_fs_transaction_handler_read_vector(g_fs_node* node, g_file_descriptor_content* fd, g_fs_io_vector* segments, uint32_t count, int64_t offset,
+			g_contextual<g_syscall_fs_read_vector*> vector_data);
+	virtual ~g_fs_transaction_handler_read_vector();
+
+	g_fs_io_vector* segments;
+	uint32_t count;
+	uint32_t current = 0;
+	int64_t total = 0;
+
+	g_file_descriptor_content cursor;
+	g_contextual<g_syscall_fs_read_vector*> vector_data;
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_handler_start_status start_transaction(g_thread* thread);
+
+	/**
+	 *
+	 */
+	virtual g_fs_transaction_handler_status finish_transaction(g_thread* thread, g_fs_delegate* delegate);
+
+protected:
+	/**
+	 * Requests the remaining segments from the delegate.
+	 *
+	 * @return whether a waiter was attached to the thread
+	 */
+	bool advance(g_thread* thread);
+
+	/**
+	 * Finishes the read of the current segment.
+	 *
+	 * @return whether reading should continue with the next segment
+	 */
+	bool finish_segment(g_thread* thread, g_fs_delegate* delegate);
+
+	/**
+	 * Writes the overall result to the requesters data.
+	 */
+	virtual void complete();
+};
+
+#endif
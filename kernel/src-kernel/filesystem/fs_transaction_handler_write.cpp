@@ -36,6 +36,9 @@ g_fs_transaction_handler_start_status g_fs_transaction_handler_write::start_tran
  */
 g_fs_transaction_handler_status g_fs_transaction_handler_write::finish_transaction(g_thread* thread, g_fs_delegate* delegate) {
 	delegate->finish_write(thread, &status, &result, fd);
+	if (status == G_FS_WRITE_SUCCESSFUL && result > 0) {
+		node->written(fd->offset);
+	}
 	data()->result = result;
 	data()->status = status;
 	return G_FS_TRANSACTION_HANDLING_DONE;
@@ -0,0 +1,158 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_transaction_handler_write_vector.hpp"
+#include "filesystem/fs_transaction_store.hpp"
+#include "filesystem/fs_delegate.hpp"
+#include "filesystem/filesystem.hpp"
+#include "tasking/wait/waiter_fs_transaction.hpp"
+#include "logger/logger.hpp"
+
+/**
+ *
+ */
+g_fs_transaction_handler_write_vector::g_fs_transaction_handler_write_vector(g_fs_node* node, g_file_descriptor_content* fd, g_fs_io_vector* segments,
+		uint32_t count, int64_t offset, g_contextual<g_syscall_fs_write_vector*> vector_data) :
+		g_fs_transaction_handler_write(node, fd, g_contextual<g_syscall_fs_write*>()), segments(segments), count(count), vector_data(vector_data) {
+
+	status = G_FS_WRITE_SUCCESSFUL;
+
+	if (offset != G_FS_OFFSET_CURRENT) {
+		cursor.id = fd->id;
+		fd->clone_into(&cursor);
+		cursor.offset = offset;
+		this->fd = &cursor;
+	}
+}
+
+/**
+ *
+ */
+g_fs_transaction_handler_write_vector::~g_fs_transaction_handler_write_vector() {
+	delete[] segments;
+}
+
+/**
+ *
+ */
+g_fs_transaction_handler_start_status g_fs_transaction_handler_write_vector::start_transaction(g_thread* thread) {
+
+	// a repeat only asks for the current segment again, the waiter is still attached
+	if (wants_repeat_transaction()) {
+		g_fs_delegate* delegate = node->get_delegate();
+		g_contextual<uint8_t*> bound_buffer((uint8_t*) segments[current].buffer, thread->process->pageDirectory);
+		delegate->request_write(thread, node, segments[current].length, bound_buffer, fd, this);
+		return G_FS_TRANSACTION_STARTED_WITH_WAITER;
+	}
+
+	if (advance(thread)) {
+		return G_FS_TRANSACTION_STARTED_WITH_WAITER;
+	}
+
+	complete();
+	return G_FS_TRANSACTION_STARTED_AND_FINISHED;
+}
+
+/**
+ *
+ */
+g_fs_transaction_handler_status g_fs_transaction_handler_write_vector::finish_transaction(g_thread* thread, g_fs_delegate* delegate) {
+
+	if (finish_segment(thread, delegate) && advance(thread)) {
+		return G_FS_TRANSACTION_HANDLING_KEEP_WAITING;
+	}
+
+	complete();
+	return G_FS_TRANSACTION_HANDLING_DONE;
+}
+
+/**
+ *
+ */
+bool g_fs_transaction_handler_write_vector::advance(g_thread* thread) {
+
+	g_fs_delegate* delegate = node->get_delegate();
+	if (delegate == 0) {
+		g_log_warn("%! vectored write of '%i' failed due to missing delegate on underlying node %i", "filesystem", fd->id, node->id);
+		status = G_FS_WRITE_ERROR;
+		return false;
+	}
+
+	while (current < count) {
+		if (segments[current].length == 0) {
+			++current;
+			continue;
+		}
+
+		prepare_transaction_repeat(G_FS_TRANSACTION_NO_REPEAT_ID);
+
+		g_contextual<uint8_t*> bound_buffer((uint8_t*) segments[current].buffer, thread->process->pageDirectory);
+		g_fs_transaction_id transaction = delegate->request_write(thread, node, segments[current].length, bound_buffer, fd, this);
+
+		// let the thread wait if the delegate can not finish the segment right away
+		if (g_fs_transaction_store::get_status(transaction) != G_FS_TRANSACTION_FINISHED) {
+			thread->wait(new g_waiter_fs_transaction(this, transaction, delegate));
+			return true;
+		}
+
+		g_fs_transaction_store::remove_transaction(transaction);
+		if (!finish_segment(thread, delegate)) {
+			break;
+		}
+	}
+
+	return false;
+}
+
+/**
+ *
+ */
+bool g_fs_transaction_handler_write_vector::finish_segment(g_thread* thread, g_fs_delegate* delegate) {
+
+	delegate->finish_write(thread, &status, &result, fd);
+	if (status != G_FS_WRITE_SUCCESSFUL) {
+		return false;
+	}
+
+	total += result;
+	if (result > 0) {
+		node->written(fd->offset);
+	}
+
+	// a short write ends the vector, the following data would end up misplaced
+	bool full = (result == segments[current].length);
+	++current;
+	return full;
+}
+
+/**
+ *
+ */
+void g_fs_transaction_handler_write_vector::complete() {
+
+	// data that was already transferred is reported even if a later segment failed
+	if (total > 0 || status == G_FS_WRITE_SUCCESSFUL) {
+		vector_data()->status = G_FS_WRITE_SUCCESSFUL;
+		vector_data()->result = total;
+	} else {
+		vector_data()->status = status;
+		vector_data()->result = -1;
+	}
+}
@@ -19,36 +19,87 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "filesystem/fs_transaction_store.hpp"
+#include "kernel.hpp"
 
-#include "utils/hash_map.hpp"
-
-static g_fs_transaction_id next_transaction_id = 0;
-static g_hash_map<g_fs_transaction_id, g_fs_transaction_status>* store;
+static g_fs_transaction_slot* volatile chunks[G_FS_TRANSACTION_STORE_MAXIMUM_CHUNKS];
+static volatile int32_t chunk_count = 0;
+static int32_t first_free = -1;
 
 /**
  *
  */
 void g_fs_transaction_store::initialize() {
-	store = new g_hash_map<g_fs_transaction_id, g_fs_transaction_status>();
+
+	for (int i = 0; i < G_FS_TRANSACTION_STORE_MAXIMUM_CHUNKS; i++) {
+		chunks[i] = 0;
+	}
 }
 
 /**
- *
+ * Released slots are reused first, a new chunk is only created if none is free.
  */
 g_fs_transaction_id g_fs_transaction_store::next_transaction() {
-	return next_transaction_id++;
+
+	if (first_free == -1) {
+		if (chunk_count == G_FS_TRANSACTION_STORE_MAXIMUM_CHUNKS) {
+			g_kernel::panic("%! no transaction slots left", "filesystem");
+		}
+
+		g_fs_transaction_slot* chunk = new g_fs_transaction_slot[G_FS_TRANSACTION_STORE_CHUNK_SLOTS];
+		int32_t first_index = chunk_count * G_FS_TRANSACTION_STORE_CHUNK_SLOTS;
+		for (int i = 0; i < G_FS_TRANSACTION_STORE_CHUNK_SLOTS; i++) {
+			chunk[i].generation = 0;
+			chunk[i].status = G_FS_TRANSACTION_WAITING;
+			chunk[i].next_free = (i < G_FS_TRANSACTION_STORE_CHUNK_SLOTS - 1) ? first_index + i + 1 : -1;
+		}
+		chunks[chunk_count] = chunk;
+		chunk_count = chunk_count + 1;
+		first_free = first_index;
+	}
+
+	int32_t index = first_free;
+	g_fs_transaction_slot* slot = &chunks[index / G_FS_TRANSACTION_STORE_CHUNK_SLOTS][index % G_FS_TRANSACTION_STORE_CHUNK_SLOTS];
+	first_free = slot->next_free;
+
+	slot->status = G_FS_TRANSACTION_WAITING;
+	slot->generation = slot->generation + 1;
+	g_fs_transaction_id id = ((slot->generation & G_FS_TRANSACTION_STORE_GENERATION_MASK) << G_FS_TRANSACTION_STORE_INDEX_BITS) | index;
+
+	return id;
 }
 
 /**
  *
  */
+g_fs_transaction_slot* g_fs_transaction_store::get_slot(g_fs_transaction_id id) {
+
+	if (id >> 32) {
+		return 0;
+	}
+
+	uint32_t index = id & G_FS_TRANSACTION_STORE_INDEX_MASK;
+	uint32_t chunk = index / G_FS_TRANSACTION_STORE_CHUNK_SLOTS;
+	if (chunk >= (uint32_t) chunk_count) {
+		return 0;
+	}
+
+	g_fs_transaction_slot* slot = &chunks[chunk][index % G_FS_TRANSACTION_STORE_CHUNK_SLOTS];
+	if ((slot->generation & G_FS_TRANSACTION_STORE_GENERATION_MASK) != (id >> G_FS_TRANSACTION_STORE_INDEX_BITS)) {
+		return 0;
+	}
+	return slot;
+}
+
+/**
+ * Transactions that don't exist (anymore) are reported as waiting.
+ */
 g_fs_transaction_status g_fs_transaction_store::get_status(g_fs_transaction_id id) {
 
-	auto entry = store->get(id);
-	if (entry) {
-		return entry->value;
+	g_fs_transaction_slot* slot = get_slot(id);
+	if (slot) {
+		return slot->status;
 	}
-	return 0;
+	return G_FS_TRANSACTION_WAITING;
 }
 
 /**
@@ -56,7 +107,23 @@ g_fs_transaction_status g_fs_transaction_store::get_status(g_fs_transaction_id i
  */
 void g_fs_transaction_store::set_status(g_fs_transaction_id id, g_fs_transaction_status result) {
 
-	store->put(id, result);
+	g_fs_transaction_slot* slot = get_slot(id);
+	if (slot) {
+		slot->status = result;
+		slot->queue.wake_all();
+	}
+}
+
+/**
+ *
+ */
+g_wait_queue* g_fs_transaction_store::get_queue(g_fs_transaction_id id) {
+
+	g_fs_transaction_slot* slot = get_slot(id);
+	if (slot) {
+		return &slot->queue;
+	}
+	return 0;
 }
 
 /**
@@ -64,5 +131,11 @@ void g_fs_transaction_store::set_status(g_fs_transaction_id id, g_fs_transaction
  */
 void g_fs_transaction_store::remove_transaction(g_fs_transaction_id id) {
 
-	store->remove(id);
+	g_fs_transaction_slot* slot = get_slot(id);
+	if (slot) {
+		slot->generation = slot->generation + 1;
+		slot->next_free = first_free;
+		first_free = id & G_FS_TRANSACTION_STORE_INDEX_MASK;
+	}
+
 }
@@ -23,6 +23,7 @@
 
 #include "filesystem/fs_node.hpp"
 #include "memory/paging.hpp"
+#include "tasking/wait/wait_queue.hpp"
 
 /**
  * Address-space bound meta object passed during transactions.
@@ -32,10 +33,45 @@ struct g_fs_transaction_store_meta {
 	g_page_directory space;
 };
 
+/**
+ * Slots are allocated in chunks that are never freed, so the address of a slot
+ * stays valid once its chunk exists.
+ */
+#define G_FS_TRANSACTION_STORE_CHUNK_SLOTS		256
+#define G_FS_TRANSACTION_STORE_MAXIMUM_CHUNKS	64
+
+/**
+ * Identifiers are passed to delegates in 32 bit message parameters, so the index
+ * takes the lower bits (enough for all slots) and the generation the remaining bits.
+ */
+#define G_FS_TRANSACTION_STORE_INDEX_BITS		14
+#define G_FS_TRANSACTION_STORE_INDEX_MASK		((1 << G_FS_TRANSACTION_STORE_INDEX_BITS) - 1)
+#define G_FS_TRANSACTION_STORE_GENERATION_MASK	(0xFFFFFFFF >> G_FS_TRANSACTION_STORE_INDEX_BITS)
+
+/**
+ * Slot of a transaction that is in flight. The generation is increased whenever
+ * the slot is taken or released, so that an identifier of a released transaction
+ * doesn't match the slot anymore.
+ */
+struct g_fs_transaction_slot {
+	volatile uint32_t generation;
+	volatile g_fs_transaction_status status;
+
+	/**
+	 * Woken whenever the status of the transaction changes.
+	 */
+	g_wait_queue queue;
+
+	int32_t next_free;
+};
+
 /**
  * The discovery store is used to store information about an ongoing discovery.
  * A discovery happens when a child for a specific node should be resolved by a driver
  * delegate which must happen asynchronously.
+ *
+ * A transaction identifier consists of the generation in the upper and the index
+ * of its slot in the lower bits.
  */
 class g_fs_transaction_store {
 public:
@@ -45,6 +81,15 @@ public:
 	static void set_status(g_fs_transaction_id id, g_fs_transaction_status result);
 	static g_fs_transaction_status get_status(g_fs_transaction_id id);
 	static void remove_transaction(g_fs_transaction_id id);
+
+	/**
+	 * Returns the queue that is woken when the status of the transaction changes,
+	 * or 0 if the transaction doesn't exist.
+	 */
+	static g_wait_queue* get_queue(g_fs_transaction_id id);
+
+private:
+	static g_fs_transaction_slot* get_slot(g_fs_transaction_id id);
 };
 
 #endif
@@ -0,0 +1,127 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/fs_write_buffer.hpp"
+#include "memory/physical/pp_allocator.hpp"
+#include "memory/address_space.hpp"
+#include "kernel.hpp"
+#include "logger/logger.hpp"
+
+static g_fs_write_buffer_statistics statistics = { 0, 0, 0, 0 };
+
+/**
+ *
+ */
+g_fs_write_buffer* g_fs_write_buffers::create(g_fs_virt_id node_id, g_fs_phys_id phys_fs_id) {
+
+	if (statistics.buffers >= G_FS_WRITE_BUFFER_MAXIMUM_BUFFERS || memory_low()) {
+		return 0;
+	}
+
+	g_virtual_address virt = g_kernel_virt_addr_ranges->allocate(G_FS_WRITE_BUFFER_PAGES);
+	if (virt == 0) {
+		return 0;
+	}
+
+	for (int i = 0; i < G_FS_WRITE_BUFFER_PAGES; i++) {
+		g_physical_address physical = g_pp_allocator::allocate();
+		if (physical == 0) {
+			for (int j = 0; j < i; j++) {
+				g_virtual_address page = virt + j * G_PAGE_SIZE;
+				g_physical_address mapped = g_address_space::virtual_to_physical(page);
+				g_address_space::unmap(page);
+				g_pp_allocator::free(mapped);
+			}
+			g_kernel_virt_addr_ranges->free(virt);
+			return 0;
+		}
+		g_address_space::map(virt + i * G_PAGE_SIZE, physical, DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+	}
+
+	g_fs_write_buffer* buffer = new g_fs_write_buffer();
+	buffer->node_id = node_id;
+	buffer->phys_fs_id = phys_fs_id;
+	buffer->offset = 0;
+	buffer->length = 0;
+	buffer->dirty_since = 0;
+	buffer->failed = false;
+	buffer->detached = false;
+	buffer->data = (uint8_t*) virt;
+	buffer->next = 0;
+
+	++statistics.buffers;
+	return buffer;
+}
+
+/**
+ *
+ */
+void g_fs_write_buffers::release(g_fs_write_buffer* buffer) {
+
+	g_virtual_address virt = (g_virtual_address) buffer->data;
+	for (int i = 0; i < G_FS_WRITE_BUFFER_PAGES; i++) {
+		g_virtual_address page = virt + i * G_PAGE_SIZE;
+		g_physical_address physical = g_address_space::virtual_to_physical(page);
+		g_address_space::unmap(page);
+		g_pp_allocator::free(physical);
+	}
+	g_kernel_virt_addr_ranges->free(virt);
+
+	delete buffer;
+	--statistics.buffers;
+}
+
+/**
+ *
+ */
+bool g_fs_write_buffers::memory_low() {
+	return g_pp_allocator::getFreePageCount() < G_FS_WRITE_BUFFER_MINIMUM_FREE_PAGES;
+}
+
+/**
+ *
+ */
+void g_fs_write_buffers::buffered() {
+	++statistics.buffered_writes;
+}
+
+/**
+ *
+ */
+void g_fs_write_buffers::flushed(uint32_t length) {
+	++statistics.flushes;
+	statistics.flushed_bytes += length;
+}
+
+/**
+ *
+ */
+g_fs_write_buffer_statistics g_fs_write_buffers::get_statistics() {
+	return statistics;
+}
+
+/**
+ *
+ */
+void g_fs_write_buffers::dump() {
+
+	g_log_info("%! %i buffers, %i buffered writes, %i flushes, %i bytes flushed", "writebuffer", statistics.buffers, statistics.buffered_writes,
+			statistics.flushes, statistics.flushed_bytes);
+}
@@ -0,0 +1,119 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_FSWRITEBUFFER
+#define GHOST_FILESYSTEM_FSWRITEBUFFER
+
+#include "ghost/stdint.h"
+#include "ghost/fs.h"
+#include "memory/paging.hpp"
+
+/**
+ * Size of a write buffer, the maximum number of buffers that exist at once and the
+ * time in milliseconds after which buffered data is flushed. Writes of at least the
+ * buffer size are never buffered. When fewer than {G_FS_WRITE_BUFFER_MINIMUM_FREE_PAGES}
+ * physical pages are left, no buffers are created and dirty ones are flushed.
+ */
+#define G_FS_WRITE_BUFFER_PAGES					16
+#define G_FS_WRITE_BUFFER_SIZE					(G_FS_WRITE_BUFFER_PAGES * G_PAGE_SIZE)
+#define G_FS_WRITE_BUFFER_MAXIMUM_BUFFERS		64
+#define G_FS_WRITE_BUFFER_MAXIMUM_AGE			500
+#define G_FS_WRITE_BUFFER_MINIMUM_FREE_PAGES	512
+
+/**
+ * Buffered data of a node that was written but not yet passed on to the delegate.
+ * The buffer holds one contiguous range of the file starting at {offset}. A buffer
+ * whose flush failed is kept empty with {failed} set, so that the error can be
+ * reported when the file is flushed or closed. A buffer is {detached} once the
+ * process that wrote it exited, it is then flushed without waiting for its age.
+ *
+ * The data lives in pages of its own, so they can be mapped to the window of a
+ * delegate without exposing other kernel memory.
+ */
+struct g_fs_write_buffer {
+	g_fs_virt_id node_id;
+	g_fs_phys_id phys_fs_id;
+
+	int64_t offset;
+	uint32_t length;
+	uint64_t dirty_since;
+	bool failed;
+	bool detached;
+
+	uint8_t* data;
+	g_fs_write_buffer* next;
+};
+
+/**
+ * Counters of the write buffers.
+ */
+struct g_fs_write_buffer_statistics {
+	uint32_t buffers;
+	uint32_t buffered_writes;
+	uint32_t flushes;
+	uint32_t flushed_bytes;
+};
+
+/**
+ * Allocation and accounting of the buffers that delegates use for write-back.
+ */
+class g_fs_write_buffers {
+public:
+
+	/**
+	 * Creates an empty buffer for the node.
+	 *
+	 * @return the buffer, or 0 if the maximum number of buffers exists or memory is low
+	 */
+	static g_fs_write_buffer* create(g_fs_virt_id node_id, g_fs_phys_id phys_fs_id);
+
+	/**
+	 * Frees the buffer and its pages.
+	 */
+	static void release(g_fs_write_buffer* buffer);
+
+	/**
+	 * Whether physical memory is low, so dirty buffers should be flushed.
+	 */
+	static bool memory_low();
+
+	/**
+	 * Counts a write that was taken into a buffer.
+	 */
+	static void buffered();
+
+	/**
+	 * Counts a flush of the given number of bytes.
+	 */
+	static void flushed(uint32_t length);
+
+	/**
+	 *
+	 */
+	static g_fs_write_buffer_statistics get_statistics();
+
+	/**
+	 * Writes the counters to the log.
+	 */
+	static void dump();
+
+};
+
+#endif
@@ -0,0 +1,342 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/io_rings.hpp"
+#include "filesystem/filesystem.hpp"
+#include "filesystem/fs_transaction_handler_read.hpp"
+#include "filesystem/fs_transaction_handler_write.hpp"
+#include "filesystem/fs_transaction_handler_discovery_open.hpp"
+#include "filesystem/fs_transaction_handler_read_directory.hpp"
+#include "filesystem/fs_transaction_handler_flush_close.hpp"
+#include "ghost/calls/calls_filesystem.hpp"
+#include "ghost/utils/local.hpp"
+#include "memory/address_space.hpp"
+#include "memory/physical/pp_allocator.hpp"
+#include "utils/hash_map.hpp"
+#include "logger/logger.hpp"
+
+static g_hash_map<g_pid, g_io_ring_state*>* rings;
+
+/**
+ *
+ */
+static g_io_ring_state* get_state(g_process* process) {
+
+	auto entry = rings->get(process->main->id);
+	if (entry) {
+		return entry->value;
+	}
+	return 0;
+}
+
+/**
+ * Starts the operation like the respective system call would, but for the main thread
+ * of the process. If the filesystem attaches a waiter to the thread, it is detached
+ * and kept with the operation.
+ */
+static void start(g_io_ring_state* state, g_io_ring_operation* operation) {
+
+	g_thread* task = state->process->main;
+	g_waiter* previous = task->waitManager;
+	task->waitManager = 0;
+
+	operation->status = G_IO_COMPLETION_SUCCESSFUL;
+
+	if (operation->operation == G_IO_OPERATION_READ) {
+		g_syscall_fs_read* data = (g_syscall_fs_read*) operation->data;
+
+		g_fs_node* node;
+		g_file_descriptor_content* fd;
+		if (g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
+			g_contextual<g_syscall_fs_read*> bound_data(data, task->process->pageDirectory);
+			g_fs_transaction_handler_read* handler = new g_fs_transaction_handler_read(node, fd, bound_data);
+			if (handler->start_transaction(task) == G_FS_TRANSACTION_START_FAILED) {
+				data->status = G_FS_READ_ERROR;
+			}
+		} else {
+			data->status = G_FS_READ_INVALID_FD;
+		}
+
+	} else if (operation->operation == G_IO_OPERATION_WRITE) {
+		g_syscall_fs_write* data = (g_syscall_fs_write*) operation->data;
+
+		g_fs_node* node;
+		g_file_descriptor_content* fd;
+		if (g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
+			g_contextual<g_syscall_fs_write*> bound_data(data, task->process->pageDirectory);
+			g_fs_transaction_handler_write* handler = new g_fs_transaction_handler_write(node, fd, bound_data);
+			if (handler->start_transaction(task) == G_FS_TRANSACTION_START_FAILED) {
+				data->status = G_FS_WRITE_ERROR;
+			}
+		} else {
+			data->status = G_FS_WRITE_INVALID_FD;
+		}
+
+	} else if (operation->operation == G_IO_OPERATION_OPEN) {
+		g_syscall_fs_open* data = (g_syscall_fs_open*) operation->data;
+
+		g_fs_node* base = g_filesystem::get_path_base(task->process, data->path);
+
+		g_contextual<g_syscall_fs_open*> bound_data(data, task->process->pageDirectory);
+		g_fs_transaction_handler_discovery_open* handler = new g_fs_transaction_handler_discovery_open(base, data->path, bound_data);
+		g_filesystem::discover_path(task, handler->base, handler->path, handler);
+
+	} else if (operation->operation == G_IO_OPERATION_CLOSE) {
+		g_syscall_fs_close* data = (g_syscall_fs_close*) operation->data;
+
+		g_fs_node* node;
+		g_file_descriptor_content* fd;
+		if (g_filesystem::node_for_descriptor(task->process, data->fd, &node, &fd)) {
+			g_contextual<g_syscall_fs_close*> bound_data(data, task->process->pageDirectory);
+			g_fs_transaction_handler_flush_close* handler = new g_fs_transaction_handler_flush_close(node, data->fd, bound_data);
+			if (handler->start_transaction(task) == G_FS_TRANSACTION_START_FAILED) {
+				delete handler;
+				data->result = g_filesystem::close(task->process, node, fd, &data->status);
+			}
+		}
+
+	} else if (operation->operation == G_IO_OPERATION_READ_DIRECTORY) {
+		g_syscall_fs_read_directory* data = (g_syscall_fs_read_directory*) operation->data;
+
+		g_contextual<g_syscall_fs_read_directory*> bound_data(data, task->process->pageDirectory);
+		g_fs_transaction_handler_read_directory* handler = new g_fs_transaction_handler_read_directory(bound_data);
+		g_filesystem::read_directory(task, data->iterator->node_id, data->iterator->position, handler);
+
+	} else {
+		operation->status = G_IO_COMPLETION_INVALID;
+	}
+
+	operation->waiter = task->waitManager;
+	task->waitManager = previous;
+}
+
+/**
+ * Moves finished operations to the completion ring, as far as there is space.
+ */
+static void post(g_io_ring_state* state) {
+
+	g_io_ring* ring = state->ring;
+	g_io_ring_operation** pos = &state->operations;
+
+	while (*pos) {
+		g_io_ring_operation* operation = *pos;
+
+		if (operation->waiter == 0 && ring->completion_tail - ring->completion_head < G_IO_RING_ENTRIES) {
+			g_io_completion* completion = &ring->completions[ring->completion_tail % G_IO_RING_ENTRIES];
+			completion->operation = operation->operation;
+			completion->data = operation->data;
+			completion->user_data = operation->user_data;
+			completion->status = operation->status;
+			++ring->completion_tail;
+
+			*pos = operation->next;
+			delete operation;
+			--state->operation_count;
+		} else {
+			pos = &operation->next;
+		}
+	}
+}
+
+/**
+ *
+ */
+void g_io_rings::initialize() {
+	rings = new g_hash_map<g_pid, g_io_ring_state*>();
+}
+
+/**
+ *
+ */
+g_io_ring* g_io_rings::setup(g_thread* thread) {
+
+	g_process* process = thread->process;
+	g_io_ring_state* state = get_state(process);
+	if (state) {
+		return state->ring;
+	}
+
+	uint32_t pages = PAGE_ALIGN_UP(sizeof(g_io_ring)) / G_PAGE_SIZE;
+	g_virtual_address address = process->virtualRanges.allocate(pages, G_PROC_VIRTUAL_RANGE_FLAG_PHYSICAL_OWNER);
+	if (address == 0) {
+		g_log_warn("%! failed to allocate virtual range for I/O ring of process %i", "filesystem", process->main->id);
+		return 0;
+	}
+
+	for (uint32_t i = 0; i < pages; i++) {
+		g_physical_address phys = g_pp_allocator::allocate();
+		if (phys == 0) {
+			g_log_warn("%! failed to allocate physical page for I/O ring of process %i", "filesystem", process->main->id);
+			return 0;
+		}
+		g_address_space::map(address + i * G_PAGE_SIZE, phys, DEFAULT_USER_TABLE_FLAGS, DEFAULT_USER_PAGE_FLAGS);
+	}
+	g_memory::setBytes((void*) address, 0, pages * G_PAGE_SIZE);
+
+	state = new g_io_ring_state();
+	state->process = process;
+	state->ring = (g_io_ring*) address;
+	state->operations = 0;
+	state->operation_count = 0;
+	rings->put(process->main->id, state);
+
+	return state->ring;
+}
+
+/**
+ *
+ */
+bool g_io_rings::submit(g_thread* thread, uint32_t* out_submitted) {
+
+	g_io_ring_state* state = get_state(thread->process);
+	if (state == 0) {
+		return false;
+	}
+
+	g_io_ring* ring = state->ring;
+	g_io_ring_operation* last = state->operations;
+	while (last && last->next) {
+		last = last->next;
+	}
+
+	uint32_t submitted = 0;
+	while (ring->submission_head != ring->submission_tail) {
+
+		// each operation must be able to post its completion
+		if (state->operation_count + (ring->completion_tail - ring->completion_head) >= G_IO_RING_ENTRIES) {
+			break;
+		}
+
+		g_io_submission* submission = &ring->submissions[ring->submission_head % G_IO_RING_ENTRIES];
+		g_io_ring_operation* operation = new g_io_ring_operation();
+		operation->operation = submission->operation;
+		operation->data = submission->data;
+		operation->user_data = submission->user_data;
+		operation->next = 0;
+		++ring->submission_head;
+
+		start(state, operation);
+
+		if (last) {
+			last->next = operation;
+		} else {
+			state->operations = operation;
+		}
+		last = operation;
+		++state->operation_count;
+		++submitted;
+	}
+
+	post(state);
+	*out_submitted = submitted;
+	return true;
+}
+
+/**
+ *
+ */
+uint32_t g_io_rings::progress(g_process* process) {
+
+	g_io_ring_state* state = get_state(process);
+	if (state == 0) {
+		return 0;
+	}
+
+	/**
+	 * Each waiter is checked like the scheduler would do it, with the waiter put on the main
+	 * thread. A finishing handler may replace it with the waiter of a follow-up transaction.
+	 */
+	g_thread* task = process->main;
+	for (g_io_ring_operation* operation = state->operations; operation; operation = operation->next) {
+		if (operation->waiter == 0) {
+			continue;
+		}
+
+		g_waiter* previous = task->waitManager;
+		task->waitManager = operation->waiter;
+		bool keep_waiting = operation->waiter->checkWaiting(task);
+		operation->waiter = task->waitManager;
+		task->waitManager = previous;
+
+		if (!keep_waiting) {
+			delete operation->waiter;
+			operation->waiter = 0;
+		}
+	}
+
+	post(state);
+	return state->ring->completion_tail - state->ring->completion_head;
+}
+
+/**
+ *
+ */
+uint32_t g_io_rings::get_pending_count(g_process* process) {
+
+	g_io_ring_state* state = get_state(process);
+	if (state == 0) {
+		return 0;
+	}
+	return state->operation_count;
+}
+
+/**
+ *
+ */
+void g_io_rings::progress_all() {
+
+	g_page_directory current = g_address_space::get_current_space();
+
+	for (auto iter = rings->begin(); iter != rings->end(); ++iter) {
+		g_io_ring_state* state = iter->value;
+		if (state->operation_count == 0) {
+			continue;
+		}
+
+		g_address_space::switch_to_space(state->process->pageDirectory);
+		progress(state->process);
+	}
+
+	g_address_space::switch_to_space(current);
+}
+
+/**
+ *
+ */
+void g_io_rings::process_closed(g_process* process) {
+
+	g_io_ring_state* state = get_state(process);
+	if (state == 0) {
+		return;
+	}
+
+	g_io_ring_operation* operation = state->operations;
+	while (operation) {
+		g_io_ring_operation* next = operation->next;
+		if (operation->waiter) {
+			delete operation->waiter;
+		}
+		delete operation;
+		operation = next;
+	}
+
+	rings->remove(process->main->id);
+	delete state;
+}
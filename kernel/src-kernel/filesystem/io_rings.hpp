@@ -0,0 +1,114 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_IORINGS
+#define GHOST_FILESYSTEM_IORINGS
+
+#include "ghost/stdint.h"
+#include "ghost/io.h"
+#include "tasking/process.hpp"
+#include "tasking/wait/waiter.hpp"
+
+/**
+ * An operation that was taken from the submission ring. While the operation
+ * is in flight, its waiter is the one that the filesystem attached for the
+ * transaction. Once the waiter is gone, the operation waits for a free slot
+ * in the completion ring.
+ */
+struct g_io_ring_operation {
+	g_io_operation operation;
+	void* data;
+	uint64_t user_data;
+	g_io_completion_status status;
+
+	g_waiter* waiter;
+	g_io_ring_operation* next;
+};
+
+/**
+ * Kernel side of the I/O ring of a process.
+ */
+struct g_io_ring_state {
+	g_process* process;
+	g_io_ring* ring;
+
+	g_io_ring_operation* operations;
+	uint32_t operation_count;
+};
+
+/**
+ * I/O rings let a process submit filesystem operations without blocking a thread
+ * for each of them. Operations are started on behalf of the main thread of the
+ * process using the regular transaction handlers; the waiter that a transaction
+ * would put on the thread is instead kept with the operation and checked whenever
+ * a delegate updates a transaction status or the process enters the ring.
+ */
+class g_io_rings {
+public:
+
+	/**
+	 *
+	 */
+	static void initialize();
+
+	/**
+	 * Creates the ring of the threads process, or returns the existing one.
+	 *
+	 * @return the address of the ring within the process or 0 on failure
+	 */
+	static g_io_ring* setup(g_thread* thread);
+
+	/**
+	 * Starts the operations in the submission ring of the threads process.
+	 * Only as many operations are taken as there are free completion slots.
+	 * Must be called within the space of the process.
+	 *
+	 * @param out_submitted		is filled with the number of taken submissions
+	 * @return whether the process has a ring
+	 */
+	static bool submit(g_thread* thread, uint32_t* out_submitted);
+
+	/**
+	 * Checks the operations of the process that are in flight and posts the
+	 * completions of finished ones. Must be called within the space of the process.
+	 *
+	 * @return the number of completions that are available to the process
+	 */
+	static uint32_t progress(g_process* process);
+
+	/**
+	 * Returns the number of operations of the process that are not
+	 * yet posted to the completion ring.
+	 */
+	static uint32_t get_pending_count(g_process* process);
+
+	/**
+	 * Progresses the rings of all processes that have operations in flight.
+	 */
+	static void progress_all();
+
+	/**
+	 * Removes the ring of a process that is being destroyed.
+	 */
+	static void process_closed(g_process* process);
+
+};
+
+#endif
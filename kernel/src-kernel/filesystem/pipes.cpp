@@ -21,6 +21,11 @@
 #include "filesystem/pipes.hpp"
 #include "logger/logger.hpp"
 #include "utils/hash_map.hpp"
+#include "memory/address_space.hpp"
+#include "memory/memory.hpp"
+#include "memory/physical/pp_allocator.hpp"
+#include "memory/physical/pp_reference_tracker.hpp"
+#include "kernel.hpp"
 
 /**
  *
@@ -38,24 +43,257 @@ void g_pipes::initialize() {
 /**
  *
  */
-g_pipe_id g_pipes::create() {
+g_pipe_id g_pipes::create(uint32_t capacity) {
 
-	g_pipe_id id = -1;
+	if (capacity == 0) {
+		capacity = PIPE_DEFAULT_CAPACITY;
+	}
+	if (capacity > PIPE_MAXIMUM_CAPACITY) {
+		return -1;
+	}
 
 	g_pipe* pipe = new g_pipe();
-	pipe->buffer = new uint8_t[PIPE_DEFAULT_CAPACITY];
-	pipe->write = pipe->buffer;
-	pipe->read = pipe->buffer;
+	pipe->first = 0;
+	pipe->last = 0;
 	pipe->size = 0;
-	pipe->capacity = PIPE_DEFAULT_CAPACITY;
+	pipe->capacity = PAGE_ALIGN_UP(capacity);
 	pipe->references = 0;
 
-	if (pipe->buffer != 0) {
-		id = pipe_next_id++;
-		pipes->put(id, pipe);
+	g_pipe_id id = pipe_next_id++;
+	pipes->put(id, pipe);
+	return id;
+}
+
+/**
+ *
+ */
+static g_pipe_page* allocate_page() {
+
+	g_physical_address physical = g_pp_allocator::allocate();
+	if (physical == 0) {
+		return 0;
 	}
 
-	return id;
+	g_virtual_address virt = g_kernel_virt_addr_ranges->allocate(1);
+	if (virt == 0) {
+		g_pp_allocator::free(physical);
+		return 0;
+	}
+
+	g_address_space::map(virt, physical, DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+	g_pp_reference_tracker::increment(physical);
+
+	g_pipe_page* page = new g_pipe_page();
+	page->physical = physical;
+	page->data = (uint8_t*) virt;
+	page->start = 0;
+	page->end = 0;
+	page->shared = false;
+	page->next = 0;
+	return page;
+}
+
+/**
+ * Drops the reference of the pipe on the physical page, which is freed if no one
+ * else uses it.
+ */
+static void release_page(g_pipe_page* page) {
+
+	g_address_space::unmap((g_virtual_address) page->data);
+	g_kernel_virt_addr_ranges->free((g_virtual_address) page->data);
+
+	if (g_pp_reference_tracker::decrement(page->physical) == 0) {
+		g_pp_allocator::free(page->physical);
+	}
+	delete page;
+}
+
+/**
+ *
+ */
+static void append_page(g_pipe* pipe, g_pipe_page* page) {
+
+	page->next = 0;
+	if (pipe->last) {
+		pipe->last->next = page;
+	} else {
+		pipe->first = page;
+	}
+	pipe->last = page;
+}
+
+/**
+ *
+ */
+static g_pipe_page* take_first_page(g_pipe* pipe) {
+
+	g_pipe_page* page = pipe->first;
+	pipe->first = page->next;
+	if (pipe->first == 0) {
+		pipe->last = 0;
+	}
+	page->next = 0;
+	return page;
+}
+
+/**
+ *
+ */
+uint32_t g_pipes::get_space(g_pipe* pipe) {
+	return pipe->capacity - pipe->size;
+}
+
+/**
+ *
+ */
+uint32_t g_pipes::read(g_pipe* pipe, uint8_t* buffer, uint32_t length) {
+
+	uint32_t done = 0;
+	while (done < length && pipe->first) {
+		g_pipe_page* page = pipe->first;
+
+		uint32_t available = page->end - page->start;
+		uint32_t amount = (length - done < available) ? (length - done) : available;
+		g_memory::copy(&buffer[done], &page->data[page->start], amount);
+		page->start += amount;
+		done += amount;
+
+		if (page->start == page->end) {
+			release_page(take_first_page(pipe));
+		}
+	}
+	pipe->size -= done;
+
+	if (done > 0) {
+		pipe->writers.wake_all();
+	}
+	return done;
+}
+
+/**
+ *
+ */
+uint32_t g_pipes::write(g_pipe* pipe, const uint8_t* buffer, uint32_t length) {
+
+	uint32_t space = pipe->capacity - pipe->size;
+	if (length > space) {
+		length = space;
+	}
+
+	uint32_t done = 0;
+	while (done < length) {
+		// fill up the last page, unless it is shared
+		g_pipe_page* page = pipe->last;
+		if (page == 0 || page->shared || page->end == G_PAGE_SIZE) {
+			page = allocate_page();
+			if (page == 0) {
+				g_log_warn("%! failed to allocate a page for a pipe", "pipes");
+				break;
+			}
+			append_page(pipe, page);
+		}
+
+		uint32_t free = G_PAGE_SIZE - page->end;
+		uint32_t amount = (length - done < free) ? (length - done) : free;
+		g_memory::copy(&page->data[page->end], &buffer[done], amount);
+		page->end += amount;
+		done += amount;
+	}
+	pipe->size += done;
+
+	if (done > 0) {
+		pipe->readers.wake_all();
+	}
+	return done;
+}
+
+/**
+ *
+ */
+uint32_t g_pipes::splice(g_pipe* source, g_pipe* target, uint32_t length) {
+
+	if (source == target) {
+		return 0;
+	}
+
+	uint32_t space = target->capacity - target->size;
+	if (length > space) {
+		length = space;
+	}
+
+	uint32_t done = 0;
+	while (done < length && source->first) {
+		g_pipe_page* page = source->first;
+		uint32_t available = page->end - page->start;
+
+		if (available <= length - done) {
+			// relink the whole page
+			take_first_page(source);
+			append_page(target, page);
+			done += available;
+
+		} else {
+			// copy the part of a page that fits
+			g_pipe_page* copy = allocate_page();
+			if (copy == 0) {
+				break;
+			}
+			uint32_t amount = length - done;
+			g_memory::copy(copy->data, &page->data[page->start], amount);
+			copy->end = amount;
+			page->start += amount;
+			append_page(target, copy);
+			done += amount;
+		}
+	}
+	source->size -= done;
+	target->size += done;
+
+	if (done > 0) {
+		source->writers.wake_all();
+		target->readers.wake_all();
+	}
+	return done;
+}
+
+/**
+ *
+ */
+uint32_t g_pipes::append_pages(g_pipe* pipe, g_physical_address* pages, uint32_t count, uint32_t displacement, uint32_t length) {
+
+	uint32_t remaining = length;
+	uint32_t i = 0;
+	for (; i < count; i++) {
+		// each page gets its own range so that it can be released on its own
+		g_virtual_address virt = g_kernel_virt_addr_ranges->allocate(1);
+		if (virt == 0) {
+			break;
+		}
+		g_address_space::map(virt, pages[i], DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+
+		g_pipe_page* page = new g_pipe_page();
+		page->physical = pages[i];
+		page->data = (uint8_t*) virt;
+		page->start = (i == 0) ? displacement : 0;
+		uint32_t available = G_PAGE_SIZE - page->start;
+		page->end = page->start + ((remaining < available) ? remaining : available);
+		page->shared = true;
+		remaining -= page->end - page->start;
+		append_page(pipe, page);
+	}
+	pipe->size += length - remaining;
+
+	// drop the references on pages that could not be mapped
+	for (; i < count; i++) {
+		if (g_pp_reference_tracker::decrement(pages[i]) == 0) {
+			g_pp_allocator::free(pages[i]);
+		}
+	}
+
+	if (remaining < length) {
+		pipe->readers.wake_all();
+	}
+	return length - remaining;
 }
 
 /**
@@ -132,8 +370,14 @@ void g_pipes::remove_reference(g_pipe_id id, g_pid pid) {
 			pipes->remove(id);
 
 			g_log_debug("%! removing non-referenced pipe %i", "pipes", id);
-			delete pipe->buffer;
+			while (pipe->first) {
+				release_page(take_first_page(pipe));
+			}
 			delete pipe;
+		} else {
+			// a blocked end may have been waiting for this process
+			pipe->readers.wake_all();
+			pipe->writers.wake_all();
 		}
 	}
 }
@@ -24,7 +24,8 @@
 #include "ghost/stdint.h"
 #include "utils/list_entry.hpp"
 #include "tasking/process.hpp"
-#include "filesystem/pipes.hpp"
+#include "tasking/wait/wait_queue.hpp"
+#include "memory/paging.hpp"
 
 /**
  *
@@ -32,20 +33,46 @@
 typedef int g_pipe_id;
 
 /**
+ * Capacity of a pipe in bytes if none is given on creation, and the limit
+ * for the capacity.
+ */
+#define PIPE_DEFAULT_CAPACITY	0x10000
+#define PIPE_MAXIMUM_CAPACITY	0x100000
+
+/**
+ * A page of pipe contents. The bytes from "start" to "end" are not yet read.
+ * Pages are allocated when data is written and freed once they are read
+ * completely, so an idle pipe holds no memory.
  *
+ * A shared page has its physical page referenced somewhere else too, like a
+ * page that was spliced from a file; it is never written to.
  */
-#define PIPE_DEFAULT_CAPACITY	0x400
+struct g_pipe_page {
+	g_physical_address physical;
+	uint8_t* data;
+	uint32_t start;
+	uint32_t end;
+	bool shared;
+
+	g_pipe_page* next;
+};
 
 /**
  *
  */
 struct g_pipe {
-	uint8_t* buffer;
-	uint8_t* write;
-	uint8_t* read;
+	g_pipe_page* first;
+	g_pipe_page* last;
 	uint32_t size;
 	uint32_t capacity;
 
+	/**
+	 * Woken when data was written to the pipe or space was freed in it. Both
+	 * are also woken when a process drops its reference.
+	 */
+	g_wait_queue readers;
+	g_wait_queue writers;
+
 	g_list_entry<g_pid>* references;
 };
 
@@ -66,9 +93,51 @@ public:
 	static g_pipe* get(g_pipe_id id);
 
 	/**
+	 * Creates a pipe. The capacity is rounded up to full pages; if it is zero
+	 * the default capacity is used.
 	 *
+	 * @return the id of the pipe, or -1 if the capacity is invalid
+	 */
+	static g_pipe_id create(uint32_t capacity = 0);
+
+	/**
+	 * Copies up to "length" bytes out of the pipe and wakes the writers.
+	 *
+	 * @return the number of bytes that were read
+	 */
+	static uint32_t read(g_pipe* pipe, uint8_t* buffer, uint32_t length);
+
+	/**
+	 * Copies up to "length" bytes into the free space of the pipe and wakes
+	 * the readers.
+	 *
+	 * @return the number of bytes that were written
+	 */
+	static uint32_t write(g_pipe* pipe, const uint8_t* buffer, uint32_t length);
+
+	/**
+	 * Moves up to "length" bytes from one pipe to another. Pages that are moved
+	 * completely are relinked instead of copied.
+	 *
+	 * @return the number of bytes that were moved
+	 */
+	static uint32_t splice(g_pipe* source, g_pipe* target, uint32_t length);
+
+	/**
+	 * Appends physical pages to the pipe without copying them. The pipe takes
+	 * over one reference on each page; the data starts at "displacement" in the
+	 * first page and is "length" bytes long. The caller must make sure that
+	 * the data fits into the free space of the pipe.
+	 *
+	 * @return the number of bytes that were appended, less than "length" if not
+	 * all pages could be mapped
+	 */
+	static uint32_t append_pages(g_pipe* pipe, g_physical_address* pages, uint32_t count, uint32_t displacement, uint32_t length);
+
+	/**
+	 * Returns the number of bytes that can currently be written to the pipe.
 	 */
-	static g_pipe_id create();
+	static uint32_t get_space(g_pipe* pipe);
 
 	/**
 	 *
@@ -0,0 +1,432 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "filesystem/tmpfs.hpp"
+#include "logger/logger.hpp"
+#include "utils/hash_map.hpp"
+#include "utils/string.hpp"
+#include "memory/address_space.hpp"
+#include "memory/memory.hpp"
+#include "memory/physical/pp_allocator.hpp"
+#include "memory/physical/pp_reference_tracker.hpp"
+#include "kernel.hpp"
+
+/**
+ *
+ */
+static g_tmpfs_id tmpfs_next_id = 0;
+static g_hash_map<g_tmpfs_id, g_tmpfs_node*>* nodes;
+static g_tmpfs_node* name_buckets[G_TMPFS_NAME_BUCKETS];
+static g_tmpfs_node* root;
+static uint32_t used_pages = 0;
+
+/**
+ *
+ */
+static g_tmpfs_node* create_node(g_fs_node_type type, const char* name) {
+
+	g_tmpfs_node* node = new g_tmpfs_node();
+	node->id = tmpfs_next_id++;
+	node->type = type;
+	node->name = new char[g_string::length(name) + 1];
+	g_string::copy(node->name, name);
+	node->parent = 0;
+	node->next_in_bucket = 0;
+	node->children = 0;
+	node->child_count = 0;
+	node->child_capacity = 0;
+	node->length = 0;
+	node->chunks = 0;
+	node->chunk_count = 0;
+
+	nodes->put(node->id, node);
+	return node;
+}
+
+/**
+ *
+ */
+void g_tmpfs::initialize() {
+
+	nodes = new g_hash_map<g_tmpfs_id, g_tmpfs_node*>();
+	for (uint32_t i = 0; i < G_TMPFS_NAME_BUCKETS; i++) {
+		name_buckets[i] = 0;
+	}
+	root = create_node(G_FS_NODE_TYPE_FOLDER, "");
+}
+
+/**
+ *
+ */
+g_tmpfs_node* g_tmpfs::get_root() {
+	return root;
+}
+
+/**
+ *
+ */
+g_tmpfs_node* g_tmpfs::get(g_tmpfs_id id) {
+
+	auto entry = nodes->get(id);
+
+	if (entry) {
+		return entry->value;
+	}
+	return 0;
+}
+
+/**
+ *
+ */
+uint32_t g_tmpfs::hash(g_tmpfs_id parent_id, const char* name) {
+
+	uint32_t hash = 2166136261U;
+	for (int i = 0; i < 4; i++) {
+		hash ^= (parent_id >> (i * 8)) & 0xFF;
+		hash *= 16777619U;
+	}
+	while (*name) {
+		hash ^= (uint8_t) *name++;
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+/**
+ *
+ */
+g_tmpfs_node* g_tmpfs::find_child(g_tmpfs_node* parent, const char* name) {
+
+	g_tmpfs_node* current = name_buckets[hash(parent->id, name) % G_TMPFS_NAME_BUCKETS];
+	while (current) {
+		if (current->parent == parent && g_string::equals(current->name, name)) {
+			break;
+		}
+		current = current->next_in_bucket;
+	}
+
+	return current;
+}
+
+/**
+ *
+ */
+g_tmpfs_node* g_tmpfs::create(g_tmpfs_node* parent, const char* name, g_fs_node_type type) {
+
+	if (parent->type != G_FS_NODE_TYPE_FOLDER || (type != G_FS_NODE_TYPE_FILE && type != G_FS_NODE_TYPE_FOLDER)) {
+		return 0;
+	}
+
+	// check if the name is taken
+	uint32_t bucket = hash(parent->id, name) % G_TMPFS_NAME_BUCKETS;
+	g_tmpfs_node* current = name_buckets[bucket];
+	while (current) {
+		if (current->parent == parent && g_string::equals(current->name, name)) {
+			return 0;
+		}
+		current = current->next_in_bucket;
+	}
+
+	// grow the child list of the parent
+	if (parent->child_count == parent->child_capacity) {
+		uint32_t capacity = parent->child_capacity == 0 ? 8 : parent->child_capacity * 2;
+		g_tmpfs_node** children = new g_tmpfs_node*[capacity];
+		for (uint32_t i = 0; i < parent->child_count; i++) {
+			children[i] = parent->children[i];
+		}
+		if (parent->children) {
+			delete[] parent->children;
+		}
+		parent->children = children;
+		parent->child_capacity = capacity;
+	}
+
+	g_tmpfs_node* node = create_node(type, name);
+	node->parent = parent;
+	node->next_in_bucket = name_buckets[bucket];
+	name_buckets[bucket] = node;
+	parent->children[parent->child_count++] = node;
+
+	return node;
+}
+
+/**
+ *
+ */
+g_tmpfs_page* g_tmpfs::get_page(g_tmpfs_node* file, uint32_t index, bool allocate) {
+
+	uint32_t chunk_index = index / G_TMPFS_CHUNK_PAGES;
+
+	// grow the chunk list
+	if (chunk_index >= file->chunk_count) {
+		if (!allocate) {
+			return 0;
+		}
+
+		uint32_t chunk_count = file->chunk_count == 0 ? 1 : file->chunk_count;
+		while (chunk_count <= chunk_index) {
+			chunk_count *= 2;
+		}
+
+		g_tmpfs_page** chunks = new g_tmpfs_page*[chunk_count];
+		for (uint32_t i = 0; i < file->chunk_count; i++) {
+			chunks[i] = file->chunks[i];
+		}
+		for (uint32_t i = file->chunk_count; i < chunk_count; i++) {
+			chunks[i] = 0;
+		}
+		if (file->chunks) {
+			delete[] file->chunks;
+		}
+		file->chunks = chunks;
+		file->chunk_count = chunk_count;
+	}
+
+	// allocate the chunk
+	g_tmpfs_page* chunk = file->chunks[chunk_index];
+	if (chunk == 0) {
+		if (!allocate) {
+			return 0;
+		}
+
+		chunk = new g_tmpfs_page[G_TMPFS_CHUNK_PAGES];
+		for (uint32_t i = 0; i < G_TMPFS_CHUNK_PAGES; i++) {
+			chunk[i].physical = 0;
+			chunk[i].data = 0;
+		}
+		file->chunks[chunk_index] = chunk;
+	}
+
+	// allocate the page
+	g_tmpfs_page* page = &chunk[index % G_TMPFS_CHUNK_PAGES];
+	if (page->physical == 0) {
+		if (!allocate) {
+			return 0;
+		}
+
+		if (used_pages >= G_TMPFS_MAXIMUM_PAGES) {
+			return 0;
+		}
+		++used_pages;
+
+		g_physical_address physical = g_pp_allocator::allocate();
+		g_virtual_address virt = physical ? g_kernel_virt_addr_ranges->allocate(1) : 0;
+		if (virt == 0) {
+			if (physical) {
+				g_pp_allocator::free(physical);
+			}
+			--used_pages;
+			return 0;
+		}
+
+		g_address_space::map(virt, physical, DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+		g_pp_reference_tracker::increment(physical);
+		g_memory::setBytes((void*) virt, 0, G_PAGE_SIZE);
+
+		page->physical = physical;
+		page->data = (uint8_t*) virt;
+	}
+
+	return page;
+}
+
+/**
+ * Drops the reference of the tmpfs on each page. Pages that are still mapped
+ * into a process are only freed once they are unmapped there.
+ */
+void g_tmpfs::release_pages(g_tmpfs_node* file, uint32_t first) {
+
+	uint32_t released = 0;
+
+	for (uint32_t c = first / G_TMPFS_CHUNK_PAGES; c < file->chunk_count; c++) {
+		g_tmpfs_page* chunk = file->chunks[c];
+		if (chunk == 0) {
+			continue;
+		}
+
+		uint32_t start = (c == first / G_TMPFS_CHUNK_PAGES) ? first % G_TMPFS_CHUNK_PAGES : 0;
+		for (uint32_t i = start; i < G_TMPFS_CHUNK_PAGES; i++) {
+			g_tmpfs_page* page = &chunk[i];
+			if (page->physical == 0) {
+				continue;
+			}
+
+			g_address_space::unmap((g_virtual_address) page->data);
+			g_kernel_virt_addr_ranges->free((g_virtual_address) page->data);
+			if (g_pp_reference_tracker::decrement(page->physical) == 0) {
+				g_pp_allocator::free(page->physical);
+			}
+			page->physical = 0;
+			page->data = 0;
+			++released;
+		}
+
+		// drop chunks that are entirely released
+		if (start == 0) {
+			delete[] chunk;
+			file->chunks[c] = 0;
+		}
+	}
+
+	used_pages -= released;
+}
+
+/**
+ *
+ */
+int64_t g_tmpfs::read(g_tmpfs_node* file, int64_t offset, uint8_t* buffer, int64_t length) {
+
+	if (offset < 0 || offset >= file->length) {
+		return 0;
+	}
+	if (offset + length > file->length) {
+		length = file->length - offset;
+	}
+
+	int64_t done = 0;
+	while (done < length) {
+		int64_t position = offset + done;
+		uint32_t in_page = position % G_PAGE_SIZE;
+		int64_t amount = G_PAGE_SIZE - in_page;
+		if (amount > length - done) {
+			amount = length - done;
+		}
+
+		g_tmpfs_page* page = get_page(file, position / G_PAGE_SIZE, false);
+		if (page) {
+			g_memory::copy(&buffer[done], &page->data[in_page], amount);
+		} else {
+			g_memory::setBytes(&buffer[done], 0, amount);
+		}
+		done += amount;
+	}
+
+	return done;
+}
+
+/**
+ *
+ */
+int64_t g_tmpfs::write(g_tmpfs_node* file, int64_t offset, const uint8_t* buffer, int64_t length) {
+
+	if (offset < 0 || offset + length > (int64_t) G_TMPFS_MAXIMUM_PAGES * G_PAGE_SIZE) {
+		return -1;
+	}
+
+	int64_t done = 0;
+	while (done < length) {
+		int64_t position = offset + done;
+		uint32_t in_page = position % G_PAGE_SIZE;
+		int64_t amount = G_PAGE_SIZE - in_page;
+		if (amount > length - done) {
+			amount = length - done;
+		}
+
+		g_tmpfs_page* page = get_page(file, position / G_PAGE_SIZE, true);
+		if (page == 0) {
+			g_log_warn("%! out of pages when writing to file %i", "tmpfs", file->id);
+			break;
+		}
+		g_memory::copy(&page->data[in_page], &buffer[done], amount);
+		done += amount;
+	}
+
+	if (offset + done > file->length) {
+		file->length = offset + done;
+	}
+
+	return (done == 0 && length > 0) ? -1 : done;
+}
+
+/**
+ *
+ */
+bool g_tmpfs::truncate(g_tmpfs_node* file, int64_t length) {
+
+	if (file->type != G_FS_NODE_TYPE_FILE || length < 0 || length > (int64_t) G_TMPFS_MAXIMUM_PAGES * G_PAGE_SIZE) {
+		return false;
+	}
+
+	if (length < file->length) {
+		// clear the rest of the last page, it might be extended again later
+		uint32_t in_page = length % G_PAGE_SIZE;
+		if (in_page > 0) {
+			g_tmpfs_page* page = get_page(file, length / G_PAGE_SIZE, false);
+			if (page) {
+				g_memory::setBytes(&page->data[in_page], 0, G_PAGE_SIZE - in_page);
+			}
+		}
+		release_pages(file, PAGE_ALIGN_UP(length) / G_PAGE_SIZE);
+	}
+	file->length = length;
+
+	return true;
+}
+
+/**
+ *
+ */
+g_fs_map_status g_tmpfs::acquire_pages(g_tmpfs_node* file, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+		uint32_t* out_count, uint32_t* out_displacement, int64_t* out_length) {
+
+	if (file->type != G_FS_NODE_TYPE_FILE) {
+		return G_FS_MAP_NOT_SUPPORTED;
+	}
+
+	if (offset < 0 || length <= 0 || offset >= file->length) {
+		return G_FS_MAP_INVALID_RANGE;
+	}
+	if (offset + length > file->length) {
+		length = file->length - offset;
+	}
+	if (length > (int64_t) capacity * G_PAGE_SIZE - offset % G_PAGE_SIZE) {
+		length = (int64_t) capacity * G_PAGE_SIZE - offset % G_PAGE_SIZE;
+	}
+
+	uint32_t first = offset / G_PAGE_SIZE;
+	uint32_t end = PAGE_ALIGN_UP(offset + length) / G_PAGE_SIZE;
+
+	uint32_t count = 0;
+	for (uint32_t index = first; index < end; index++) {
+		g_tmpfs_page* page = get_page(file, index, true);
+		if (page == 0) {
+			// drop what was already taken
+			for (uint32_t i = 0; i < count; i++) {
+				g_pp_reference_tracker::decrement(out_pages[i]);
+			}
+			return G_FS_MAP_ERROR;
+		}
+
+		g_pp_reference_tracker::increment(page->physical);
+		out_pages[count++] = page->physical;
+	}
+
+	*out_count = count;
+	*out_displacement = offset % G_PAGE_SIZE;
+	*out_length = length;
+	return G_FS_MAP_SUCCESSFUL;
+}
+
+/**
+ *
+ */
+uint32_t g_tmpfs::get_used_pages() {
+	return used_pages;
+}
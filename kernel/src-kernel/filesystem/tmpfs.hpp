@@ -0,0 +1,163 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_FILESYSTEM_TMPFS
+#define GHOST_FILESYSTEM_TMPFS
+
+#include "ghost/stdint.h"
+#include "ghost/fs.h"
+#include "memory/paging.hpp"
+
+/**
+ *
+ */
+typedef uint32_t g_tmpfs_id;
+
+/**
+ * Number of buckets in the name table, number of pages that a chunk of a file
+ * page table covers, and the number of pages that all files together may use.
+ */
+#define G_TMPFS_NAME_BUCKETS	1024
+#define G_TMPFS_CHUNK_PAGES		512
+#define G_TMPFS_MAXIMUM_PAGES	0x4000
+
+/**
+ * A page of file contents, mapped into the kernel. A page without a physical
+ * address is a hole and reads as zeros.
+ */
+struct g_tmpfs_page {
+	g_physical_address physical;
+	uint8_t* data;
+};
+
+/**
+ * A node in the tmpfs. Folders keep their children in creation order; every
+ * node is also in the name table, hashed by the parent id and its name.
+ *
+ * File contents are kept in a sparse page table. The table is a list of chunks,
+ * each covering {G_TMPFS_CHUNK_PAGES} pages, and a chunk is only allocated once
+ * a page within it is written.
+ */
+struct g_tmpfs_node {
+	g_tmpfs_id id;
+	g_fs_node_type type;
+	char* name;
+	g_tmpfs_node* parent;
+	g_tmpfs_node* next_in_bucket;
+
+	g_tmpfs_node** children;
+	uint32_t child_count;
+	uint32_t child_capacity;
+
+	int64_t length;
+	g_tmpfs_page** chunks;
+	uint32_t chunk_count;
+};
+
+/**
+ * Memory-backed filesystem. All state lives in the kernel, the contents of
+ * files are held in physical pages.
+ */
+class g_tmpfs {
+public:
+
+	/**
+	 *
+	 */
+	static void initialize();
+
+	/**
+	 *
+	 */
+	static g_tmpfs_node* get_root();
+
+	/**
+	 *
+	 */
+	static g_tmpfs_node* get(g_tmpfs_id id);
+
+	/**
+	 * Looks up the child with the given name in the name table.
+	 *
+	 * @return the child, or 0 if it doesn't exist
+	 */
+	static g_tmpfs_node* find_child(g_tmpfs_node* parent, const char* name);
+
+	/**
+	 * Creates a file or folder within the parent folder.
+	 *
+	 * @return the new node, or 0 if the parent is no folder or the name is taken
+	 */
+	static g_tmpfs_node* create(g_tmpfs_node* parent, const char* name, g_fs_node_type type);
+
+	/**
+	 * Copies up to "length" bytes from the file at "offset" into the buffer.
+	 *
+	 * @return the number of bytes that were read
+	 */
+	static int64_t read(g_tmpfs_node* file, int64_t offset, uint8_t* buffer, int64_t length);
+
+	/**
+	 * Copies "length" bytes from the buffer into the file at "offset", extending
+	 * the file if required.
+	 *
+	 * @return the number of bytes that were written, less than the length if the
+	 * page budget of the tmpfs is exhausted, or -1 if nothing could be written
+	 */
+	static int64_t write(g_tmpfs_node* file, int64_t offset, const uint8_t* buffer, int64_t length);
+
+	/**
+	 * Sets the length of the file. Pages beyond the new end are released; when
+	 * growing, the new range is a hole.
+	 */
+	static bool truncate(g_tmpfs_node* file, int64_t length);
+
+	/**
+	 * Takes a reference on each physical page that holds the given range of the
+	 * file; holes within the range are filled with zeroed pages first. The range
+	 * is cut so that its pages fit into the capacity of the output array.
+	 */
+	static g_fs_map_status acquire_pages(g_tmpfs_node* file, int64_t offset, int64_t length, g_physical_address* out_pages, uint32_t capacity,
+			uint32_t* out_count, uint32_t* out_displacement, int64_t* out_length);
+
+	/**
+	 * @return the number of pages that are used for file contents
+	 */
+	static uint32_t get_used_pages();
+
+private:
+	/**
+	 * Returns the page at the given index of the file. If "allocate" is set, the
+	 * chunk and page are allocated if necessary; otherwise 0 is returned for holes.
+	 */
+	static g_tmpfs_page* get_page(g_tmpfs_node* file, uint32_t index, bool allocate);
+
+	/**
+	 * Releases all pages of the file from the given index on.
+	 */
+	static void release_pages(g_tmpfs_node* file, uint32_t first);
+
+	/**
+	 *
+	 */
+	static uint32_t hash(g_tmpfs_id parent_id, const char* name);
+};
+
+#endif
@@ -30,10 +30,13 @@
 #include "system/smp/global_lock.hpp"
 #include "tasking/tasking.hpp"
 #include "filesystem/filesystem.hpp"
+#include "filesystem/io_rings.hpp"
+#include "tasking/communication/topics.hpp"
 
 #include "memory/gdt/gdt_manager.hpp"
 #include "memory/kernel_heap.hpp"
 #include "memory/physical/pp_allocator.hpp"
+#include "memory/physical/pp_reference_tracker.hpp"
 #include "memory/paging.hpp"
 #include "memory/address_space.hpp"
 #include "memory/temporary_paging_util.hpp"
@@ -141,6 +144,12 @@ void g_kernel::run_bsp(g_physical_address initial_pd_physical) {
 		// Initialize filesystem
 		g_filesystem::initialize();
 
+		// Initialize publish/subscribe topics
+		g_topics::initialize();
+
+		// Initialize asynchronous I/O rings
+		g_io_rings::initialize();
+
 		// Create initial process
 		load_system_process(G_IDLE_BINARY_NAME, g_thread_priority::IDLE);
 		load_system_process(G_INIT_BINARY_NAME, g_thread_priority::NORMAL);
@@ -294,6 +303,9 @@ void g_kernel::load_ramdisk(g_multiboot_module* ramdiskModule) {
 		g_virtual_address virt = ramdiskNewLocation + i * G_PAGE_SIZE;
 		g_physical_address phys = g_address_space::virtual_to_physical(ramdiskModule->moduleStart + i * G_PAGE_SIZE);
 		g_address_space::map(virt, phys, DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+
+		// the ramdisk holds a reference, so file mappings never free its pages
+		g_pp_reference_tracker::increment(phys);
 	}
 
 	ramdiskModule->moduleEnd = ramdiskNewLocation + (ramdiskModule->moduleEnd - ramdiskModule->moduleStart);
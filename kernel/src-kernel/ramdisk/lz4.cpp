@@ -0,0 +1,96 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <ramdisk/lz4.hpp>
+
+/**
+ * Reads the extension bytes of a literal or match length.
+ */
+static bool readLength(const uint8_t** in, const uint8_t* inEnd, uint32_t* length) {
+
+	uint8_t value;
+	do {
+		if (*in >= inEnd) {
+			return false;
+		}
+		value = *(*in)++;
+		*length += value;
+	} while (value == 255);
+	return true;
+}
+
+/**
+ * 
+ */
+int32_t g_lz4::decompress(const uint8_t* source, uint32_t sourceLength, uint8_t* target, uint32_t targetLength) {
+
+	const uint8_t* in = source;
+	const uint8_t* inEnd = source + sourceLength;
+	uint8_t* out = target;
+	uint8_t* outEnd = target + targetLength;
+
+	while (in < inEnd) {
+		uint8_t token = *in++;
+
+		// literals
+		uint32_t literalLength = token >> 4;
+		if (literalLength == 15 && !readLength(&in, inEnd, &literalLength)) {
+			return -1;
+		}
+		if (literalLength > (uint32_t) (inEnd - in) || literalLength > (uint32_t) (outEnd - out)) {
+			return -1;
+		}
+		for (uint32_t i = 0; i < literalLength; i++) {
+			*out++ = *in++;
+		}
+
+		// the last sequence has no match
+		if (in == inEnd) {
+			break;
+		}
+
+		// match
+		if (inEnd - in < 2) {
+			return -1;
+		}
+		uint32_t offset = in[0] | (in[1] << 8);
+		in += 2;
+		if (offset == 0 || offset > (uint32_t) (out - target)) {
+			return -1;
+		}
+
+		uint32_t matchLength = token & 0xF;
+		if (matchLength == 15 && !readLength(&in, inEnd, &matchLength)) {
+			return -1;
+		}
+		matchLength += 4;
+		if (matchLength > (uint32_t) (outEnd - out)) {
+			return -1;
+		}
+
+		// byte-wise, since the match may overlap with the output
+		const uint8_t* match = out - offset;
+		for (uint32_t i = 0; i < matchLength; i++) {
+			*out++ = *match++;
+		}
+	}
+
+	return out - target;
+}
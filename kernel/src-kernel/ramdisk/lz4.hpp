@@ -0,0 +1,45 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_RAMDISK_LZ4
+#define GHOST_RAMDISK_LZ4
+
+#include "ghost/stdint.h"
+
+/**
+ * Decompressor for the LZ4 block format, used for compressed ramdisk files.
+ */
+class g_lz4 {
+public:
+
+	/**
+	 * Decompresses a single LZ4 block.
+	 *
+	 * @param source		the compressed block
+	 * @param sourceLength	length of the compressed block
+	 * @param target		the output buffer
+	 * @param targetLength	size of the output buffer
+	 * @return the number of decompressed bytes, or -1 if the block is malformed
+	 */
+	static int32_t decompress(const uint8_t* source, uint32_t sourceLength, uint8_t* target, uint32_t targetLength);
+
+};
+
+#endif
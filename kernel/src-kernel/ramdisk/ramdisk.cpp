@@ -21,8 +21,12 @@
 #include <kernel.hpp>
 
 #include <ramdisk/ramdisk.hpp>
+#include <ramdisk/lz4.hpp>
 #include <utils/string.hpp>
 #include <logger/logger.hpp>
+#include <memory/address_space.hpp>
+#include <memory/physical/pp_allocator.hpp>
+#include <memory/physical/pp_reference_tracker.hpp>
 
 /**
  * 
@@ -30,6 +34,11 @@
 g_ramdisk::g_ramdisk() {
 	root = 0;
 	firstHeader = 0;
+	entriesById = 0;
+	entriesByIdLength = 0;
+	for (uint32_t i = 0; i < G_RAMDISK_NAME_BUCKETS; i++) {
+		nameBuckets[i] = 0;
+	}
 }
 
 /**
@@ -39,14 +48,48 @@ g_ramdisk_entry* g_ramdisk::load(g_multiboot_module* module) {
 	// Get the ramdisk location and its end from the multiboot info
 	uint8_t* ramdisk = (uint8_t*) module->moduleStart;
 	uint32_t ramdiskEnd = module->moduleEnd;
+	uint32_t ramdiskLength = ramdiskEnd - module->moduleStart;
 
 	// Create a root RamdiskEntry
 	root = new g_ramdisk_entry;
+	root->next = 0;
+	root->type = G_RAMDISK_ENTRY_TYPE_FOLDER;
 	root->id = 0;
+	root->parentid = 0;
+	root->name = (char*) "";
+	root->datalength = 0;
+	root->data = 0;
+	root->compression = G_RAMDISK_COMPRESSION_NONE;
+	root->storedLength = 0;
+	root->storedData = 0;
 
 	// Initialize the header storage location
 	firstHeader = 0;
 
+	// Images that start with the magic have the indexed format
+	bool indexed = ramdiskLength >= sizeof(g_ramdisk_image_header);
+	for (uint32_t i = 0; indexed && i < G_RAMDISK_MAGIC_LENGTH; i++) {
+		indexed = ramdisk[i] == (uint8_t) G_RAMDISK_MAGIC[i];
+	}
+
+	if (indexed) {
+		if (!loadIndexed(ramdisk, ramdiskLength)) {
+			g_log_warn("%! ramdisk image is malformed", "ramdisk");
+			firstHeader = 0;
+		}
+	} else {
+		loadLegacy(ramdisk, ramdiskEnd);
+	}
+
+	buildIndex();
+	return this->root;
+}
+
+/**
+ *
+ */
+void g_ramdisk::loadLegacy(uint8_t* ramdisk, uint32_t ramdiskEnd) {
+
 	// Create the position
 	uint32_t ramdiskPosition = 0;
 
@@ -88,6 +131,7 @@ g_ramdisk_entry* g_ramdisk::load(g_multiboot_module* module) {
 		header->name = new char[namelength + 1];
 		g_memory::copy(header->name, nameptr, namelength);
 		header->name[namelength] = 0;
+		header->nameLength = namelength;
 		ramdiskPosition += namelength;
 
 		// If its a file, load rest
@@ -104,9 +148,239 @@ g_ramdisk_entry* g_ramdisk::load(g_multiboot_module* module) {
 			header->datalength = 0;
 			header->data = 0;
 		}
+
+		header->compression = G_RAMDISK_COMPRESSION_NONE;
+		header->storedLength = header->datalength;
+		header->storedData = header->data;
 	}
+}
 
-	return this->root;
+/**
+ * The names are used directly from the string table of the image, which
+ * contains null-terminated names.
+ */
+bool g_ramdisk::loadIndexed(uint8_t* ramdisk, uint32_t ramdiskLength) {
+
+	g_ramdisk_image_header* imageHeader = (g_ramdisk_image_header*) ramdisk;
+	if (imageHeader->version != G_RAMDISK_VERSION) {
+		g_log_warn("%! unsupported ramdisk version %i", "ramdisk", imageHeader->version);
+		return false;
+	}
+
+	uint32_t entryCount = imageHeader->entryCount;
+	if (imageHeader->entryTableOffset > ramdiskLength
+			|| entryCount > (ramdiskLength - imageHeader->entryTableOffset) / sizeof(g_ramdisk_image_entry)) {
+		return false;
+	}
+	if (imageHeader->stringTableOffset > ramdiskLength || imageHeader->stringTableLength > ramdiskLength - imageHeader->stringTableOffset) {
+		return false;
+	}
+
+	g_ramdisk_image_entry* imageEntries = (g_ramdisk_image_entry*) (ramdisk + imageHeader->entryTableOffset);
+	char* strings = (char*) (ramdisk + imageHeader->stringTableOffset);
+	uint32_t stringsLength = imageHeader->stringTableLength;
+
+	if (entryCount == 0) {
+		return true;
+	}
+	g_ramdisk_entry* entries = new g_ramdisk_entry[entryCount];
+
+	for (uint32_t i = 0; i < entryCount; i++) {
+		g_ramdisk_image_entry* imageEntry = &imageEntries[i];
+		g_ramdisk_entry* entry = &entries[i];
+
+		if (imageEntry->nameOffset >= stringsLength || imageEntry->nameLength >= stringsLength - imageEntry->nameOffset
+				|| strings[imageEntry->nameOffset + imageEntry->nameLength] != 0) {
+			delete[] entries;
+			return false;
+		}
+
+		entry->next = (i + 1 < entryCount) ? &entries[i + 1] : 0;
+		entry->type = static_cast<g_ramdisk_entry_type>(imageEntry->type);
+		entry->id = imageEntry->id;
+		entry->parentid = imageEntry->parentId;
+		entry->name = &strings[imageEntry->nameOffset];
+		entry->nameLength = imageEntry->nameLength;
+
+		if (entry->type == G_RAMDISK_ENTRY_TYPE_FILE) {
+			if (imageEntry->dataOffset > ramdiskLength || imageEntry->storedLength > ramdiskLength - imageEntry->dataOffset) {
+				delete[] entries;
+				return false;
+			}
+
+			entry->compression = imageEntry->compression;
+			entry->storedLength = imageEntry->storedLength;
+			entry->storedData = ramdisk + imageEntry->dataOffset;
+			entry->datalength = imageEntry->length;
+			entry->data = (entry->compression == G_RAMDISK_COMPRESSION_NONE) ? entry->storedData : 0;
+
+		} else {
+			entry->compression = G_RAMDISK_COMPRESSION_NONE;
+			entry->storedLength = 0;
+			entry->storedData = 0;
+			entry->datalength = 0;
+			entry->data = 0;
+		}
+	}
+
+	firstHeader = entries;
+	return true;
+}
+
+/**
+ *
+ */
+uint8_t* g_ramdisk::getData(g_ramdisk_entry* entry) {
+
+	if (entry->data || entry->type != G_RAMDISK_ENTRY_TYPE_FILE) {
+		return entry->data;
+	}
+
+	if (entry->data == 0 && !decompress(entry)) {
+		g_log_warn("%! failed to decompress '%s'", "ramdisk", entry->name);
+	}
+
+	return entry->data;
+}
+
+/**
+ * Unmaps and frees the first "count" pages at "base" and the virtual range.
+ */
+static void releasePages(g_virtual_address base, uint32_t count) {
+
+	for (uint32_t i = 0; i < count; i++) {
+		g_virtual_address virt = base + i * G_PAGE_SIZE;
+		g_physical_address physical = g_address_space::virtual_to_physical(virt);
+		g_address_space::unmap(virt);
+		if (g_pp_reference_tracker::decrement(physical) == 0) {
+			g_pp_allocator::free(physical);
+		}
+	}
+	g_kernel_virt_addr_ranges->free(base);
+}
+
+/**
+ * The contents are decompressed into separate physical pages, so that files can
+ * still be mapped like uncompressed ones. Like the pages of the ramdisk module,
+ * they keep a reference forever.
+ */
+bool g_ramdisk::decompress(g_ramdisk_entry* entry) {
+
+	if (entry->compression != G_RAMDISK_COMPRESSION_LZ4) {
+		return false;
+	}
+
+	uint32_t pages = PAGE_ALIGN_UP(entry->datalength) / G_PAGE_SIZE;
+	if (pages == 0) {
+		pages = 1;
+	}
+
+	g_virtual_address base = g_kernel_virt_addr_ranges->allocate(pages);
+	if (base == 0) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < pages; i++) {
+		g_physical_address physical = g_pp_allocator::allocate();
+		if (physical == 0) {
+			releasePages(base, i);
+			return false;
+		}
+		g_address_space::map(base + i * G_PAGE_SIZE, physical, DEFAULT_KERNEL_TABLE_FLAGS, DEFAULT_KERNEL_PAGE_FLAGS);
+		g_pp_reference_tracker::increment(physical);
+	}
+
+	uint8_t* target = (uint8_t*) base;
+	int32_t length = g_lz4::decompress(entry->storedData, entry->storedLength, target, entry->datalength);
+	if (length != (int32_t) entry->datalength) {
+		releasePages(base, pages);
+		return false;
+	}
+	g_memory::setBytes(target + length, 0, pages * G_PAGE_SIZE - length);
+
+	entry->data = target;
+	return true;
+}
+
+/**
+ *
+ */
+void g_ramdisk::buildIndex() {
+
+	// create the id index
+	uint32_t highestId = 0;
+	for (g_ramdisk_entry* entry = firstHeader; entry; entry = entry->next) {
+		if (entry->id > highestId) {
+			highestId = entry->id;
+		}
+	}
+
+	entriesByIdLength = highestId + 1;
+	entriesById = new g_ramdisk_entry*[entriesByIdLength];
+	for (uint32_t i = 0; i < entriesByIdLength; i++) {
+		entriesById[i] = 0;
+	}
+
+	root->children = 0;
+	root->childCount = 0;
+	root->nameLength = 0;
+	root->nextInBucket = 0;
+	entriesById[0] = root;
+
+	for (g_ramdisk_entry* entry = firstHeader; entry; entry = entry->next) {
+		entry->children = 0;
+		entry->childCount = 0;
+		entry->nextInBucket = 0;
+		if (entry->id != 0) {
+			entriesById[entry->id] = entry;
+		}
+	}
+
+	// count the children of each folder, then fill the child lists in ramdisk order
+	for (g_ramdisk_entry* entry = firstHeader; entry; entry = entry->next) {
+		g_ramdisk_entry* parent = findById(entry->parentid);
+		if (parent) {
+			++parent->childCount;
+		}
+	}
+
+	for (uint32_t i = 0; i < entriesByIdLength; i++) {
+		g_ramdisk_entry* folder = entriesById[i];
+		if (folder && folder->childCount > 0) {
+			folder->children = new g_ramdisk_entry*[folder->childCount];
+			folder->childCount = 0;
+		}
+	}
+
+	for (g_ramdisk_entry* entry = firstHeader; entry; entry = entry->next) {
+		g_ramdisk_entry* parent = findById(entry->parentid);
+		if (parent) {
+			parent->children[parent->childCount++] = entry;
+		}
+
+		uint32_t bucket = hashName(entry->parentid, entry->name, entry->nameLength) % G_RAMDISK_NAME_BUCKETS;
+		entry->nextInBucket = nameBuckets[bucket];
+		nameBuckets[bucket] = entry;
+	}
+
+	g_log_debug("%! indexed %i entries", "ramdisk", entriesByIdLength);
+}
+
+/**
+ * FNV-1a over the parent id and the name
+ */
+uint32_t g_ramdisk::hashName(uint32_t parentId, const char* name, uint32_t nameLength) {
+
+	uint32_t hash = 2166136261U;
+	for (uint32_t i = 0; i < 4; i++) {
+		hash ^= (parentId >> (i * 8)) & 0xFF;
+		hash *= 16777619U;
+	}
+	for (uint32_t i = 0; i < nameLength; i++) {
+		hash ^= (uint8_t) name[i];
+		hash *= 16777619U;
+	}
+	return hash;
 }
 
 /**
@@ -114,12 +388,27 @@ g_ramdisk_entry* g_ramdisk::load(g_multiboot_module* module) {
  */
 g_ramdisk_entry* g_ramdisk::findChild(g_ramdisk_entry* parent, const char* childName) {
 
-	g_ramdisk_entry* current = firstHeader;
-	do {
-		if (current->parentid == parent->id && g_string::equals(current->name, childName)) {
-			return current;
+	return findChild(parent, childName, g_string::length(childName));
+}
+
+/**
+ *
+ */
+g_ramdisk_entry* g_ramdisk::findChild(g_ramdisk_entry* parent, const char* name, uint32_t nameLength) {
+
+	g_ramdisk_entry* current = nameBuckets[hashName(parent->id, name, nameLength) % G_RAMDISK_NAME_BUCKETS];
+	while (current) {
+		if (current->parentid == parent->id && current->nameLength == nameLength) {
+			uint32_t i = 0;
+			while (i < nameLength && current->name[i] == name[i]) {
+				++i;
+			}
+			if (i == nameLength) {
+				return current;
+			}
 		}
-	} while ((current = current->next) != 0);
+		current = current->nextInBucket;
+	}
 
 	return 0;
 }
@@ -128,23 +417,15 @@ g_ramdisk_entry* g_ramdisk::findChild(g_ramdisk_entry* parent, const char* child
  * 
  */
 g_ramdisk_entry* g_ramdisk::findById(uint32_t id) {
-	g_ramdisk_entry* foundNode = 0;
 
 	if (id == 0) {
 		return root;
 	}
 
-	g_ramdisk_entry* currentNode = firstHeader;
-	while (currentNode != 0) {
-		if (currentNode->id == id) {
-			foundNode = currentNode;
-			break;
-		}
-
-		currentNode = currentNode->next;
+	if (id < entriesByIdLength) {
+		return entriesById[id];
 	}
-
-	return foundNode;
+	return 0;
 }
 
 /**
@@ -156,36 +437,28 @@ g_ramdisk_entry* g_ramdisk::findAbsolute(const char* path) {
 }
 
 /**
- * Searches for the entry at the given the relative path to the given node.
+ * Searches for the entry at the given the relative path to the given node. Each
+ * path component is looked up in place, without copying the path.
  */
 g_ramdisk_entry* g_ramdisk::findRelative(g_ramdisk_entry* node, const char* path) {
-	char buf[G_RAMDISK_MAXIMUM_PATH_LENGTH];
-	uint32_t pathLen = g_string::length(path);
-	g_memory::copy(buf, path, pathLen);
-	buf[pathLen] = 0;
 
 	g_ramdisk_entry* currentNode = node;
-	while (g_string::length(buf) > 0) {
-		int slashIndex = g_string::indexOf(buf, '/');
-		if (slashIndex >= 0) {
-			// Set current node to next layer
-			if (slashIndex > 0) {
-				char childpath[G_RAMDISK_MAXIMUM_PATH_LENGTH];
-				g_memory::copy(childpath, buf, slashIndex);
-				childpath[slashIndex] = 0;
-
-				currentNode = findChild(currentNode, childpath);
-			}
+	const char* component = path;
+	while (currentNode && *component) {
+		const char* end = component;
+		while (*end && *end != '/') {
+			++end;
+		}
 
-			// Cut off layer
-			uint32_t len = g_string::length(buf) - (slashIndex + 1);
-			g_memory::copy(buf, &buf[slashIndex + 1], len);
-			buf[len] = 0;
-		} else {
-			// Reached the last node, find the child
-			currentNode = findChild(currentNode, buf);
+		// Set current node to next layer, empty components are skipped
+		if (end > component) {
+			currentNode = findChild(currentNode, component, end - component);
+		}
+
+		if (*end == 0) {
 			break;
 		}
+		component = end + 1;
 	}
 	return currentNode;
 }
@@ -195,17 +468,11 @@ g_ramdisk_entry* g_ramdisk::findRelative(g_ramdisk_entry* node, const char* path
  */
 uint32_t g_ramdisk::getChildCount(uint32_t id) {
 
-	uint32_t count = 0;
-
-	g_ramdisk_entry* currentNode = firstHeader;
-	while (currentNode != 0) {
-		if (currentNode->parentid == id) {
-			++count;
-		}
-		currentNode = currentNode->next;
+	g_ramdisk_entry* entry = findById(id);
+	if (entry) {
+		return entry->childCount;
 	}
-
-	return count;
+	return 0;
 }
 
 /**
@@ -213,20 +480,10 @@ uint32_t g_ramdisk::getChildCount(uint32_t id) {
  */
 g_ramdisk_entry* g_ramdisk::getChildAt(uint32_t id, uint32_t index) {
 
-	uint32_t pos = 0;
-
-	g_ramdisk_entry* currentNode = firstHeader;
-	while (currentNode != 0) {
-		if (currentNode->parentid == id) {
-			if (pos == index) {
-				return currentNode;
-			}
-
-			++pos;
-		}
-		currentNode = currentNode->next;
+	g_ramdisk_entry* entry = findById(id);
+	if (entry && index < entry->childCount) {
+		return entry->children[index];
 	}
-
 	return 0;
 }
 
@@ -26,6 +26,11 @@
 #include <ramdisk/ramdisk_entry.hpp>
 #include <multiboot/multiboot.hpp>
 
+/**
+ * Number of buckets of the hash that finds entries by parent and name.
+ */
+#define G_RAMDISK_NAME_BUCKETS		1024
+
 /**
  * Ramdisk class
  */
@@ -34,6 +39,45 @@ private:
 	g_ramdisk_entry* firstHeader;
 	g_ramdisk_entry* root;
 
+	/**
+	 * Entries indexed by their id, and buckets for the lookup by parent and name.
+	 * Both are built once when the ramdisk is loaded.
+	 */
+	g_ramdisk_entry** entriesById;
+	uint32_t entriesByIdLength;
+	g_ramdisk_entry* nameBuckets[G_RAMDISK_NAME_BUCKETS];
+
+	/**
+	 * Reads a version 1 image, which is a flat sequence of records.
+	 */
+	void loadLegacy(uint8_t* ramdisk, uint32_t ramdiskEnd);
+
+	/**
+	 * Reads a version 2 image with an entry and a string table.
+	 */
+	bool loadIndexed(uint8_t* ramdisk, uint32_t ramdiskLength);
+
+	/**
+	 * Decompresses the contents of the entry into newly allocated pages.
+	 */
+	bool decompress(g_ramdisk_entry* entry);
+
+	/**
+	 * Builds the id index, the child lists of all folders and the name hash.
+	 */
+	void buildIndex();
+
+	/**
+	 * Searches in the folder parent for an entry with the given name, that does not
+	 * need to be null-terminated.
+	 */
+	g_ramdisk_entry* findChild(g_ramdisk_entry* parent, const char* name, uint32_t nameLength);
+
+	/**
+	 *
+	 */
+	static uint32_t hashName(uint32_t parentId, const char* name, uint32_t nameLength);
+
 public:
 	/**
 	 * Initializes the empty ramdisk. A ramdisk is never deleted, therefore
@@ -100,6 +144,15 @@ public:
 	 */
 	g_ramdisk_entry* getChildAt(uint32_t id, uint32_t index);
 
+	/**
+	 * Returns the contents of a file entry. Compressed files are decompressed
+	 * on the first access; the contents then stay in memory.
+	 *
+	 * @param entry	the file entry
+	 * @return the contents, or 0 if they can not be provided
+	 */
+	uint8_t* getData(g_ramdisk_entry* entry);
+
 	/**
 	 * Returns the root.
 	 */
@@ -35,6 +35,23 @@ struct g_ramdisk_entry {
 	char* name;
 	uint32_t datalength;
 	uint8_t* data;
+
+	/**
+	 * Stored form of the file contents. For compressed files, "data" stays null
+	 * until the contents are first accessed via {g_ramdisk::getData}.
+	 */
+	uint8_t compression;
+	uint32_t storedLength;
+	uint8_t* storedData;
+
+	/**
+	 * Index information, built when the ramdisk is loaded: the children of a
+	 * folder in ramdisk order, and the next entry in the same name bucket.
+	 */
+	g_ramdisk_entry** children;
+	uint32_t childCount;
+	uint32_t nameLength;
+	g_ramdisk_entry* nextInBucket;
 };
 
 #endif
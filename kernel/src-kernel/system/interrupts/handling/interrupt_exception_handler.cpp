@@ -29,6 +29,7 @@
 #include <memory/physical/pp_reference_tracker.hpp>
 #include <memory/temporary_paging_util.hpp>
 #include <memory/constants.hpp>
+#include <filesystem/fs_mappings.hpp>
 
 /**
  * Names of the exceptions
@@ -187,6 +188,12 @@ g_cpu_state* g_interrupt_exception_handler::handlePageFault(g_cpu_state* cpuStat
 		}
 	}
 
+	// Copy-on-write in a private file mapping?
+	if (g_fs_mappings::handle_copy_on_write(thread->process, accessedVirtual)) {
+		g_log_debug("%! (%i:%i) mapped file page %h copied", "cow", thread->process->main->id, thread->id, accessedVirtual);
+		return cpuState;
+	}
+
 	// raise SIGSEGV in thread
 	thread->raise_signal(SIGSEGV);
 	g_log_info("%! (core %i) raised SIGSEGV in thread %i", "pagefault", g_system::getCurrentCoreId(), thread->id);
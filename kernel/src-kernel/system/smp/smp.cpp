@@ -73,7 +73,12 @@ void g_smp::initialize(g_physical_address initialPageDirectoryPhysical) {
 		g_log_info("%*%! could not initialize due to missing apstartup object at '%s'", 0x0C, "smp", ap_startup_location);
 		return;
 	}
-	g_memory::copy((uint8_t*) G_CONST_SMP_STARTUP_AREA_CODE_START, (uint8_t*) startupObject->data, startupObject->datalength);
+	uint8_t* startupCode = g_kernel_ramdisk->getData(startupObject);
+	if (startupCode == 0) {
+		g_log_info("%*%! could not initialize due to unreadable apstartup object at '%s'", 0x0C, "smp", ap_startup_location);
+		return;
+	}
+	g_memory::copy((uint8_t*) G_CONST_SMP_STARTUP_AREA_CODE_START, startupCode, startupObject->datalength);
 
 	// Start APs
 	g_cpu* n = g_system::getCpus();
@@ -247,6 +247,38 @@ g_message_receive_status g_message_controller::receive_message(g_tid target, g_m
 	return G_MESSAGE_RECEIVE_STATUS_SUCCESSFUL;
 }
 
+/**
+ *
+ */
+bool g_message_controller::has_message(g_tid target, g_message_transaction tx) {
+
+	// check for map
+	if (queues == 0) {
+		return false;
+	}
+
+	// find queue head
+	auto entry = queues->get(target);
+	if (entry == nullptr) {
+		return false;
+	}
+
+	// any message is fine
+	g_message_header* n = entry->value->first;
+	if (tx == G_MESSAGE_TRANSACTION_NONE) {
+		return n != nullptr;
+	}
+
+	// find message with transaction
+	while (n) {
+		if (n->transaction == tx) {
+			return true;
+		}
+		n = n->next;
+	}
+	return false;
+}
+
 /**
  *
  */
@@ -358,3 +390,28 @@ g_message_receive_status g_message_controller::receiveWithTopic(uint32_t task, u
 	return G_MESSAGE_RECEIVE_STATUS_QUEUE_EMPTY;
 }
 
+
+/**
+ *
+ */
+bool g_message_controller::hasMessageWithTopic(uint32_t task, uint32_t topic) {
+
+	// Search for queue
+	g_message_queue* n = firstQueue;
+	while (n != 0) {
+		if (n->taskId == task) {
+			break;
+		}
+		n = n->next;
+	}
+
+	if (n != 0) {
+		for (int32_t i = 0; i < n->count; i++) {
+			if (n->messages[i].topic == topic) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
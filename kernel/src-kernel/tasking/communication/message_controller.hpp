@@ -54,10 +54,12 @@ public:
 	static g_message_send_status send(uint32_t taskId, g_message* message);
 	static g_message_receive_status receive(uint32_t taskId, g_message& target);
 	static g_message_receive_status receiveWithTopic(uint32_t taskId, uint32_t topic, g_message& target);
+	static bool hasMessageWithTopic(uint32_t taskId, uint32_t topic);
 
 	static void clear(g_tid tid);
 	static g_message_send_status send_message(g_tid target, g_tid source, void* message, size_t length, g_message_transaction tx);
 	static g_message_receive_status receive_message(g_tid target, g_message_header* out, size_t max, g_message_transaction tx);
+	static bool has_message(g_tid target, g_message_transaction tx);
 };
 
 #endif
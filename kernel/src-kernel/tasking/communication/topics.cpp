@@ -0,0 +1,324 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "tasking/communication/topics.hpp"
+#include "logger/logger.hpp"
+#include "utils/hash_map.hpp"
+#include "utils/string.hpp"
+#include "memory/memory.hpp"
+
+static g_topic_id topic_next_id = 0;
+static g_hash_map<g_topic_id, g_topic*>* topics;
+
+static g_topic_subscription subscription_next_id = 0;
+static g_hash_map<g_topic_subscription, g_topic_subscriber*>* subscribers;
+
+/**
+ *
+ */
+void g_topics::initialize() {
+	topics = new g_hash_map<g_topic_id, g_topic*>();
+	subscribers = new g_hash_map<g_topic_subscription, g_topic_subscriber*>();
+}
+
+/**
+ *
+ */
+g_topic_id g_topics::open(const char* name) {
+
+	int length = g_string::length(name);
+	if (length == 0 || length >= G_TOPIC_NAME_MAXIMUM_LENGTH) {
+		return -1;
+	}
+
+	// find existing topic
+	for (auto it = topics->begin(); it != topics->end(); ++it) {
+		if (g_string::equals(it->value->name, name)) {
+			g_topic_id id = it->key;
+			return id;
+		}
+	}
+
+	// create a new one
+	g_topic* topic = new g_topic();
+	topic->id = topic_next_id++;
+	topic->name = new char[length + 1];
+	g_string::copy(topic->name, name);
+	topic->subscribers = 0;
+	topics->put(topic->id, topic);
+
+	g_log_debug("%! created topic '%s' with id %i", "topics", topic->name, topic->id);
+	return topic->id;
+}
+
+/**
+ *
+ */
+g_topic_subscription g_topics::subscribe(g_tid tid, g_topic_id topic_id, g_topic_backpressure policy, uint32_t capacity) {
+
+	if (capacity == 0 || capacity > G_TOPIC_MAXIMUM_CAPACITY) {
+		return -1;
+	}
+	if (policy != G_TOPIC_BACKPRESSURE_DROP_OLDEST && policy != G_TOPIC_BACKPRESSURE_BLOCK) {
+		return -1;
+	}
+
+	auto topic_entry = topics->get(topic_id);
+	if (topic_entry == 0) {
+		return -1;
+	}
+	g_topic* topic = topic_entry->value;
+
+	g_topic_subscriber* subscriber = new g_topic_subscriber();
+	subscriber->id = subscription_next_id++;
+	subscriber->tid = tid;
+	subscriber->topic = topic;
+	subscriber->policy = policy;
+	subscriber->queue = new g_topic_payload*[capacity];
+	subscriber->capacity = capacity;
+	subscriber->head = 0;
+	subscriber->count = 0;
+	subscriber->dropped = 0;
+
+	g_list_entry<g_topic_subscriber*>* entry = new g_list_entry<g_topic_subscriber*>;
+	entry->value = subscriber;
+	entry->next = topic->subscribers;
+	topic->subscribers = entry;
+
+	subscribers->put(subscriber->id, subscriber);
+
+	return subscriber->id;
+}
+
+/**
+ *
+ */
+bool g_topics::unsubscribe(g_tid tid, g_topic_subscription subscription) {
+
+	auto subscriber_entry = subscribers->get(subscription);
+	if (subscriber_entry == 0 || subscriber_entry->value->tid != tid) {
+		return false;
+	}
+	g_topic_subscriber* subscriber = subscriber_entry->value;
+	g_topic* topic = subscriber->topic;
+	subscribers->remove(subscription);
+
+	// remove from topic
+	g_list_entry<g_topic_subscriber*>* prev = 0;
+	g_list_entry<g_topic_subscriber*>* entry = topic->subscribers;
+	while (entry) {
+		if (entry->value == subscriber) {
+			if (prev == 0) {
+				topic->subscribers = entry->next;
+			} else {
+				prev->next = entry->next;
+			}
+			delete entry;
+			break;
+		}
+		prev = entry;
+		entry = entry->next;
+	}
+
+	// release queued messages
+	while (subscriber->count > 0) {
+		release_payload(subscriber->queue[subscriber->head]);
+		subscriber->head = (subscriber->head + 1) % subscriber->capacity;
+		subscriber->count--;
+	}
+	delete subscriber->queue;
+
+	// deleting the subscriber wakes its readers, blocked publishers might continue
+	delete subscriber;
+	topic->writers.wake_all();
+
+	return true;
+}
+
+/**
+ *
+ */
+g_topic_payload* g_topics::create_payload(g_tid publisher, void* data, size_t length) {
+
+	uint8_t* memory = new uint8_t[sizeof(g_topic_payload) + length];
+	if (memory == 0) {
+		return 0;
+	}
+
+	g_topic_payload* payload = (g_topic_payload*) memory;
+	payload->references = 1;
+	payload->publisher = publisher;
+	payload->length = length;
+	payload->data = memory + sizeof(g_topic_payload);
+	g_memory::copy(payload->data, data, length);
+	return payload;
+}
+
+/**
+ *
+ */
+void g_topics::release_payload(g_topic_payload* payload) {
+
+	if (__sync_sub_and_fetch(&payload->references, 1) == 0) {
+		delete (uint8_t*) payload;
+	}
+}
+
+/**
+ *
+ */
+g_topic_publish_status g_topics::publish(g_topic_id topic_id, g_topic_payload* payload) {
+
+	auto topic_entry = topics->get(topic_id);
+	if (topic_entry == 0) {
+		return G_TOPIC_PUBLISH_STATUS_FAILED;
+	}
+	g_topic* topic = topic_entry->value;
+
+	// subscribers that want backpressure must have space
+	for (g_list_entry<g_topic_subscriber*>* entry = topic->subscribers; entry; entry = entry->next) {
+		g_topic_subscriber* subscriber = entry->value;
+		if (subscriber->policy == G_TOPIC_BACKPRESSURE_BLOCK && subscriber->count == subscriber->capacity) {
+			return G_TOPIC_PUBLISH_STATUS_QUEUE_FULL;
+		}
+	}
+
+	// fan out to all subscribers
+	for (g_list_entry<g_topic_subscriber*>* entry = topic->subscribers; entry; entry = entry->next) {
+		g_topic_subscriber* subscriber = entry->value;
+
+		if (subscriber->count == subscriber->capacity) {
+			release_payload(subscriber->queue[subscriber->head]);
+			subscriber->head = (subscriber->head + 1) % subscriber->capacity;
+			subscriber->count--;
+			subscriber->dropped++;
+		}
+
+		__sync_add_and_fetch(&payload->references, 1);
+		subscriber->queue[(subscriber->head + subscriber->count) % subscriber->capacity] = payload;
+		subscriber->count++;
+
+		subscriber->readers.wake_all();
+	}
+
+	return G_TOPIC_PUBLISH_STATUS_SUCCESSFUL;
+}
+
+/**
+ *
+ */
+g_topic_receive_status g_topics::receive(g_tid tid, g_topic_subscription subscription, void* buffer, size_t maximum, size_t* out_length,
+		uint32_t* out_dropped) {
+
+	auto subscriber_entry = subscribers->get(subscription);
+	if (subscriber_entry == 0) {
+		return G_TOPIC_RECEIVE_STATUS_FAILED;
+	}
+	g_topic_subscriber* subscriber = subscriber_entry->value;
+
+	if (subscriber->tid != tid) {
+		return G_TOPIC_RECEIVE_STATUS_FAILED_NOT_PERMITTED;
+	}
+
+	if (subscriber->count == 0) {
+		return G_TOPIC_RECEIVE_STATUS_QUEUE_EMPTY;
+	}
+
+	g_topic_payload* payload = subscriber->queue[subscriber->head];
+	if (payload->length > maximum) {
+		return G_TOPIC_RECEIVE_STATUS_EXCEEDS_BUFFER_SIZE;
+	}
+
+	g_memory::copy(buffer, payload->data, payload->length);
+	*out_length = payload->length;
+	*out_dropped = subscriber->dropped;
+
+	subscriber->head = (subscriber->head + 1) % subscriber->capacity;
+	subscriber->count--;
+	subscriber->dropped = 0;
+	release_payload(payload);
+
+	if (subscriber->policy == G_TOPIC_BACKPRESSURE_BLOCK) {
+		subscriber->topic->writers.wake_all();
+	}
+
+	return G_TOPIC_RECEIVE_STATUS_SUCCESSFUL;
+}
+
+/**
+ *
+ */
+bool g_topics::has_message(g_tid tid, g_topic_subscription subscription) {
+
+	bool has = false;
+	auto subscriber_entry = subscribers->get(subscription);
+	if (subscriber_entry && subscriber_entry->value->tid == tid) {
+		has = subscriber_entry->value->count > 0;
+	}
+
+	return has;
+}
+
+/**
+ *
+ */
+bool g_topics::wait_for_message(g_topic_subscription subscription, g_waiter_queued* waiter) {
+
+	auto subscriber_entry = subscribers->get(subscription);
+	if (subscriber_entry) {
+		waiter->enqueue(&subscriber_entry->value->readers);
+	}
+
+	return subscriber_entry != 0;
+}
+
+/**
+ *
+ */
+bool g_topics::wait_for_space(g_topic_id topic, g_waiter_queued* waiter) {
+
+	auto topic_entry = topics->get(topic);
+	if (topic_entry) {
+		waiter->enqueue(&topic_entry->value->writers);
+	}
+
+	return topic_entry != 0;
+}
+
+/**
+ *
+ */
+void g_topics::clear(g_tid tid) {
+
+	while (true) {
+		g_topic_subscription subscription = -1;
+
+		for (auto it = subscribers->begin(); it != subscribers->end(); ++it) {
+			if (it->value->tid == tid) {
+				subscription = it->key;
+				break;
+			}
+		}
+
+		if (subscription == -1 || !unsubscribe(tid, subscription)) {
+			break;
+		}
+	}
+}
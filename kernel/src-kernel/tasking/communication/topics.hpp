@@ -0,0 +1,148 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_COMMUNICATION_TOPICS
+#define GHOST_COMMUNICATION_TOPICS
+
+#include "ghost/stdint.h"
+#include "ghost/ipc.h"
+#include "utils/list_entry.hpp"
+#include "tasking/wait/wait_queue.hpp"
+
+/**
+ * Payload of a published message. It is shared by the queues of all
+ * subscribers and freed when the last reference is released.
+ */
+struct g_topic_payload {
+	uint32_t references;
+	g_tid publisher;
+	size_t length;
+	uint8_t* data;
+};
+
+struct g_topic;
+
+/**
+ * A subscription of a thread to a topic, with its own bounded queue.
+ */
+struct g_topic_subscriber {
+	g_topic_subscription id;
+	g_tid tid;
+	g_topic* topic;
+	g_topic_backpressure policy;
+
+	g_topic_payload** queue;
+	uint32_t capacity;
+	uint32_t head;
+	uint32_t count;
+	uint32_t dropped;
+
+	g_wait_queue readers;
+};
+
+/**
+ * A named topic. Publishers post once, the message is then enqueued
+ * to the queues of all subscribers.
+ */
+struct g_topic {
+	g_topic_id id;
+	char* name;
+
+	g_list_entry<g_topic_subscriber*>* subscribers;
+	g_wait_queue writers;
+};
+
+/**
+ *
+ */
+class g_topics {
+public:
+
+	/**
+	 *
+	 */
+	static void initialize();
+
+	/**
+	 * Returns the topic with the given name, creating it if it does not exist.
+	 *
+	 * @return the topic id or -1 if the name is invalid
+	 */
+	static g_topic_id open(const char* name);
+
+	/**
+	 * Subscribes the thread to the topic.
+	 *
+	 * @return the subscription id or -1 on failure
+	 */
+	static g_topic_subscription subscribe(g_tid tid, g_topic_id topic, g_topic_backpressure policy, uint32_t capacity);
+
+	/**
+	 * Removes a subscription of the thread, releasing all queued messages.
+	 */
+	static bool unsubscribe(g_tid tid, g_topic_subscription subscription);
+
+	/**
+	 * Creates a payload with one reference, that is held by the publisher.
+	 */
+	static g_topic_payload* create_payload(g_tid publisher, void* data, size_t length);
+
+	/**
+	 *
+	 */
+	static void release_payload(g_topic_payload* payload);
+
+	/**
+	 * Enqueues the payload to all subscribers of the topic. If a subscriber with
+	 * the blocking policy has a full queue, the payload is not enqueued at all
+	 * and {G_TOPIC_PUBLISH_STATUS_QUEUE_FULL} is returned.
+	 */
+	static g_topic_publish_status publish(g_topic_id topic, g_topic_payload* payload);
+
+	/**
+	 * Takes the next message from the queue of a subscription and copies it to
+	 * the buffer, which must be in the current address space.
+	 */
+	static g_topic_receive_status receive(g_tid tid, g_topic_subscription subscription, void* buffer, size_t maximum, size_t* out_length,
+			uint32_t* out_dropped);
+
+	/**
+	 *
+	 */
+	static bool has_message(g_tid tid, g_topic_subscription subscription);
+
+	/**
+	 * Enqueues the waiter to be woken when a message arrives for the subscription.
+	 */
+	static bool wait_for_message(g_topic_subscription subscription, g_waiter_queued* waiter);
+
+	/**
+	 * Enqueues the waiter to be woken when space is freed in a subscriber queue.
+	 */
+	static bool wait_for_space(g_topic_id topic, g_waiter_queued* waiter);
+
+	/**
+	 * Removes all subscriptions of the thread.
+	 */
+	static void clear(g_tid tid);
+
+};
+
+#endif
@@ -19,6 +19,7 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include <tasking/process.hpp>
+#include <filesystem/fs_descriptors.hpp>
 
 /**
  *
@@ -43,6 +44,10 @@ g_process::g_process(g_security_level securityLevel) :
 	workingDirectory = new char[G_PATH_MAX];
 	workingDirectory[0] = '/';
 	workingDirectory[1] = 0;
+	workingDirectoryNode = 0;
+	openDirectories = 0;
+
+	fileDescriptors = new g_file_descriptor_table();
 
 	tls_master_in_proc_location = 0;
 	tls_master_copysize = 0;
@@ -59,5 +64,7 @@ g_process::~g_process() {
 		delete cliArguments;
 	}
 
+	delete fileDescriptors;
+
 }
 
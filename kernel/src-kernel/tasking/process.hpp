@@ -27,11 +27,16 @@
 #include <memory/collections/address_range_pool.hpp>
 #include <system/smp/global_lock.hpp>
 
+struct g_file_descriptor_table;
+class g_fs_node;
+
 /**
  * Constants used as flags on virtual ranges of processes
  */
 #define G_PROC_VIRTUAL_RANGE_FLAG_NONE						0
 #define G_PROC_VIRTUAL_RANGE_FLAG_PHYSICAL_OWNER			1
+#define G_PROC_VIRTUAL_RANGE_FLAG_FILE_MAPPING				2
+#define G_PROC_VIRTUAL_RANGE_FLAG_COPY_ON_WRITE				4
 
 /**
  *
@@ -67,6 +72,10 @@ public:
 	g_page_directory pageDirectory;
 	char* cliArguments;
 	char* workingDirectory;
+	g_fs_node* workingDirectoryNode;
+	g_list_entry<g_fs_node*>* openDirectories;
+
+	g_file_descriptor_table* fileDescriptors;
 
 	g_address_range_pool virtualRanges;
 
@@ -32,7 +32,7 @@
  *
  */
 g_scheduler::g_scheduler(uint32_t coreId) :
-		milliseconds(0), taskList(0), current(0), coreId(coreId) {
+		milliseconds(0), taskList(0), current(0), handoff(G_TID_NONE), roundRobinPosition(0), lendingDepth(0), coreId(coreId) {
 }
 
 /**
@@ -60,6 +60,21 @@ g_cpu_state* g_scheduler::switchTask(g_cpu_state* cpuState) {
 		current->value->cpuState = cpuState;
 	}
 
+	// directed yield, the round robin continues after the yielding thread
+	if (handoff != G_TID_NONE) {
+		g_list_entry<g_thread*>* target = findEntry(handoff);
+		handoff = G_TID_NONE;
+
+		if (target && target != current) {
+			roundRobinPosition = current;
+			current = target;
+			if (applySwitch()) {
+				unlock();
+				return current->value->cpuState;
+			}
+		}
+	}
+
 	do {
 		selectNext();
 	} while (!applySwitch());
@@ -159,11 +174,42 @@ void g_scheduler::sleep(g_thread* task, uint64_t sleepies) {
 	}
 }
 
+/**
+ *
+ */
+void g_scheduler::yieldTo(g_tid target) {
+
+	lock();
+	handoff = target;
+	unlock();
+}
+
+/**
+ *
+ */
+g_list_entry<g_thread*>* g_scheduler::findEntry(g_tid id) {
+
+	g_list_entry<g_thread*>* entry = taskList;
+	while (entry) {
+		if (entry->value->id == id) {
+			return entry;
+		}
+		entry = entry->next;
+	}
+	return 0;
+}
+
 /**
  *
  */
 void g_scheduler::selectNext() {
 
+	// continue where the round robin was left for a directed yield or lending
+	if (roundRobinPosition) {
+		current = roundRobinPosition;
+		roundRobinPosition = 0;
+	}
+
 	if (current == 0) {
 		current = taskList;
 	} else {
@@ -184,6 +230,11 @@ void g_scheduler::selectNext() {
  */
 bool g_scheduler::applySwitch() {
 
+	// Skip threads that are blocked on a wait queue, without switching their space
+	if (current->value->alive && current->value->isWaiting() && current->value->waitManager->isBlocked()) {
+		return applyLending();
+	}
+
 	g_address_space::switch_to_space(current->value->process->pageDirectory);
 	g_gdt_manager::setTssEsp0(current->value->kernelStackEsp0);
 
@@ -207,8 +258,8 @@ bool g_scheduler::applySwitch() {
 	 hab ich grad keinen Nerv mir das weiter anzuschauen, deswegen bleibt das hier ^-^
 	 */
 
-	// Skip idler if possible
-	if (current->value->priority == g_thread_priority::IDLE) {
+	// Skip idler if possible, unless it runs on time lent by another thread
+	if (current->value->priority == g_thread_priority::IDLE && lendingDepth == 0) {
 
 		// Check if any other process is available (not idling or waiting)
 		g_list_entry<g_thread*> *n = taskList;
@@ -225,7 +276,7 @@ bool g_scheduler::applySwitch() {
 	// Waiting must be done after the switch because it accesses userspace data
 	bool keepWaiting = handleWaiting();
 	if (keepWaiting) {
-		return false;
+		return applyLending();
 	}
 
 	// Set segments for user thread, set segment to user segment
@@ -259,6 +310,10 @@ void g_scheduler::deleteCurrent() {
 
 	current = oldEntry->next;
 
+	if (roundRobinPosition == oldEntry) {
+		roundRobinPosition = 0;
+	}
+
 	// Delete the task
 	g_thread_manager::deleteTask(oldEntry->value);
 	delete oldEntry;
@@ -278,6 +333,40 @@ void g_scheduler::print_waiter_deadlock_warning() {
 			current->value->waitManager->debug_name());
 }
 
+/**
+ * The current thread keeps waiting. If its waiter knows the thread that must
+ * run for the wait to end, the time slice is lent to that thread instead. This
+ * way a server runs with the priority of its clients and the latency of a call
+ * is not bound to the round robin reaching the server.
+ */
+bool g_scheduler::applyLending() {
+
+	if (lendingDepth >= G_SCHEDULER_MAXIMUM_LENDING_DEPTH) {
+		return false;
+	}
+
+	g_tid owner = current->value->waitManager->getOwner();
+	if (owner == G_TID_NONE) {
+		return false;
+	}
+
+	g_list_entry<g_thread*>* entry = findEntry(owner);
+	if (entry == 0 || entry == current) {
+		return false;
+	}
+
+	// run the owner in place of the waiting thread
+	if (roundRobinPosition == 0) {
+		roundRobinPosition = current;
+	}
+	current = entry;
+
+	++lendingDepth;
+	bool applied = applySwitch();
+	--lendingDepth;
+	return applied;
+}
+
 /**
  *
  */
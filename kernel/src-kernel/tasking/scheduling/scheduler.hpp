@@ -27,6 +27,12 @@
 #include <system/cpu_state.hpp>
 #include <system/smp/global_recursive_lock.hpp>
 
+/**
+ * Maximum length of a chain of waiting threads that lend their time
+ * slice to the thread they are waiting for
+ */
+#define G_SCHEDULER_MAXIMUM_LENDING_DEPTH	8
+
 /**
  *
  */
@@ -38,10 +44,20 @@ private:
 	g_list_entry<g_thread*>* taskList;
 	g_list_entry<g_thread*>* current;
 
+	/**
+	 * Thread to run on the next switch (directed yield), and the position to
+	 * continue the round robin from once a thread ran out of order.
+	 */
+	g_tid handoff;
+	g_list_entry<g_thread*>* roundRobinPosition;
+	uint32_t lendingDepth;
+
 	uint32_t coreId;
 
 	void selectNext();
 	bool applySwitch();
+	bool applyLending();
+	g_list_entry<g_thread*>* findEntry(g_tid id);
 
 	bool handleWaiting();
 	void deleteCurrent();
@@ -55,6 +71,12 @@ public:
 	g_cpu_state* switchTask(g_cpu_state* cpuState);
 	void add(g_thread* t);
 
+	/**
+	 * Makes the given thread run on the next switch if it is assigned to this
+	 * scheduler and runnable, otherwise the switch is a normal yield.
+	 */
+	void yieldTo(g_tid target);
+
 	uint32_t getLoad();
 
 	g_thread* getCurrent();
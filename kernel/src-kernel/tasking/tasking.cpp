@@ -138,6 +138,36 @@ void g_tasking::addTask(g_thread* t, bool enforceCurrentCore) {
 	target->add(t);
 }
 
+/**
+ * 
+ */
+void g_tasking::addTaskToOtherCore(g_thread* t) {
+
+	g_scheduler* current = getCurrentScheduler();
+
+	// Find other core with lowest load
+	g_scheduler* lowest = 0;
+	uint32_t lowestLoad = 0;
+
+	for (uint32_t i = 0; i < g_system::getCpuCount(); i++) {
+		g_scheduler* sched = schedulers[i];
+		if (sched && sched != current) {
+			uint32_t load = sched->getLoad();
+			if (lowest == 0 || load < lowestLoad) {
+				lowest = sched;
+				lowestLoad = load;
+			}
+		}
+	}
+
+	// Single core systems
+	if (lowest == 0) {
+		lowest = current;
+	}
+
+	lowest->add(t);
+}
+
 /**
  * Returns the current scheduler on the current core
  */
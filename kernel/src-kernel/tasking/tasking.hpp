@@ -54,6 +54,12 @@ public:
 	 */
 	static void addTask(g_thread* proc, bool enforceCurrentCore = false);
 
+	/**
+	 * Adds the task to the least loaded scheduler of all cores except the current
+	 * one. If there is no other core, the task is added to the current core.
+	 */
+	static void addTaskToOtherCore(g_thread* proc);
+
 	/**
 	 * Returns the current task on the current core
 	 */
@@ -37,7 +37,10 @@
 #include "tasking/tasking.hpp"
 #include "tasking/process.hpp"
 #include "filesystem/filesystem.hpp"
+#include "filesystem/io_rings.hpp"
+#include "filesystem/fs_mappings.hpp"
 #include "tasking/communication/message_controller.hpp"
+#include "tasking/communication/topics.hpp"
 
 /**
  *
@@ -261,6 +264,9 @@ g_thread* g_thread_manager::fork(g_thread* current) {
 	process->imageEnd = parent->imageEnd;
 	process->imageStart = parent->imageStart;
 
+	// Inherit open file descriptors
+	g_filesystem::process_forked(parent, process);
+
 	// Forked process has no virtual ranges // TODO keep shared regions and stuff
 	process->virtualRanges.initialize(G_CONST_USER_VIRTUAL_RANGES_START, userStackVirt);
 
@@ -513,6 +519,7 @@ void g_thread_manager::deleteTask(g_thread* task) {
 
 	// clear message queues
 	g_message_controller::clear(task->id);
+	g_topics::clear(task->id);
 
 	if (task->type == g_thread_type::THREAD) {
 
@@ -555,8 +562,9 @@ void g_thread_manager::deleteTask(g_thread* task) {
 		 */
 		g_process* process = task->process;
 
-		// tell the filesystem to clean up
-		g_filesystem::process_closed(task->id);
+		// drop operations of the I/O ring, then tell the filesystem to clean up
+		g_io_rings::process_closed(process);
+		g_filesystem::process_closed(process);
 
 		// XXX TEMPORARY SWITCH XXX {
 		g_page_directory thisPageDirectory = g_address_space::get_current_space();
@@ -611,6 +619,9 @@ void g_thread_manager::deleteTask(g_thread* task) {
 				if (range->flags & G_PROC_VIRTUAL_RANGE_FLAG_PHYSICAL_OWNER) {
 					// TODO Same as in SystemCallHandler.Memory.unmap
 				}
+				if (range->flags & G_PROC_VIRTUAL_RANGE_FLAG_FILE_MAPPING) {
+					g_fs_mappings::release_pages(range->base, range->pages);
+				}
 			}
 			range = range->next;
 		}
@@ -0,0 +1,146 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "tasking/wait/wait_queue.hpp"
+
+/**
+ *
+ */
+g_waiter_queued::g_waiter_queued() :
+		queues(0), woken(true) {
+}
+
+/**
+ *
+ */
+g_waiter_queued::~g_waiter_queued() {
+
+	while (queues) {
+		g_wait_queue* queue = queues->value;
+
+		// remove this waiter from the queue
+		g_list_entry<g_waiter_queued*>* prev = 0;
+		g_list_entry<g_waiter_queued*>* entry = queue->waiters;
+		while (entry) {
+			if (entry->value == this) {
+				if (prev == 0) {
+					queue->waiters = entry->next;
+				} else {
+					prev->next = entry->next;
+				}
+				delete entry;
+				break;
+			}
+			prev = entry;
+			entry = entry->next;
+		}
+
+		g_list_entry<g_wait_queue*>* next = queues->next;
+		delete queues;
+		queues = next;
+	}
+
+}
+
+/**
+ *
+ */
+void g_waiter_queued::enqueue(g_wait_queue* queue) {
+
+	g_list_entry<g_waiter_queued*>* waiter_entry = new g_list_entry<g_waiter_queued*>;
+	waiter_entry->value = this;
+	waiter_entry->next = queue->waiters;
+	queue->waiters = waiter_entry;
+
+	g_list_entry<g_wait_queue*>* queue_entry = new g_list_entry<g_wait_queue*>;
+	queue_entry->value = queue;
+	queue_entry->next = queues;
+	queues = queue_entry;
+
+}
+
+/**
+ *
+ */
+bool g_waiter_queued::is_enqueued(g_wait_queue* queue) {
+
+	bool found = false;
+	for (g_list_entry<g_wait_queue*>* entry = queues; entry; entry = entry->next) {
+		if (entry->value == queue) {
+			found = true;
+			break;
+		}
+	}
+
+	return found;
+}
+
+/**
+ *
+ */
+g_wait_queue::g_wait_queue() :
+		waiters(0) {
+}
+
+/**
+ *
+ */
+g_wait_queue::~g_wait_queue() {
+
+	while (waiters) {
+		g_waiter_queued* waiter = waiters->value;
+		waiter->woken = true;
+
+		// remove this queue from the waiter
+		g_list_entry<g_wait_queue*>* prev = 0;
+		g_list_entry<g_wait_queue*>* entry = waiter->queues;
+		while (entry) {
+			if (entry->value == this) {
+				if (prev == 0) {
+					waiter->queues = entry->next;
+				} else {
+					prev->next = entry->next;
+				}
+				delete entry;
+				break;
+			}
+			prev = entry;
+			entry = entry->next;
+		}
+
+		g_list_entry<g_waiter_queued*>* next = waiters->next;
+		delete waiters;
+		waiters = next;
+	}
+
+}
+
+/**
+ *
+ */
+void g_wait_queue::wake_all() {
+
+	g_list_entry<g_waiter_queued*>* entry = waiters;
+	while (entry) {
+		entry->value->woken = true;
+		entry = entry->next;
+	}
+
+}
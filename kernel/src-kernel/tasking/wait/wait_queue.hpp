@@ -0,0 +1,101 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_MULTITASKING_WAIT_QUEUE
+#define GHOST_MULTITASKING_WAIT_QUEUE
+
+#include "ghost/stdint.h"
+#include "utils/list_entry.hpp"
+#include "tasking/wait/waiter.hpp"
+
+class g_wait_queue;
+
+/**
+ * A waiter that is woken through one or more wait queues instead of
+ * being polled. Until one of its queues wakes it, the scheduler skips the
+ * waiting thread without switching to its address space.
+ *
+ * The waiter starts out woken so that its condition is checked at least
+ * once after enqueueing. Implementations must clear the "woken" flag before
+ * checking their condition in checkWaiting, so no wakeup gets lost.
+ */
+class g_waiter_queued: public g_waiter {
+	friend class g_wait_queue;
+
+private:
+	g_list_entry<g_wait_queue*>* queues;
+
+protected:
+	volatile bool woken;
+
+public:
+	g_waiter_queued();
+
+	/**
+	 * Leaves all queues that this waiter was enqueued to.
+	 */
+	virtual ~g_waiter_queued();
+
+	/**
+	 * Registers this waiter to be woken by the given queue.
+	 */
+	void enqueue(g_wait_queue* queue);
+
+	/**
+	 * Returns whether this waiter is currently on the given queue.
+	 */
+	bool is_enqueued(g_wait_queue* queue);
+
+	/**
+	 *
+	 */
+	virtual bool isBlocked() {
+		return !woken;
+	}
+
+};
+
+/**
+ * A queue of waiters that wait for the same condition. Whoever changes the
+ * condition wakes the queue, the scheduler then lets the waiters re-check.
+ */
+class g_wait_queue {
+	friend class g_waiter_queued;
+
+private:
+	g_list_entry<g_waiter_queued*>* waiters;
+
+public:
+	g_wait_queue();
+
+	/**
+	 * Wakes and detaches all waiters that are still enqueued.
+	 */
+	~g_wait_queue();
+
+	/**
+	 * Wakes all waiters in this queue. The waiters stay enqueued until they
+	 * are destroyed.
+	 */
+	void wake_all();
+
+};
+
+#endif
@@ -40,6 +40,24 @@ public:
 	 */
 	virtual bool checkWaiting(g_thread* task) = 0;
 
+	/**
+	 * Should return true if the task is known to keep waiting without
+	 * checking. The scheduler then skips the task without switching to its
+	 * address space, so this must not access any userspace data.
+	 */
+	virtual bool isBlocked() {
+		return false;
+	}
+
+	/**
+	 * Returns the id of the thread that must run for the wait to end, or
+	 * {G_TID_NONE} if it is not known. The scheduler lends the time slices of the waiting task
+	 * to this thread. Must not access any userspace data.
+	 */
+	virtual g_tid getOwner() {
+		return G_TID_NONE;
+	}
+
 	/**
 	 *
 	 */
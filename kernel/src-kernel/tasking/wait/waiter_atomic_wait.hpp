@@ -31,14 +31,22 @@ class g_waiter_atomic_wait: public g_waiter {
 private:
 	bool* atom;
 	bool set_on_finish;
+	g_tid owner;
 
 public:
 
 	/**
 	 *
 	 */
-	g_waiter_atomic_wait(bool* atom, bool set_on_finish) :
-			atom(atom), set_on_finish(set_on_finish) {
+	g_waiter_atomic_wait(bool* atom, bool set_on_finish, g_tid owner = G_TID_NONE) :
+			atom(atom), set_on_finish(set_on_finish), owner(owner) {
+	}
+
+	/**
+	 *
+	 */
+	virtual g_tid getOwner() {
+		return owner;
 	}
 
 	/**
@@ -0,0 +1,80 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "tasking/wait/waiter_event_wait.hpp"
+
+/**
+ *
+ */
+g_waiter_event_wait::g_waiter_event_wait(g_syscall_fs_event_wait* _data, g_event_id _event_id, g_scheduler* _measuringScheduler) {
+	data = _data;
+	event_id = _event_id;
+	timeout = data->timeout;
+	measuringScheduler = _measuringScheduler;
+	startMs = measuringScheduler->getMilliseconds();
+}
+
+/**
+ *
+ */
+bool g_waiter_event_wait::timed_out() {
+
+	if (timeout == G_EVENT_TIMEOUT_INFINITE) {
+		return false;
+	}
+	return measuringScheduler->getMilliseconds() - startMs >= timeout;
+}
+
+/**
+ *
+ */
+bool g_waiter_event_wait::checkWaiting(g_thread* task) {
+
+	woken = false;
+
+	g_event* event = g_events::get(event_id);
+	if (event == 0) {
+		data->count = 0;
+		data->status = G_EVENT_WAIT_INVALID;
+		return false;
+	}
+
+	uint64_t count = g_events::take(event);
+	if (count > 0) {
+		data->count = count;
+		data->status = G_EVENT_WAIT_SUCCESSFUL;
+		return false;
+	}
+
+	if (timed_out()) {
+		data->count = 0;
+		data->status = G_EVENT_WAIT_TIMEOUT;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ *
+ */
+bool g_waiter_event_wait::isBlocked() {
+	return g_waiter_queued::isBlocked() && !timed_out();
+}
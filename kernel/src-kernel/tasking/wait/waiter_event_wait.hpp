@@ -0,0 +1,69 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_MULTITASKING_WAIT_MANAGER_EVENT_WAIT
+#define GHOST_MULTITASKING_WAIT_MANAGER_EVENT_WAIT
+
+#include <tasking/wait/wait_queue.hpp>
+#include <tasking/tasking.hpp>
+#include <filesystem/events.hpp>
+#include <ghost/calls/calls_filesystem.hpp>
+
+/**
+ * Waits until an event is signaled or the timeout has expired. The waiter
+ * is enqueued on the wait queue of the event, the waiting thread is only
+ * checked again once the event was signaled.
+ */
+class g_waiter_event_wait: public g_waiter_queued {
+private:
+	g_syscall_fs_event_wait* data;
+	g_event_id event_id;
+	uint64_t timeout;
+	uint64_t startMs;
+	g_scheduler* measuringScheduler;
+
+	/**
+	 *
+	 */
+	bool timed_out();
+
+public:
+	g_waiter_event_wait(g_syscall_fs_event_wait* _data, g_event_id _event_id, g_scheduler* _measuringScheduler);
+
+	/**
+	 *
+	 */
+	virtual bool checkWaiting(g_thread* task);
+
+	/**
+	 *
+	 */
+	virtual bool isBlocked();
+
+	/**
+	 *
+	 */
+	virtual const char* debug_name() {
+		return "event-wait";
+	}
+
+};
+
+#endif
@@ -21,7 +21,7 @@
 #ifndef GHOST_MULTITASKING_WAIT_MANAGER_FS_TRANSACTION
 #define GHOST_MULTITASKING_WAIT_MANAGER_FS_TRANSACTION
 
-#include "tasking/wait/waiter.hpp"
+#include "tasking/wait/wait_queue.hpp"
 
 #include "filesystem/fs_transaction_handler.hpp"
 #include "logger/logger.hpp"
@@ -31,8 +31,15 @@
 /**
  * Waits for a specific transaction to be finished. Once the transaction is finished,
  * the given finish-handler is called (passing the task and the delegate) to do any further action.
+ *
+ * While the transaction is waiting, the waiter sleeps on the queue of the transaction slot,
+ * which is woken whenever the status of the transaction changes.
+ *
+ * While a transaction is set to repeat, the waiter sleeps on the queue that the delegate
+ * named via {g_fs_transaction_handler::repeat_on_wake}; without such a queue, the
+ * transaction is repeated every time the thread is scheduled.
  */
-class g_waiter_fs_transaction: public g_waiter {
+class g_waiter_fs_transaction: public g_waiter_queued {
 private:
 	g_fs_transaction_handler* handler;
 	g_fs_transaction_id transaction_id;
@@ -54,7 +61,43 @@ public:
 	 *
 	 */
 	virtual bool checkWaiting(g_thread* task) {
-		return check_transaction_status(task, handler, transaction_id, delegate);
+
+		// finishing may replace this waiter, so it must not be used afterwards
+		if (g_fs_transaction_store::get_status(transaction_id) != G_FS_TRANSACTION_REPEAT) {
+			woken = false;
+
+			g_wait_queue* queue = g_fs_transaction_store::get_queue(transaction_id);
+			if (queue == 0) {
+				woken = true;
+			} else if (!is_enqueued(queue)) {
+				enqueue(queue);
+			}
+			return check_transaction_status(task, handler, transaction_id, delegate);
+		}
+
+		// repeating never replaces the waiter
+		woken = false;
+		handler->repeat_on_wake(0);
+		check_transaction_status(task, handler, transaction_id, delegate);
+
+		g_wait_queue* queue = handler->get_repeat_queue();
+		if (queue == 0 || g_fs_transaction_store::get_status(transaction_id) != G_FS_TRANSACTION_REPEAT) {
+			woken = true;
+
+		} else if (!is_enqueued(queue)) {
+			enqueue(queue);
+
+			// the queue might have been woken before this waiter was on it
+			woken = true;
+		}
+		return true;
+	}
+
+	/**
+	 *
+	 */
+	virtual g_tid getOwner() {
+		return delegate->get_serving_thread();
 	}
 
 	/**
@@ -78,7 +121,7 @@ public:
 			}
 
 			// could not repeat transaction start, set it finished so it repeats once more and exits
-			g_fs_transaction_store::set_status(transaction_status, G_FS_TRANSACTION_FINISHED);
+			g_fs_transaction_store::set_status(transaction_id, G_FS_TRANSACTION_FINISHED);
 			g_log_info("%! problem: failed to repeat a transaction");
 			return true;
 
@@ -0,0 +1,58 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_MULTITASKING_WAIT_MANAGER_IO_RING
+#define GHOST_MULTITASKING_WAIT_MANAGER_IO_RING
+
+#include <tasking/wait/waiter.hpp>
+#include <filesystem/io_rings.hpp>
+
+/**
+ * Waits until the I/O ring of the process has the requested number of
+ * completions available, or no more operations are pending.
+ */
+class g_waiter_io_ring: public g_waiter {
+private:
+	uint32_t minimum_completions;
+
+public:
+	g_waiter_io_ring(uint32_t minimum_completions) :
+			minimum_completions(minimum_completions) {
+	}
+
+	/**
+	 *
+	 */
+	virtual bool checkWaiting(g_thread* task) {
+
+		uint32_t available = g_io_rings::progress(task->process);
+		return available < minimum_completions && g_io_rings::get_pending_count(task->process) > 0;
+	}
+
+	/**
+	 *
+	 */
+	virtual const char* debug_name() {
+		return "io-ring";
+	}
+
+};
+
+#endif
@@ -50,6 +50,13 @@ public:
 		return other != 0 && other->alive;
 	}
 
+	/**
+	 *
+	 */
+	virtual g_tid getOwner() {
+		return waitTask;
+	}
+
 	/**
 	 *
 	 */
@@ -0,0 +1,102 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "tasking/wait/waiter_poll.hpp"
+#include "tasking/communication/message_controller.hpp"
+#include "tasking/communication/topics.hpp"
+#include "filesystem/filesystem.hpp"
+#include "system/interrupts/handling/interrupt_request_handler.hpp"
+
+/**
+ *
+ */
+int32_t g_waiter_poll::check(g_thread* task, g_syscall_poll* data) {
+
+	int32_t ready = 0;
+
+	for (uint32_t i = 0; i < data->count; i++) {
+		g_poll_entry* entry = &data->entries[i];
+		entry->revents = G_POLL_EVENT_NONE;
+
+		if (entry->type == G_POLL_TYPE_FD) {
+			g_fs_node* node;
+			g_file_descriptor_content* fd;
+			if (g_filesystem::node_for_descriptor(task->process, entry->value, &node, &fd)) {
+				entry->revents = g_filesystem::poll(task, node, entry->events);
+			} else {
+				entry->revents = G_POLL_EVENT_ERROR;
+			}
+
+		} else if (entry->type == G_POLL_TYPE_MESSAGE) {
+			if (g_message_controller::has_message(task->id, entry->value)) {
+				entry->revents = G_POLL_EVENT_READABLE;
+			}
+
+		} else if (entry->type == G_POLL_TYPE_TOPIC_MESSAGE) {
+			if (g_message_controller::hasMessageWithTopic(task->id, entry->value)) {
+				entry->revents = G_POLL_EVENT_READABLE;
+			}
+
+		} else if (entry->type == G_POLL_TYPE_IRQ) {
+			// Only driver level
+			if (task->process->securityLevel > G_SECURITY_LEVEL_DRIVER || entry->value > 0xFF) {
+				entry->revents = G_POLL_EVENT_ERROR;
+			} else if (g_interrupt_request_handler::pollIrq((uint8_t) entry->value)) {
+				entry->revents = G_POLL_EVENT_READABLE;
+			}
+
+		} else if (entry->type == G_POLL_TYPE_SUBSCRIPTION) {
+			if (g_topics::has_message(task->id, entry->value)) {
+				entry->revents = G_POLL_EVENT_READABLE;
+			}
+
+		} else {
+			entry->revents = G_POLL_EVENT_ERROR;
+		}
+
+		if (entry->revents != G_POLL_EVENT_NONE) {
+			++ready;
+		}
+	}
+
+	data->ready = ready;
+	return ready;
+}
+
+/**
+ *
+ */
+bool g_waiter_poll::checkWaiting(g_thread* task) {
+
+	if (check(task, data) > 0) {
+		data->status = G_POLL_STATUS_SUCCESSFUL;
+		return false;
+	}
+
+	if (data->timeout != G_POLL_TIMEOUT_INFINITE) {
+		uint64_t diff = measuringScheduler->getMilliseconds() - startMs;
+		if (diff >= data->timeout) {
+			data->status = G_POLL_STATUS_TIMEOUT;
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,72 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_MULTITASKING_WAIT_MANAGER_POLL
+#define GHOST_MULTITASKING_WAIT_MANAGER_POLL
+
+#include <tasking/wait/waiter.hpp>
+#include <tasking/tasking.hpp>
+#include <ghost/calls/calls_tasking.hpp>
+
+/**
+ * Waits until any entry of a wait set has an event to report or
+ * the timeout of the poll call has expired.
+ */
+class g_waiter_poll: public g_waiter {
+private:
+	g_syscall_poll* data;
+	uint64_t startMs;
+	g_scheduler* measuringScheduler;
+
+public:
+	g_waiter_poll(g_syscall_poll* _data, g_scheduler* _measuringScheduler) {
+		data = _data;
+		measuringScheduler = _measuringScheduler;
+		startMs = measuringScheduler->getMilliseconds();
+	}
+
+	/**
+	 * Checks each entry of the wait set, filling the revents of the entries.
+	 * Fired IRQs that are part of the set are consumed by this check.
+	 *
+	 * @param task
+	 * 		the polling task, must be the current address space
+	 * @param data
+	 * 		the poll call data
+	 *
+	 * @return the number of entries with events
+	 */
+	static int32_t check(g_thread* task, g_syscall_poll* data);
+
+	/**
+	 *
+	 */
+	virtual bool checkWaiting(g_thread* task);
+
+	/**
+	 *
+	 */
+	virtual const char* debug_name() {
+		return "poll";
+	}
+
+};
+
+#endif
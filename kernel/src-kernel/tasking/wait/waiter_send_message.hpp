@@ -29,10 +29,19 @@
 class g_waiter_send_message: public g_waiter {
 private:
 	g_syscall_send_message* data;
+	g_tid receiver;
 
 public:
 	g_waiter_send_message(g_syscall_send_message* _data) {
 		this->data = _data;
+		this->receiver = _data->receiver;
+	}
+
+	/**
+	 * The receiver must take messages from its queue for the send to continue.
+	 */
+	virtual g_tid getOwner() {
+		return receiver;
 	}
 
 	/**
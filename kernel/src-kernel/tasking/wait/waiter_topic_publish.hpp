@@ -0,0 +1,65 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_MULTITASKING_WAIT_MANAGER_TOPIC_PUBLISH
+#define GHOST_MULTITASKING_WAIT_MANAGER_TOPIC_PUBLISH
+
+#include <tasking/wait/wait_queue.hpp>
+#include <tasking/communication/topics.hpp>
+#include <ghost/calls/calls_messaging.hpp>
+
+/**
+ * Waits until a message can be published to a topic without exceeding
+ * the queue of a subscriber with the blocking policy. The payload was
+ * copied before waiting, so retrying does not access userspace.
+ */
+class g_waiter_topic_publish: public g_waiter_queued {
+private:
+	g_syscall_topic_publish* data;
+	g_topic_id topic;
+	g_topic_payload* payload;
+
+public:
+	g_waiter_topic_publish(g_syscall_topic_publish* _data, g_topic_payload* _payload) :
+			data(_data), topic(_data->topic), payload(_payload) {
+	}
+
+	/**
+	 * Releases the reference of the publisher to the payload.
+	 */
+	virtual ~g_waiter_topic_publish() {
+		g_topics::release_payload(payload);
+	}
+
+	/**
+	 *
+	 */
+	virtual bool checkWaiting(g_thread* task);
+
+	/**
+	 *
+	 */
+	virtual const char* debug_name() {
+		return "topic-publish";
+	}
+
+};
+
+#endif
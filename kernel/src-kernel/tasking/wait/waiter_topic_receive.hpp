@@ -0,0 +1,53 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GHOST_MULTITASKING_WAIT_MANAGER_TOPIC_RECEIVE
+#define GHOST_MULTITASKING_WAIT_MANAGER_TOPIC_RECEIVE
+
+#include <tasking/wait/wait_queue.hpp>
+#include <ghost/calls/calls_messaging.hpp>
+
+/**
+ * Waits until a message arrives in the queue of a topic subscription.
+ */
+class g_waiter_topic_receive: public g_waiter_queued {
+private:
+	g_syscall_topic_receive* data;
+
+public:
+	g_waiter_topic_receive(g_syscall_topic_receive* _data) :
+			data(_data) {
+	}
+
+	/**
+	 *
+	 */
+	virtual bool checkWaiting(g_thread* task);
+
+	/**
+	 *
+	 */
+	virtual const char* debug_name() {
+		return "topic-receive";
+	}
+
+};
+
+#endif
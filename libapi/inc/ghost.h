@@ -29,6 +29,7 @@
 #include "ghost/ipc.h"
 #include "ghost/types.h"
 #include "ghost/fs.h"
+#include "ghost/poll.h"
 #include "ghost/calls/calls.h"
 
 #endif
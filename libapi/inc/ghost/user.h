@@ -30,6 +30,8 @@
 #include "ghost/ipc.h"
 #include "ghost/types.h"
 #include "ghost/fs.h"
+#include "ghost/poll.h"
+#include "ghost/io.h"
 #include "ghost/calls/calls.h"
 
 __BEGIN_C
@@ -42,10 +44,14 @@ __BEGIN_C
  *
  * @param atom
  * 		the atom to use
+ * @param-opt owner
+ * 		id of the thread that owns the atom. While waiting, the time slices of
+ * 		the executing task are lent to the owner
  *
  * @security-level APPLICATION
  */
 void g_atomic_wait(uint8_t* atom);
+void g_atomic_wait_to(uint8_t* atom, g_tid owner);
 
 /**
  * Performs an atomic block. If the atom is true, the executing task must
@@ -54,10 +60,14 @@ void g_atomic_wait(uint8_t* atom);
  *
  * @param atom
  * 		the atom to use
+ * @param-opt owner
+ * 		id of the thread that owns the atom. While waiting, the time slices of
+ * 		the executing task are lent to the owner
  *
  * @security-level APPLICATION
  */
 void g_atomic_block(uint8_t* atom);
+void g_atomic_block_to(uint8_t* atom, g_tid owner);
 
 /**
  * Spawns a program binary.
@@ -151,6 +161,19 @@ g_fd g_open_fs(const char* path, int32_t flags, g_fs_open_status* out_status);
 int g_close(g_fd fd);
 int g_close_s(g_fd fd, g_fs_close_status* out_status);
 
+/**
+ * Passes all data that the kernel buffered for writes to the file on to its
+ * delegate and waits until the delegate has written it.
+ *
+ * @param fd
+ * 		the file descriptor
+ *
+ * @return one of the {g_fs_flush_status} codes
+ *
+ * @security-level APPLICATION
+ */
+g_fs_flush_status g_flush(g_fd fd);
+
 /**
  * Retrieves the length of a file in bytes.
  *
@@ -192,6 +215,28 @@ g_fs_directory_iterator* g_open_directory_s(const char* path, g_fs_open_director
 g_fs_directory_entry* g_read_directory(g_fs_directory_iterator* iterator);
 g_fs_directory_entry* g_read_directory_s(g_fs_directory_iterator* iterator, g_fs_read_directory_status* out_status);
 
+/**
+ * Reads as many of the next entries of the directory as fit into the buffer.
+ * The buffer is filled with {g_fs_directory_record} entries, the length of each
+ * record is the offset of the following one.
+ *
+ * @param iterator
+ * 		the directory iterator
+ *
+ * @param buffer
+ * 		buffer to fill with records
+ *
+ * @param length
+ * 		length of the buffer in bytes
+ *
+ * @param out_status
+ * 		is filled with the status code
+ *
+ * @return the number of records, 0 at the end of the directory or -1 if not successful
+ */
+int32_t g_read_directory_batch(g_fs_directory_iterator* iterator, void* buffer, uint32_t length);
+int32_t g_read_directory_batch_s(g_fs_directory_iterator* iterator, void* buffer, uint32_t length, g_fs_read_directory_status* out_status);
+
 /**
  * Closes a directory.
  *
@@ -220,6 +265,40 @@ int64_t g_flength(const char* path);
 int64_t g_flength_s(const char* path, uint8_t follow_symlinks);
 int64_t g_flength_ss(const char* path, uint8_t follow_symlinks, g_fs_length_status* out_status);
 
+/**
+ * Retrieves the attributes of a file.
+ *
+ * @param path
+ * 		path of the file
+ *
+ * @param follow_symlinks
+ * 		whether to follow symbolic links or not
+ *
+ * @param out_attributes
+ * 		is filled with the attributes
+ *
+ * @return 0 if successful, -1 otherwise
+ *
+ * @security-level APPLICATION
+ */
+int32_t g_stat(const char* path, g_fs_stat_attributes* out_attributes);
+int32_t g_stat_s(const char* path, uint8_t follow_symlinks, g_fs_stat_attributes* out_attributes);
+
+/**
+ * Retrieves the attributes of an open file.
+ *
+ * @param fd
+ * 		the file descriptor
+ *
+ * @param out_attributes
+ * 		is filled with the attributes
+ *
+ * @return 0 if successful, -1 otherwise
+ *
+ * @security-level APPLICATION
+ */
+int32_t g_fstat(g_fd fd, g_fs_stat_attributes* out_attributes);
+
 /**
  * Repositions the offset within a file.
  *
@@ -254,6 +333,19 @@ int64_t g_seek_s(g_fd fd, int64_t off, g_fs_seek_mode mode, g_fs_seek_status* ou
 int64_t g_tell(g_fd fd);
 int64_t g_tell_s(g_fd fd, g_fs_tell_status* out_status);
 
+/**
+ * Creates a directory. The parent directory must exist and be on a filesystem
+ * that supports creating directories, like the one mounted at /tmp.
+ *
+ * @param path
+ * 		path of the directory to create
+ *
+ * @return one of the {g_fs_create_directory_status} codes
+ *
+ * @security-level APPLICATION
+ */
+g_fs_create_directory_status g_create_directory(const char* path);
+
 /**
  * Sets the working directory for the current process.
  *
@@ -316,6 +408,97 @@ int32_t g_read_s(g_fd fd, void* buffer, uint64_t length, g_fs_read_status* out_s
 int32_t g_write(g_fd fd, const void* buffer, uint64_t length);
 int32_t g_write_s(g_fd fd, const void* buffer, uint64_t length, g_fs_write_status* out_status);
 
+/**
+ * Reads bytes from the file into multiple buffers. The buffers are filled one
+ * after another; reading stops early at the end of the file. When an offset is
+ * given, reading starts there and the offset of the file descriptor is left
+ * unchanged, otherwise the current offset is used and advanced.
+ *
+ * @param fd
+ * 		the file descriptor
+ * @param vector
+ * 		the target buffers, at most {G_FS_IO_VECTOR_MAXIMUM}
+ * @param count
+ * 		the number of buffers
+ * @param buffer
+ * 		the target buffer
+ * @param length
+ * 		the length in bytes
+ * @param offset
+ * 		the offset to read from
+ * @param-opt out_status
+ * 		filled with one of the {g_fs_read_status} codes
+ *
+ * @return if the read was successful the total length of bytes or
+ * 		zero if EOF, otherwise -1
+ *
+ * @security-level APPLICATION
+ */
+int32_t g_readv(g_fd fd, g_fs_io_vector* vector, uint32_t count);
+int32_t g_readv_s(g_fd fd, g_fs_io_vector* vector, uint32_t count, g_fs_read_status* out_status);
+int32_t g_pread(g_fd fd, void* buffer, uint64_t length, int64_t offset);
+int32_t g_pread_s(g_fd fd, void* buffer, uint64_t length, int64_t offset, g_fs_read_status* out_status);
+int32_t g_preadv(g_fd fd, g_fs_io_vector* vector, uint32_t count, int64_t offset);
+int32_t g_preadv_s(g_fd fd, g_fs_io_vector* vector, uint32_t count, int64_t offset, g_fs_read_status* out_status);
+
+/**
+ * Writes bytes from multiple buffers to the file, one buffer after another.
+ * When an offset is given, writing starts there and the offset of the file
+ * descriptor is left unchanged, otherwise the current offset is used and advanced.
+ *
+ * @param fd
+ * 		the file descriptor
+ * @param vector
+ * 		the source buffers, at most {G_FS_IO_VECTOR_MAXIMUM}
+ * @param count
+ * 		the number of buffers
+ * @param buffer
+ * 		the source buffer
+ * @param length
+ * 		the length in bytes
+ * @param offset
+ * 		the offset to write at
+ * @param-opt out_status
+ * 		filled with one of the {g_fs_write_status} codes
+ *
+ * @return if successful the total number of bytes that were written, otherwise -1
+ *
+ * @security-level APPLICATION
+ */
+int32_t g_writev(g_fd fd, const g_fs_io_vector* vector, uint32_t count);
+int32_t g_writev_s(g_fd fd, const g_fs_io_vector* vector, uint32_t count, g_fs_write_status* out_status);
+int32_t g_pwrite(g_fd fd, const void* buffer, uint64_t length, int64_t offset);
+int32_t g_pwrite_s(g_fd fd, const void* buffer, uint64_t length, int64_t offset, g_fs_write_status* out_status);
+int32_t g_pwritev(g_fd fd, const g_fs_io_vector* vector, uint32_t count, int64_t offset);
+int32_t g_pwritev_s(g_fd fd, const g_fs_io_vector* vector, uint32_t count, int64_t offset, g_fs_write_status* out_status);
+
+/**
+ * Maps the contents of a file into the address space of the executing process.
+ * Where possible, the pages that hold the contents (ramdisk files or files in
+ * the page cache) are mapped directly without copying.
+ *
+ * A shared mapping is read-only. A private mapping may be written; pages are
+ * copied on the first write and changes are never written to the file. The
+ * mapping is released with {g_unmap}, passing the returned address.
+ *
+ * @param fd
+ * 		the file descriptor
+ * @param offset
+ * 		offset within the file
+ * @param length
+ * 		number of bytes to map
+ * @param flags
+ * 		either {G_FS_MAP_SHARED} or {G_FS_MAP_PRIVATE}
+ * @param-opt out_status
+ * 		filled with one of the {g_fs_map_status} codes
+ *
+ * @return a pointer to the byte at the offset, or zero on failure
+ *
+ * @security-level APPLICATION
+ */
+void* g_mmap(g_fd fd, int64_t offset, uint32_t length, g_fs_map_flags flags);
+void* g_mmap_s(g_fd fd, int64_t offset, uint32_t length, g_fs_map_flags flags, g_fs_map_status* out_status);
+
 /**
  * Returns the next topic identifier that can be used for messaging.
  * When sending a message, a topic can be added so that one can wait
@@ -367,6 +550,18 @@ void* g_share_mem(void* memory, int32_t size, uint32_t pid);
  */
 void g_yield();
 
+/**
+ * Yields to a specific thread, which runs immediately if it is runnable and
+ * assigned to the same processor. Otherwise this is the same as {g_yield}.
+ * Allows a client to hand off directly to the server it has sent a request.
+ *
+ * @param target
+ * 		id of the thread to yield to
+ *
+ * @security-level APPLICATION
+ */
+void g_yield_to(g_tid target);
+
 /**
  * Sleeps for the given amount of milliseconds.
  *
@@ -425,11 +620,15 @@ void g_exit(int status);
  * @param-opt userData
  * 		a pointer to user data that should be passed
  * 		to the entry function
+ * @param-opt placement
+ * 		one of the {g_thread_placement} values, by default the
+ * 		thread is placed on the least loaded core
  *
  * @security-level APPLICATION
  */
 uint32_t g_create_thread(void* function);
 uint32_t g_create_thread_d(void* function, void* userData);
+uint32_t g_create_thread_dp(void* function, void* userData, g_thread_placement placement);
 
 /**
  * Sends a message to a task.
@@ -498,6 +697,100 @@ g_message_receive_status g_receive_message_m(void* buf, size_t max, g_message_re
 g_message_receive_status g_receive_message_t(void* buf, size_t max, g_message_transaction tx);
 g_message_receive_status g_receive_message_tm(void* buf, size_t max, g_message_transaction tx, g_message_receive_mode mode);
 
+/**
+ * Opens the publish/subscribe topic with the given name, creating
+ * it if it does not exist yet.
+ *
+ * @param name
+ * 		name of the topic, at most {G_TOPIC_NAME_MAXIMUM_LENGTH} - 1 characters
+ *
+ * @return the topic id, or -1 if the name is invalid
+ *
+ * @security-level APPLICATION
+ */
+g_topic_id g_topic_open(const char* name);
+
+/**
+ * Subscribes the executing thread to a topic. Each subscription has its own
+ * queue, only the subscribing thread may receive from it. The subscription
+ * can be waited for with {g_poll} using {G_POLL_TYPE_SUBSCRIPTION}.
+ *
+ * @param topic
+ * 		the topic id
+ * @param-opt policy
+ * 		what to do when the queue is full on publishing: drop the oldest
+ * 		message (default) or block the publisher
+ * @param-opt capacity
+ * 		number of messages the queue can hold, {G_TOPIC_DEFAULT_CAPACITY}
+ * 		by default and at most {G_TOPIC_MAXIMUM_CAPACITY}
+ *
+ * @return the subscription id, or -1 on failure
+ *
+ * @security-level APPLICATION
+ */
+g_topic_subscription g_topic_subscribe(g_topic_id topic);
+g_topic_subscription g_topic_subscribe_p(g_topic_id topic, g_topic_backpressure policy, uint32_t capacity);
+
+/**
+ * Removes a subscription of the executing thread.
+ *
+ * @param subscription
+ * 		the subscription id
+ *
+ * @return whether the subscription was removed
+ *
+ * @security-level APPLICATION
+ */
+uint8_t g_topic_unsubscribe(g_topic_subscription subscription);
+
+/**
+ * Publishes a message to all subscribers of a topic. The message is copied
+ * once and shared by the queues of all subscribers. If a subscriber with the
+ * blocking policy has a full queue, the message is not delivered to anyone
+ * until there is space again.
+ *
+ * @param topic
+ * 		the topic id
+ * @param buf
+ * 		message buffer
+ * @param len
+ * 		message length, at most {G_TOPIC_MAXIMUM_PAYLOAD}
+ * @param-opt mode
+ * 		whether to wait for space or to fail with {G_TOPIC_PUBLISH_STATUS_QUEUE_FULL}
+ *
+ * @return one of the {g_topic_publish_status} codes
+ *
+ * @security-level APPLICATION
+ */
+g_topic_publish_status g_topic_publish(g_topic_id topic, void* buf, size_t len);
+g_topic_publish_status g_topic_publish_m(g_topic_id topic, void* buf, size_t len, g_topic_publish_mode mode);
+
+/**
+ * Receives the next message from the queue of a subscription.
+ *
+ * @param subscription
+ * 		the subscription id
+ * @param buf
+ * 		message buffer
+ * @param max
+ * 		size of the message buffer
+ * @param out_length
+ * 		is filled with the length of the message
+ * @param-opt mode
+ * 		one of the {g_topic_receive_mode} codes
+ * @param-opt out_dropped
+ * 		is filled with the number of messages that were dropped from the
+ * 		queue since the last receive
+ *
+ * @return one of the {g_topic_receive_status} codes
+ *
+ * @security-level APPLICATION
+ */
+g_topic_receive_status g_topic_receive(g_topic_subscription subscription, void* buf, size_t max, size_t* out_length);
+g_topic_receive_status g_topic_receive_m(g_topic_subscription subscription, void* buf, size_t max, size_t* out_length, g_topic_receive_mode mode);
+g_topic_receive_status g_topic_receive_md(g_topic_subscription subscription, void* buf, size_t max, size_t* out_length, g_topic_receive_mode mode,
+		uint32_t* out_dropped);
+
 /**
  * Registers the executing task for the given identifier.
  *
@@ -532,6 +825,30 @@ g_tid g_task_get_id(const char* identifier);
  */
 void g_wait_for_irq(uint8_t irq);
 
+/**
+ * Blocks the executing thread until any of the entries of the given wait set
+ * has an event to report or the timeout expires. Entries can be file descriptors
+ * (readable/writable), messages with a transaction, messages with a topic and IRQs.
+ * The revents of each entry are filled with the occurred events. IRQ entries
+ * require driver level and the IRQ is consumed once it is reported.
+ *
+ * @param entries
+ * 		the wait set entries
+ * @param count
+ * 		number of entries, at most {G_POLL_MAXIMUM_ENTRIES}
+ * @param timeout
+ * 		maximum number of milliseconds to wait, zero to only check the
+ * 		entries or {G_POLL_TIMEOUT_INFINITE} to wait without limit
+ * @param-opt out_status
+ * 		filled with one of the {g_poll_status} codes
+ *
+ * @return the number of entries with events, or -1 on failure
+ *
+ * @security-level APPLICATION
+ */
+int32_t g_poll(g_poll_entry* entries, uint32_t count, uint64_t timeout);
+int32_t g_poll_s(g_poll_entry* entries, uint32_t count, uint64_t timeout, g_poll_status* out_status);
+
 /**
  * Maps the given physical address to the executing processes address space so
  * it can access it directly.
@@ -806,6 +1123,165 @@ g_fd g_clone_fd_ts(g_fd source_fd, g_pid source_process, g_fd target_fd, g_pid t
 void g_pipe(g_fd* out_write, g_fd* out_read);
 void g_pipe_s(g_fd* out_write, g_fd* out_read, g_fs_pipe_status* out_status);
 
+/**
+ * Opens a pipe that holds up to the given number of bytes. The capacity is
+ * rounded up to full pages, zero selects the default capacity.
+ *
+ * @param out_write
+ * 		is filled with the pipes write end
+ * @param out_read
+ * 		is filled with the pipes read end
+ * @param capacity
+ * 		capacity of the pipe in bytes
+ * @param out_status
+ * 		is filled with the status code
+ *
+ * @security-level APPLICATION
+ */
+void g_pipe_b(g_fd* out_write, g_fd* out_read, uint32_t capacity);
+void g_pipe_bs(g_fd* out_write, g_fd* out_read, uint32_t capacity, g_fs_pipe_status* out_status);
+
+/**
+ * Moves data from a pipe or a file into a pipe within the kernel. Pages that
+ * are moved completely are not copied; from a file, this requires that the
+ * kernel holds the contents (ramdisk files or files in the page cache). The
+ * call does not block, it moves only what is available and fits into the
+ * target pipe.
+ *
+ * If {G_FS_SPLICE_NOT_SUPPORTED} is returned, the data must be read and
+ * written instead.
+ *
+ * @param in_fd
+ * 		the pipe or file to move data from
+ * @param out_fd
+ * 		the pipe to move data to
+ * @param length
+ * 		maximum number of bytes to move
+ * @param-opt out_status
+ * 		filled with one of the {g_fs_splice_status} codes
+ *
+ * @return the number of bytes that were moved
+ *
+ * @security-level APPLICATION
+ */
+int32_t g_splice(g_fd in_fd, g_fd out_fd, uint32_t length);
+int32_t g_splice_s(g_fd in_fd, g_fd out_fd, uint32_t length, g_fs_splice_status* out_status);
+
+/**
+ * Creates a counting event. The event is a file descriptor, so it can be
+ * used in wait sets with {g_poll}, shared with other processes using
+ * {g_clone_fd} and is destroyed once all descriptors are closed.
+ *
+ * @param out_status
+ * 		is filled with the status code
+ *
+ * @return the file descriptor of the event
+ *
+ * @security-level APPLICATION
+ */
+g_fd g_event_create();
+g_fd g_event_create_s(g_event_create_status* out_status);
+
+/**
+ * Signals an event, adding the value (one if not given) to its counter
+ * and waking all threads that wait for it.
+ *
+ * @param event
+ * 		file descriptor of the event
+ * @param-opt value
+ * 		value to add to the counter
+ *
+ * @return the status code
+ *
+ * @security-level APPLICATION
+ */
+g_event_signal_status g_event_signal(g_fd event);
+g_event_signal_status g_event_signal_v(g_fd event, uint64_t value);
+
+/**
+ * Waits until the event is signaled, then takes its counter and resets it
+ * to zero. Multiple signals that happen before the wait are coalesced.
+ *
+ * @param event
+ * 		file descriptor of the event
+ * @param-opt timeout
+ * 		timeout in milliseconds, zero to not block
+ * @param-opt out_status
+ * 		is filled with the status code
+ *
+ * @return the counter value that was taken, zero on timeout or error
+ *
+ * @security-level APPLICATION
+ */
+uint64_t g_event_wait(g_fd event);
+uint64_t g_event_wait_s(g_fd event, g_event_wait_status* out_status);
+uint64_t g_event_wait_timeout(g_fd event, uint64_t timeout);
+uint64_t g_event_wait_ts(g_fd event, uint64_t timeout, g_event_wait_status* out_status);
+
+/**
+ * Sets up the I/O ring of the executing process. The ring is shared with the
+ * kernel; filesystem operations that are added to it are performed without
+ * blocking a thread, their completions are posted to the ring.
+ *
+ * @param out_ring
+ * 		is filled with the address of the ring
+ *
+ * @return the status code
+ *
+ * @security-level APPLICATION
+ */
+g_io_ring_setup_status g_io_ring_setup(g_io_ring** out_ring);
+
+/**
+ * Adds an operation to the submission ring. The operation is started once
+ * the ring is entered.
+ *
+ * @param ring
+ * 		the I/O ring
+ * @param operation
+ * 		one of the {g_io_operation} values
+ * @param data
+ * 		the call data of the operation, for example a {g_syscall_fs_read}; must
+ * 		stay valid until the completion of the operation was taken
+ * @param user_data
+ * 		value that is passed through to the completion
+ *
+ * @return whether the submission ring had space for the operation
+ *
+ * @security-level APPLICATION
+ */
+uint8_t g_io_ring_submit(g_io_ring* ring, g_io_operation operation, void* data, uint64_t user_data);
+
+/**
+ * Passes all added operations to the kernel and optionally waits until the
+ * given number of completions is available.
+ *
+ * @param minimum_completions
+ * 		number of completions to wait for, zero to not block
+ * @param-opt out_submitted
+ * 		is filled with the number of operations that were taken
+ *
+ * @return the status code
+ *
+ * @security-level APPLICATION
+ */
+g_io_ring_enter_status g_io_ring_enter(uint32_t minimum_completions);
+g_io_ring_enter_status g_io_ring_enter_s(uint32_t minimum_completions, uint32_t* out_submitted);
+
+/**
+ * Takes the next completion from the completion ring.
+ *
+ * @param ring
+ * 		the I/O ring
+ * @param out_completion
+ * 		is filled with the completion
+ *
+ * @return whether a completion was available
+ *
+ * @security-level APPLICATION
+ */
+uint8_t g_io_ring_complete(g_io_ring* ring, g_io_completion* out_completion);
+
 /**
  * Stores command line arguments for a created process.
  *
@@ -973,6 +1449,68 @@ void g_fs_set_transaction_status(g_fs_transaction_id id, g_fs_transaction_status
  */
 g_fs_create_node_status g_fs_create_node(uint32_t parent, char* name, g_fs_node_type type, uint64_t fs_id, uint32_t* out_created_id);
 
+/**
+ * Drops the contents of a node that the kernel has cached. Must be called by a
+ * filesystem delegate whenever the contents of one of its nodes change without
+ * being written through the kernel.
+ *
+ * @param node_id
+ * 		id of the node
+ *
+ * @param offset
+ * 		start of the changed range
+ *
+ * @param length
+ * 		length of the changed range, a negative value drops all
+ * 		cached contents of the node
+ *
+ * @return one of the {g_fs_cache_invalidate_status} codes
+ *
+ * @security-level DRIVER
+ */
+g_fs_cache_invalidate_status g_fs_cache_invalidate(uint32_t node_id, int64_t offset, int64_t length);
+
+/**
+ * Sets the attributes that the kernel caches for a node, so that it doesn't have to
+ * ask the delegate for them. The time-to-live also applies when the kernel caches the
+ * attributes after asking the delegate; {G_FS_ATTRIBUTES_TTL_AUTHORITATIVE} keeps them
+ * until the delegate calls {g_fs_cache_invalidate}, {G_FS_ATTRIBUTES_TTL_NONE} disables
+ * caching for the node.
+ *
+ * @param node_id
+ * 		id of the node
+ *
+ * @param length
+ * 		length of the node, a negative value only sets the time-to-live
+ *
+ * @param ttl
+ * 		time in milliseconds that the attributes stay valid
+ *
+ * @return one of the {g_fs_set_attributes_status} codes
+ *
+ * @security-level DRIVER
+ */
+g_fs_set_attributes_status g_fs_set_attributes(uint32_t node_id, int64_t length, g_fs_attributes_ttl ttl);
+
+/**
+ * Sets how the kernel passes writes on to the delegate that serves the node. With
+ * {G_FS_WRITE_MODE_BACK}, which is the default, small writes are buffered in the kernel
+ * and passed on in larger batches once the file is closed or flushed, the buffer is full
+ * or has been waiting for a while. Delegates of devices use {G_FS_WRITE_MODE_THROUGH}
+ * to receive each write immediately.
+ *
+ * @param node_id
+ * 		id of a node of the delegate
+ *
+ * @param mode
+ * 		one of the {g_fs_write_mode} values
+ *
+ * @return one of the {g_fs_set_write_mode_status} codes
+ *
+ * @security-level DRIVER
+ */
+g_fs_set_write_mode_status g_fs_set_write_mode(uint32_t node_id, g_fs_write_mode mode);
+
 /**
  * Registers the <handler> routine as the handler for the <irq>.
  *
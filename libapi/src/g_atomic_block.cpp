@@ -20,12 +20,18 @@
 
 #include "ghost/user.h"
 
+// redirect
+void g_atomic_block(uint8_t* atom) {
+	g_atomic_block_to(atom, G_TID_NONE);
+}
+
 /**
  *
  */
-void g_atomic_block(uint8_t* atom) {
+void g_atomic_block_to(uint8_t* atom, g_tid owner) {
 	g_syscall_atomic_wait data;
 	data.atom = atom;
 	data.set_on_finish = false;
+	data.owner = owner;
 	g_syscall(G_SYSCALL_ATOMIC_WAIT, (uint32_t) &data);
 }
@@ -26,5 +26,10 @@
  *
  */
 void g_close_directory(g_fs_directory_iterator* iterator) {
+
+	g_syscall_fs_close_directory data;
+	data.iterator = iterator;
+	g_syscall(G_SYSCALL_FS_CLOSE_DIRECTORY, (uint32_t) &data);
+
 	free(iterator);
 }
@@ -45,14 +45,20 @@ uint32_t g_create_thread(void* function) {
 	return g_create_thread_d(function, 0);
 }
 
+// redirect
+uint32_t g_create_thread_d(void* function, void* userData) {
+	return g_create_thread_dp(function, userData, G_THREAD_PLACEMENT_ANY);
+}
+
 /**
  *
  */
-uint32_t g_create_thread_d(void* function, void* userData) {
+uint32_t g_create_thread_dp(void* function, void* userData, g_thread_placement placement) {
 	g_syscall_create_thread data;
 	data.initialEntry = (void*) threadsetuproutine;
 	data.userEntry = function;
 	data.userData = userData;
+	data.placement = placement;
 	g_syscall(G_SYSCALL_CREATE_THREAD, (uint32_t) &data);
 	return data.processId;
 }
@@ -0,0 +1,51 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ghost/user.h"
+
+// redirect
+uint64_t g_event_wait(g_fd event) {
+	return g_event_wait_ts(event, G_EVENT_TIMEOUT_INFINITE, 0);
+}
+
+// redirect
+uint64_t g_event_wait_s(g_fd event, g_event_wait_status* out_status) {
+	return g_event_wait_ts(event, G_EVENT_TIMEOUT_INFINITE, out_status);
+}
+
+// redirect
+uint64_t g_event_wait_timeout(g_fd event, uint64_t timeout) {
+	return g_event_wait_ts(event, timeout, 0);
+}
+
+/**
+ *
+ */
+uint64_t g_event_wait_ts(g_fd event, uint64_t timeout, g_event_wait_status* out_status) {
+
+	g_syscall_fs_event_wait data;
+	data.fd = event;
+	data.timeout = timeout;
+	g_syscall(G_SYSCALL_FS_EVENT_WAIT, (uint32_t) &data);
+	if (out_status) {
+		*out_status = data.status;
+	}
+	return data.count;
+}
@@ -0,0 +1,37 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ghost/user.h"
+
+// redirect
+g_io_ring_enter_status g_io_ring_enter(uint32_t minimum_completions) {
+	return g_io_ring_enter_s(minimum_completions, 0);
+}
+
+g_io_ring_enter_status g_io_ring_enter_s(uint32_t minimum_completions, uint32_t* out_submitted) {
+
+	g_syscall_fs_io_ring_enter data;
+	data.minimum_completions = minimum_completions;
+	g_syscall(G_SYSCALL_FS_IO_RING_ENTER, (uint32_t) &data);
+	if (out_submitted) {
+		*out_submitted = data.submitted;
+	}
+	return data.status;
+}
@@ -0,0 +1,38 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ghost/user.h"
+
+uint8_t g_io_ring_submit(g_io_ring* ring, g_io_operation operation, void* data, uint64_t user_data) {
+
+	if (ring->submission_tail - ring->submission_head >= G_IO_RING_ENTRIES) {
+		return false;
+	}
+
+	g_io_submission* submission = &ring->submissions[ring->submission_tail % G_IO_RING_ENTRIES];
+	submission->operation = operation;
+	submission->data = data;
+	submission->user_data = user_data;
+
+	// the entry must be complete before the kernel can see it
+	__sync_synchronize();
+	++ring->submission_tail;
+	return true;
+}
@@ -31,8 +31,21 @@ void g_pipe(g_fd* out_write, g_fd* out_read) {
  *
  */
 void g_pipe_s(g_fd* out_write, g_fd* out_read, g_fs_pipe_status* out_status) {
+	g_pipe_bs(out_write, out_read, 0, out_status);
+}
+
+// redirect
+void g_pipe_b(g_fd* out_write, g_fd* out_read, uint32_t capacity) {
+	g_pipe_bs(out_write, out_read, capacity, 0);
+}
+
+/**
+ *
+ */
+void g_pipe_bs(g_fd* out_write, g_fd* out_read, uint32_t capacity, g_fs_pipe_status* out_status) {
 
 	g_syscall_fs_pipe data;
+	data.capacity = capacity;
 	g_syscall(G_SYSCALL_FS_PIPE, (uint32_t) &data);
 	*out_write = data.write_fd;
 	*out_read = data.read_fd;
@@ -0,0 +1,42 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ghost/user.h"
+
+// redirect
+int32_t g_poll(g_poll_entry* entries, uint32_t count, uint64_t timeout) {
+	return g_poll_s(entries, count, timeout, 0);
+}
+
+/**
+ *
+ */
+int32_t g_poll_s(g_poll_entry* entries, uint32_t count, uint64_t timeout, g_poll_status* out_status) {
+
+	g_syscall_poll data;
+	data.entries = entries;
+	data.count = count;
+	data.timeout = timeout;
+	g_syscall(G_SYSCALL_POLL, (uint32_t) &data);
+	if (out_status) {
+		*out_status = data.status;
+	}
+	return data.ready;
+}
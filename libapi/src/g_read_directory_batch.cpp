@@ -0,0 +1,51 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ghost/user.h"
+#include <stdint.h>
+
+// redirect
+int32_t g_read_directory_batch(g_fs_directory_iterator* iterator, void* buffer, uint32_t length) {
+	return g_read_directory_batch_s(iterator, buffer, length, 0);
+}
+
+/**
+ *
+ */
+int32_t g_read_directory_batch_s(g_fs_directory_iterator* iterator, void* buffer, uint32_t length, g_fs_read_directory_status* out_status) {
+
+	g_syscall_fs_read_directory_batch data;
+	data.iterator = iterator;
+	data.buffer = buffer;
+	data.length = length;
+	g_syscall(G_SYSCALL_FS_READ_DIRECTORY_BATCH, (uint32_t) &data);
+
+	if (out_status) {
+		*out_status = data.status;
+	}
+
+	if (data.status == G_FS_READ_DIRECTORY_SUCCESSFUL) {
+		return data.count;
+	}
+	if (data.status == G_FS_READ_DIRECTORY_EOD) {
+		return 0;
+	}
+	return -1;
+}
@@ -0,0 +1,55 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ghost/user.h"
+
+// redirect
+int32_t g_stat(const char* path, g_fs_stat_attributes* out_attributes) {
+	return g_stat_s(path, true, out_attributes);
+}
+
+/**
+ *
+ */
+int32_t g_stat_s(const char* path, uint8_t follow_symlinks, g_fs_stat_attributes* out_attributes) {
+
+	g_syscall_fs_stat data;
+	data.path = (char*) path;
+	data.follow_symlinks = follow_symlinks;
+	g_syscall(G_SYSCALL_FS_STAT, (uint32_t) &data);
+	if (data.result == 0) {
+		*out_attributes = data.stats;
+	}
+	return data.result;
+}
+
+/**
+ *
+ */
+int32_t g_fstat(g_fd fd, g_fs_stat_attributes* out_attributes) {
+
+	g_syscall_fs_fstat data;
+	data.fd = fd;
+	g_syscall(G_SYSCALL_FS_FSTAT, (uint32_t) &data);
+	if (data.result == 0) {
+		*out_attributes = data.stats;
+	}
+	return data.result;
+}
@@ -0,0 +1,40 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ghost/user.h"
+
+// redirect
+g_topic_publish_status g_topic_publish(g_topic_id topic, void* buf, size_t len) {
+	return g_topic_publish_m(topic, buf, len, G_TOPIC_PUBLISH_MODE_BLOCKING);
+}
+
+/**
+ *
+ */
+g_topic_publish_status g_topic_publish_m(g_topic_id topic, void* buf, size_t len, g_topic_publish_mode mode) {
+
+	g_syscall_topic_publish data;
+	data.topic = topic;
+	data.buffer = buf;
+	data.length = len;
+	data.mode = mode;
+	g_syscall(G_SYSCALL_TOPIC_PUBLISH, (uint32_t) &data);
+	return data.status;
+}
@@ -0,0 +1,55 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ghost/user.h"
+
+// redirect
+g_topic_receive_status g_topic_receive(g_topic_subscription subscription, void* buf, size_t max, size_t* out_length) {
+	return g_topic_receive_md(subscription, buf, max, out_length, G_TOPIC_RECEIVE_MODE_BLOCKING, 0);
+}
+
+// redirect
+g_topic_receive_status g_topic_receive_m(g_topic_subscription subscription, void* buf, size_t max, size_t* out_length, g_topic_receive_mode mode) {
+	return g_topic_receive_md(subscription, buf, max, out_length, mode, 0);
+}
+
+/**
+ *
+ */
+g_topic_receive_status g_topic_receive_md(g_topic_subscription subscription, void* buf, size_t max, size_t* out_length, g_topic_receive_mode mode,
+		uint32_t* out_dropped) {
+
+	g_syscall_topic_receive data;
+	data.subscription = subscription;
+	data.buffer = buf;
+	data.maximum = max;
+	data.mode = mode;
+	data.length = 0;
+	data.dropped = 0;
+	g_syscall(G_SYSCALL_TOPIC_RECEIVE, (uint32_t) &data);
+
+	if (out_length) {
+		*out_length = data.length;
+	}
+	if (out_dropped) {
+		*out_dropped = data.dropped;
+	}
+	return data.status;
+}
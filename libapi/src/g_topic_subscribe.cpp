@@ -0,0 +1,39 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ghost/user.h"
+
+// redirect
+g_topic_subscription g_topic_subscribe(g_topic_id topic) {
+	return g_topic_subscribe_p(topic, G_TOPIC_BACKPRESSURE_DROP_OLDEST, G_TOPIC_DEFAULT_CAPACITY);
+}
+
+/**
+ *
+ */
+g_topic_subscription g_topic_subscribe_p(g_topic_id topic, g_topic_backpressure policy, uint32_t capacity) {
+
+	g_syscall_topic_subscribe data;
+	data.topic = topic;
+	data.policy = policy;
+	data.capacity = capacity;
+	g_syscall(G_SYSCALL_TOPIC_SUBSCRIBE, (uint32_t) &data);
+	return data.subscription;
+}
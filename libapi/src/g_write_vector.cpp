@@ -0,0 +1,66 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "ghost/user.h"
+
+// redirect
+int32_t g_writev(g_fd file, const g_fs_io_vector* vector, uint32_t count) {
+	return g_pwritev_s(file, vector, count, G_FS_OFFSET_CURRENT, 0);
+}
+
+// redirect
+int32_t g_writev_s(g_fd file, const g_fs_io_vector* vector, uint32_t count, g_fs_write_status* out_status) {
+	return g_pwritev_s(file, vector, count, G_FS_OFFSET_CURRENT, out_status);
+}
+
+// redirect
+int32_t g_pwrite(g_fd file, const void* buffer, uint64_t length, int64_t offset) {
+	return g_pwrite_s(file, buffer, length, offset, 0);
+}
+
+// redirect
+int32_t g_pwrite_s(g_fd file, const void* buffer, uint64_t length, int64_t offset, g_fs_write_status* out_status) {
+	g_fs_io_vector segment;
+	segment.buffer = (void*) buffer;
+	segment.length = length;
+	return g_pwritev_s(file, &segment, 1, offset, out_status);
+}
+
+// redirect
+int32_t g_pwritev(g_fd file, const g_fs_io_vector* vector, uint32_t count, int64_t offset) {
+	return g_pwritev_s(file, vector, count, offset, 0);
+}
+
+/**
+ *
+ */
+int32_t g_pwritev_s(g_fd file, const g_fs_io_vector* vector, uint32_t count, int64_t offset, g_fs_write_status* out_status) {
+
+	g_syscall_fs_write_vector data;
+	data.fd = file;
+	data.vector = (g_fs_io_vector*) vector;
+	data.count = count;
+	data.offset = offset;
+	g_syscall(G_SYSCALL_FS_WRITE_VECTOR, (uint32_t) &data);
+	if (out_status) {
+		*out_status = data.status;
+	}
+	return data.result;
+}
@@ -31,9 +31,21 @@ __BEGIN_C
 typedef struct DIR DIR;
 
 /**
- * Represents a directory stream. Used by dirent-related functions.
+ * Size of the buffer that a directory stream reads entries into
+ */
+#define DIR_BUFFER_SIZE		0x1000
+
+/**
+ * Represents a directory stream. Used by dirent-related functions. Entries
+ * are read from the kernel in batches and then returned from the buffer.
  */
 struct DIR {
+	g_fs_directory_iterator* iterator;
+	uint8_t* buffer;
+	uint32_t buffered;
+	uint32_t next;
+	uint32_t offset;
+	struct dirent* entry;
 };
 
 __END_C
@@ -32,7 +32,7 @@ struct dirent {
 	size_t d_namlen;
 	dev_t d_dev;
 	unsigned char d_type;
-	char* d_name[];
+	char d_name[G_FILENAME_MAX];
 };
 
 int closedir(DIR* dir);
@@ -45,6 +45,16 @@ typedef uint32_t mode_t;
 #define S_IRUSR 0400
 #define S_IRWXU 0700
 
+// file types
+#define S_IFMT		0170000
+#define S_IFIFO		0010000
+#define S_IFDIR		0040000
+#define S_IFREG		0100000
+
+#define S_ISFIFO(m)	(((m) & S_IFMT) == S_IFIFO)
+#define S_ISDIR(m)	(((m) & S_IFMT) == S_IFDIR)
+#define S_ISREG(m)	(((m) & S_IFMT) == S_IFREG)
+
 struct stat {
 	dev_t st_dev;
 	ino_t st_ino;
@@ -61,10 +71,21 @@ struct stat {
 };
 
 /**
- * TODO
+ * Retrieves the type, size and modification time of a file. Times are
+ * seconds since boot, as the kernel has no wall clock.
  */
 int stat(const char *pathname, struct stat *buf);
 
+/**
+ * Same as {stat}, for an open file.
+ */
+int fstat(int fd, struct stat *buf);
+
+/**
+ * Creates a directory. The mode is currently ignored.
+ */
+int mkdir(const char* path, mode_t mode);
+
 __END_C
 
 #endif
@@ -44,6 +44,16 @@ ssize_t read(int fd, void* buf, size_t count);
  */
 ssize_t write(int fd, const void* buf, size_t count);
 
+/**
+ * POSIX wrapper for <g_pread>
+ */
+ssize_t pread(int fd, void* buf, size_t count, off_t offset);
+
+/**
+ * POSIX wrapper for <g_pwrite>
+ */
+ssize_t pwrite(int fd, const void* buf, size_t count, off_t offset);
+
 /**
  * POSIX wrapper for <g_seek>
  */
@@ -59,6 +69,11 @@ long int tell(int filedes);
  */
 int close(int filedes);
 
+/**
+ * POSIX wrapper for <g_flush>
+ */
+int fsync(int fd);
+
 /**
  * POSIX wrapper for <g_sbrk>
  */
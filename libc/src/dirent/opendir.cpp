@@ -0,0 +1,63 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "dirent.h"
+#include "ghost/user.h"
+#include "errno.h"
+#include "stdlib.h"
+
+/**
+ *
+ */
+DIR* opendir(const char* path) {
+
+	g_fs_open_directory_status status;
+	g_fs_directory_iterator* iterator = g_open_directory_s(path, &status);
+
+	if (status != G_FS_OPEN_DIRECTORY_SUCCESSFUL) {
+		if (status == G_FS_OPEN_DIRECTORY_NOT_FOUND) {
+			errno = ENOENT;
+		} else {
+			// TODO improve kernel error codes
+			errno = EIO;
+		}
+		return 0;
+	}
+
+	DIR* dir = (DIR*) malloc(sizeof(DIR));
+	uint8_t* buffer = (uint8_t*) malloc(DIR_BUFFER_SIZE);
+	struct dirent* entry = (struct dirent*) malloc(sizeof(struct dirent));
+	if (dir == 0 || buffer == 0 || entry == 0) {
+		free(dir);
+		free(buffer);
+		free(entry);
+		g_close_directory(iterator);
+		errno = ENOMEM;
+		return 0;
+	}
+
+	dir->iterator = iterator;
+	dir->buffer = buffer;
+	dir->buffered = 0;
+	dir->next = 0;
+	dir->offset = 0;
+	dir->entry = entry;
+	return dir;
+}
@@ -0,0 +1,61 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "dirent.h"
+#include "ghost/user.h"
+#include "errno.h"
+#include "string.h"
+
+/**
+ * Entries are returned from the buffer of the stream; only when it is
+ * exhausted, the next batch is read from the kernel.
+ */
+struct dirent* readdir(DIR* dir) {
+
+	if (dir->next >= dir->buffered) {
+		g_fs_read_directory_status status;
+		int32_t count = g_read_directory_batch_s(dir->iterator, dir->buffer, DIR_BUFFER_SIZE, &status);
+
+		if (count <= 0) {
+			if (status != G_FS_READ_DIRECTORY_EOD) {
+				// TODO improve kernel error codes
+				errno = EIO;
+			}
+			return 0;
+		}
+
+		dir->buffered = count;
+		dir->next = 0;
+		dir->offset = 0;
+	}
+
+	g_fs_directory_record* record = (g_fs_directory_record*) &dir->buffer[dir->offset];
+	dir->offset += record->length;
+	++dir->next;
+
+	struct dirent* entry = dir->entry;
+	entry->d_ino = record->node_id;
+	entry->d_reclen = sizeof(struct dirent);
+	entry->d_namlen = strlen(record->name);
+	entry->d_dev = 0;
+	entry->d_type = record->type;
+	memcpy(entry->d_name, record->name, entry->d_namlen + 1);
+	return entry;
+}
@@ -0,0 +1,45 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "sys/stat.h"
+#include "ghost.h"
+#include "errno.h"
+
+/**
+ *
+ */
+int mkdir(const char* path, mode_t mode) {
+
+	g_fs_create_directory_status status = g_create_directory(path);
+
+	if (status == G_FS_CREATE_DIRECTORY_SUCCESSFUL) {
+		return 0;
+
+	} else if (status == G_FS_CREATE_DIRECTORY_EXISTS) {
+		errno = EEXIST;
+
+	} else {
+		// TODO improve kernel error codes
+		errno = EIO;
+
+	}
+
+	return -1;
+}
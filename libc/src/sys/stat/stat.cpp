@@ -20,12 +20,59 @@
 
 #include "sys/stat.h"
 #include "stdint.h"
+#include "string.h"
+#include "errno.h"
 #include "ghost.h"
 
+/**
+ *
+ */
+static void stat_from_attributes(g_fs_stat_attributes* attributes, struct stat* buf) {
+
+	memset(buf, 0, sizeof(struct stat));
+
+	if (attributes->type == G_FS_NODE_TYPE_FILE) {
+		buf->st_mode = S_IFREG;
+	} else if (attributes->type == G_FS_NODE_TYPE_PIPE) {
+		buf->st_mode = S_IFIFO;
+	} else if (attributes->type == G_FS_NODE_TYPE_FOLDER || attributes->type == G_FS_NODE_TYPE_MOUNTPOINT || attributes->type == G_FS_NODE_TYPE_ROOT) {
+		buf->st_mode = S_IFDIR;
+	}
+	buf->st_mode |= attributes->mode;
+
+	buf->st_nlink = 1;
+	buf->st_size = attributes->length;
+	buf->st_mtime = attributes->modified / 1000;
+	buf->st_atime = buf->st_mtime;
+	buf->st_ctime = buf->st_mtime;
+}
+
 /**
  *
  */
 int stat(const char *pathname, struct stat *buf) {
 
-	__G_NOT_IMPLEMENTED(stat)
+	g_fs_stat_attributes attributes;
+	if (g_stat(pathname, &attributes) != 0) {
+		errno = ENOENT;
+		return -1;
+	}
+
+	stat_from_attributes(&attributes, buf);
+	return 0;
+}
+
+/**
+ *
+ */
+int fstat(int fd, struct stat *buf) {
+
+	g_fs_stat_attributes attributes;
+	if (g_fstat(fd, &attributes) != 0) {
+		errno = EBADF;
+		return -1;
+	}
+
+	stat_from_attributes(&attributes, buf);
+	return 0;
 }
@@ -22,6 +22,7 @@
 #define GHOSTLIBRARY_IO_KEYBOARD
 
 #include <stdint.h>
+#include <ghost.h>
 #include <string>
 #include <sstream>
 
@@ -79,10 +80,11 @@ public:
  */
 class g_keyboard {
 private:
-	static void registerKeyboard();
+	static void subscribeKeyboard();
 
 public:
 	static g_key_info readKey();
+	static g_topic_subscription getSubscription();
 
 	static g_key_info keyForScancode(uint8_t scancode);
 	static char charForKey(g_key_info info);
@@ -22,6 +22,7 @@
 #define GHOSTLIBRARY_IO_MOUSE
 
 #include <stdint.h>
+#include <ghost.h>
 #include <string>
 #include <sstream>
 
@@ -41,10 +42,11 @@ struct g_mouse_info {
  */
 class g_mouse {
 private:
-	static void registerMouse();
+	static void subscribeMouse();
 
 public:
 	static g_mouse_info readMouse();
+	static g_topic_subscription getSubscription();
 
 	static uint32_t getMousePort();
 };
@@ -23,13 +23,9 @@
 
 #define G_PS2_DRIVER_IDENTIFIER							"ps2driver"
 
-typedef int g_ps2_command;
-const g_ps2_command G_PS2_COMMAND_REGISTER_KEYBOARD = 0;
-const g_ps2_command G_PS2_COMMAND_REGISTER_MOUSE = 1;
-
-typedef struct {
-	g_ps2_command command;
-}__attribute__((packed)) g_ps2_register_request;
+// topics that the driver publishes packets to
+#define G_PS2_KEYBOARD_TOPIC							"ps2driver/keyboard"
+#define G_PS2_MOUSE_TOPIC								"ps2driver/mouse"
 
 typedef struct {
 	int16_t x;
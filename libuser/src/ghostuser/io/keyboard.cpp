@@ -41,27 +41,23 @@ static bool numLock = false;
 static std::map<uint8_t, std::string> scancodeLayout;
 static std::map<g_key_info, char> conversionLayout;
 
-static uint32_t keyboardRegisteredTask = -1;
-static uint32_t keyboardTopic = -1;
+static g_tid keyboardSubscribedTask = -1;
+static g_topic_subscription keyboardSubscription = -1;
 
 static std::string currentLayout;
 
 /**
  *
  */
-void g_keyboard::registerKeyboard() {
+void g_keyboard::subscribeKeyboard() {
 
-	uint32_t ps2driverid = g_task_get_id(G_PS2_DRIVER_IDENTIFIER);
-	if (ps2driverid == -1) {
+	g_topic_id topic = g_topic_open(G_PS2_KEYBOARD_TOPIC);
+	if (topic == -1) {
 		return;
 	}
 
-	keyboardTopic = g_ipc_next_topic();
-	keyboardRegisteredTask = g_get_tid();
-
-	g_ps2_register_request request;
-	request.command = G_PS2_COMMAND_REGISTER_KEYBOARD;
-	g_send_message_t(ps2driverid, &request, sizeof(g_ps2_register_request), keyboardTopic);
+	keyboardSubscription = g_topic_subscribe(topic);
+	keyboardSubscribedTask = g_get_tid();
 }
 
 /**
@@ -69,23 +65,26 @@ void g_keyboard::registerKeyboard() {
  */
 g_key_info g_keyboard::readKey() {
 
-	if (keyboardTopic == -1) {
-		registerKeyboard();
-	}
+	g_topic_subscription subscription = getSubscription();
 
-	uint32_t task_id = g_get_tid();
-	if (keyboardRegisteredTask != task_id) {
-		registerKeyboard();
+	g_ps2_keyboard_packet packet;
+	size_t length;
+	if (g_topic_receive(subscription, &packet, sizeof(g_ps2_keyboard_packet), &length) == G_TOPIC_RECEIVE_STATUS_SUCCESSFUL) {
+		return keyForScancode(packet.scancode);
 	}
+	return g_key_info();
+}
 
-	size_t buflen = sizeof(g_message_header) + sizeof(g_ps2_keyboard_packet);
-	uint8_t buf[buflen];
+/**
+ * Returns the keyboard topic subscription of the executing task, subscribing
+ * if required. Allows waiting for keys with {g_poll} before calling {readKey}.
+ */
+g_topic_subscription g_keyboard::getSubscription() {
 
-	if (g_receive_message_t(buf, buflen, keyboardTopic) == G_MESSAGE_RECEIVE_STATUS_SUCCESSFUL) {
-		g_ps2_keyboard_packet* packet = (g_ps2_keyboard_packet*) G_MESSAGE_CONTENT(buf);
-		return keyForScancode(packet->scancode);
+	if (keyboardSubscription == -1 || keyboardSubscribedTask != g_get_tid()) {
+		subscribeKeyboard();
 	}
-	return g_key_info();
+	return keyboardSubscription;
 }
 
 /**
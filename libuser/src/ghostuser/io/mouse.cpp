@@ -24,23 +24,33 @@
 #include <ghostuser/tasking/ipc.hpp>
 #include <ghostuser/utils/logger.hpp>
 
-static uint32_t mouseTopic = -1;
+static g_tid mouseSubscribedTask = -1;
+static g_topic_subscription mouseSubscription = -1;
 
 /**
  *
  */
-void g_mouse::registerMouse() {
+void g_mouse::subscribeMouse() {
 
-	uint32_t ps2driverid = g_task_get_id(G_PS2_DRIVER_IDENTIFIER);
-	if (ps2driverid == -1) {
+	g_topic_id topic = g_topic_open(G_PS2_MOUSE_TOPIC);
+	if (topic == -1) {
 		return;
 	}
 
-	mouseTopic = g_ipc_next_topic();
+	mouseSubscription = g_topic_subscribe(topic);
+	mouseSubscribedTask = g_get_tid();
+}
+
+/**
+ * Returns the mouse topic subscription of the executing task, subscribing
+ * if required.
+ */
+g_topic_subscription g_mouse::getSubscription() {
 
-	g_ps2_register_request request;
-	request.command = G_PS2_COMMAND_REGISTER_MOUSE;
-	g_send_message_t(ps2driverid, &request, sizeof(g_ps2_register_request), mouseTopic);
+	if (mouseSubscription == -1 || mouseSubscribedTask != g_get_tid()) {
+		subscribeMouse();
+	}
+	return mouseSubscription;
 }
 
 /**
@@ -48,22 +58,18 @@ void g_mouse::registerMouse() {
  */
 g_mouse_info g_mouse::readMouse() {
 
-	if (mouseTopic == -1) {
-		registerMouse();
-	}
+	g_topic_subscription subscription = getSubscription();
 
-	size_t buflen = sizeof(g_message_header) + sizeof(g_ps2_mouse_packet);
-	uint8_t buf[buflen];
+	g_ps2_mouse_packet packet;
+	size_t length;
 
 	g_mouse_info e;
-	if (g_receive_message_t(buf, buflen, mouseTopic) == G_MESSAGE_RECEIVE_STATUS_SUCCESSFUL) {
-		g_ps2_mouse_packet* packet = (g_ps2_mouse_packet*) G_MESSAGE_CONTENT(buf);
-
-		e.x = packet->x;
-		e.y = packet->y;
-		e.button1 = (packet->flags & (1 << 0));
-		e.button2 = (packet->flags & (1 << 1));
-		e.button3 = (packet->flags & (1 << 2));
+	if (g_topic_receive(subscription, &packet, sizeof(g_ps2_mouse_packet), &length) == G_TOPIC_RECEIVE_STATUS_SUCCESSFUL) {
+		e.x = packet.x;
+		e.y = packet.y;
+		e.button1 = (packet.flags & (1 << 0));
+		e.button2 = (packet.flags & (1 << 1));
+		e.button3 = (packet.flags & (1 << 2));
 	}
 	return e;
 }
@@ -32,6 +32,11 @@
 static g_fd g_ui_channel_in = -1;
 static g_fd g_ui_channel_out = -1;
 
+/**
+ * Window server thread that handles the requests of this process
+ */
+static g_tid g_ui_server_thread = G_TID_NONE;
+
 /**
  * Global ready indicator
  */
@@ -55,7 +60,7 @@ static std::map<uint32_t, g_listener*> listeners;
 /**
  * Used by event dispatch thread
  */
-static uint8_t event_dispatch_events_empty = true;
+static g_fd event_dispatch_event = -1;
 static uint8_t event_dispatch_locked = false;
 static std::deque<g_ui_event_dispatch_data> event_dispatch_queue;
 
@@ -117,6 +122,10 @@ g_ui_open_status g_ui::open() {
 		g_logger::log("window servers UI-open response was not a proper 'opened'-response");
 		return G_UI_OPEN_STATUS_COMMUNICATION_FAILED;
 	}
+	g_ui_server_thread = open_response.sender;
+
+	// create the event that announces queued events
+	event_dispatch_event = g_event_create();
 
 	// start asynchronous receiver
 	g_create_thread((void*) &asynchronous_receiver_thread);
@@ -135,23 +144,23 @@ void g_ui::event_dispatch_thread() {
 
 	while (true) {
 		// wait for events
-		g_atomic_block(&event_dispatch_events_empty);
+		g_event_wait(event_dispatch_event);
 
-		// lock
-		g_atomic_wait(&event_dispatch_locked);
+		// dispatch all queued events
+		while (true) {
+			g_atomic_wait(&event_dispatch_locked);
+			if (event_dispatch_queue.empty()) {
+				event_dispatch_locked = false;
+				break;
+			}
 
-		// call listener
-		g_ui_event_dispatch_data& e = event_dispatch_queue.back();
-		event_dispatch_queue.pop_back();
-		e.listener->event_received(e.data, e.length);
+			g_ui_event_dispatch_data e = event_dispatch_queue.back();
+			event_dispatch_queue.pop_back();
+			event_dispatch_locked = false;
 
-		// check if empty
-		if (event_dispatch_queue.empty()) {
-			event_dispatch_events_empty = true;
+			// call listener outside of the lock
+			e.listener->event_received(e.data, e.length);
 		}
-
-		// unlock
-		event_dispatch_locked = false;
 	}
 }
 
@@ -159,8 +168,11 @@ void g_ui::event_dispatch_thread() {
  *
  */
 void g_ui::event_dispatch_queue_add(const g_ui_event_dispatch_data& data) {
+	g_atomic_wait(&event_dispatch_locked);
 	event_dispatch_queue.push_front(data);
-	event_dispatch_events_empty = false;
+	event_dispatch_locked = false;
+
+	g_event_signal(event_dispatch_event);
 }
 
 /**
@@ -284,6 +296,9 @@ g_ui_transaction_id g_ui::send(uint8_t* data, uint32_t length) {
 	// unlock
 	sending_locked = false;
 
+	// let the server handle the request right away
+	g_yield_to(g_ui_server_thread);
+
 	return transaction;
 }
 
@@ -306,8 +321,8 @@ bool g_ui::receive(g_ui_transaction_id transaction, uint8_t** out_data, uint32_t
 	// take data
 	g_ui_transaction_data* data = transaction_map->at(transaction);
 
-	// block until received
-	g_atomic_block(&data->waiting);
+	// block until received, lending time to the server that handles the request
+	g_atomic_block_to(&data->waiting, g_ui_server_thread);
 
 	// set out parameters
 	*out_data = data->data;
@@ -22,11 +22,59 @@
 #define __GHOST_RAMDISK__
 
 #include <fstream>
+#include <string>
+#include <vector>
 #include <stdint.h>
 
-#define VERSION_MAJOR	1
+#define VERSION_MAJOR	2
 #define	VERSION_MINOR	0
 
+/**
+ * Image format, must match the definitions in the kernels "ghost/ramdisk.h".
+ */
+#define RAMDISK_MAGIC				"GHOSTRD2"
+#define RAMDISK_MAGIC_LENGTH		8
+#define RAMDISK_VERSION				2
+#define RAMDISK_PAGE_SIZE			0x1000
+
+#define RAMDISK_COMPRESSION_NONE	0
+#define RAMDISK_COMPRESSION_LZ4		1
+
+struct ramdisk_image_header {
+	uint8_t magic[RAMDISK_MAGIC_LENGTH];
+	uint32_t version;
+	uint32_t entryCount;
+	uint32_t entryTableOffset;
+	uint32_t stringTableOffset;
+	uint32_t stringTableLength;
+}__attribute__((packed));
+
+struct ramdisk_image_entry {
+	uint8_t type;
+	uint8_t compression;
+	uint16_t reserved;
+	uint32_t id;
+	uint32_t parentId;
+	uint32_t nameOffset;
+	uint32_t nameLength;
+	uint32_t dataOffset;
+	uint32_t storedLength;
+	uint32_t length;
+}__attribute__((packed));
+
+/**
+ * An entry collected for a version 2 image.
+ */
+struct ramdisk_collected_entry {
+	bool isFile;
+	uint32_t id;
+	uint32_t parentId;
+	std::string name;
+	uint8_t compression;
+	uint32_t length;
+	std::vector<uint8_t> stored;
+};
+
 /**
  *
  */
@@ -35,11 +83,32 @@ private:
 	int idCounter;
 	std::ofstream out;
 
+	bool legacy;
+	bool compress;
+	std::vector<ramdisk_collected_entry> entries;
+
 	void writeRecursive(const char* path, const char* name, uint32_t contentLength, uint32_t parentId, bool isFile);
 
+	void collectRecursive(const char* path, const char* name, uint32_t parentId, bool isFile);
+	void writeIndexed();
+
 public:
 	ghost_ramdisk() :
-			idCounter(0) {
+			idCounter(0), legacy(false), compress(false) {
+	}
+
+	/**
+	 * Writes images in the version 1 format, which older kernels understand.
+	 */
+	void setLegacy(bool legacy) {
+		this->legacy = legacy;
+	}
+
+	/**
+	 * Stores files LZ4-compressed if that makes them smaller.
+	 */
+	void setCompress(bool compress) {
+		this->compress = compress;
 	}
 
 	void create(const char* sourcePath, const char* targetPath);
@@ -0,0 +1,39 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef __GHOST_RAMDISK_LZ4__
+#define __GHOST_RAMDISK_LZ4__
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Compresses the input into a single block in the LZ4 block format, which the
+ * kernel decompresses when a file is first accessed. Uses a greedy matcher with
+ * a single hash table; the ratio is lower than that of the reference
+ * implementation, but the output is compatible.
+ *
+ * @param in		the input data
+ * @param length	length of the input
+ * @param out		receives the compressed block
+ */
+void lz4Compress(const uint8_t* in, uint32_t length, std::vector<uint8_t>& out);
+
+#endif
@@ -19,6 +19,7 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "../inc/ghost_ramdisk.hpp"
+#include "../inc/lz4.hpp"
 
 #include <iostream>
 #include <sstream>
@@ -44,20 +45,35 @@ int main(int argc, char** argv) {
 			std::cout << "  This program generates a Ghost ramdisk from a given source folder." << std::endl;
 			std::cout << "  To do so, use the following command syntax:" << std::endl;
 			std::cout << std::endl;
-			std::cout << "\tpath/to/source path/to/target" << std::endl;
+			std::cout << "\t[options] path/to/source path/to/target" << std::endl;
+			std::cout << std::endl;
+			std::cout << "OPTIONS" << std::endl;
+			std::cout << "  --v1        write the legacy version 1 format" << std::endl;
+			std::cout << "  --compress  store files LZ4-compressed where it saves space" << std::endl;
 			std::cout << std::endl;
 			return 0;
 		}
+	}
 
-		std::cerr << "error: unrecognized command line option '" << argv[1] << std::endl << std::endl;
-		return 1;
+	std::vector<const char*> paths;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--v1") == 0) {
+			ramdisk.setLegacy(true);
+		} else if (strcmp(argv[i], "--compress") == 0) {
+			ramdisk.setCompress(true);
+		} else if (argv[i][0] == '-') {
+			std::cerr << "error: unrecognized command line option '" << argv[i] << "'" << std::endl << std::endl;
+			return 1;
+		} else {
+			paths.push_back(argv[i]);
+		}
 	}
 
-	if (argc == 3) {
-		ramdisk.create(argv[1], argv[2]);
+	if (paths.size() == 2) {
+		ramdisk.create(paths[0], paths[1]);
 		return 0;
 	} else {
-		std::cerr << "usage: " << argv[0] << " path/to/source path/to/target" << std::endl;
+		std::cerr << "usage: " << argv[0] << " [--v1] [--compress] path/to/source path/to/target" << std::endl;
 		return 1;
 	}
 }
@@ -73,7 +89,12 @@ void ghost_ramdisk::create(const char* sourcePath, const char* targetPath) {
 		if (out.good()) {
 			std::cout << "status: writing folder '" << sourcePath << "' to '" << targetPath << "'..." << std::endl;
 			int64_t pos = out.tellp();
-			writeRecursive(sourcePath, "", 0, 0, false);
+			if (legacy) {
+				writeRecursive(sourcePath, "", 0, 0, false);
+			} else {
+				collectRecursive(sourcePath, "", 0, false);
+				writeIndexed();
+			}
 			int64_t written = out.tellp() - pos;
 			std::cout << "status: ramdisk successfully created, wrote " << written << " bytes" << std::endl;
 		} else {
@@ -199,3 +220,143 @@ void ghost_ramdisk::writeRecursive(const char* path, const char* name, uint32_t
 
 	delete buffer;
 }
+
+/**
+ * Collects the entries of a version 2 image, together with the stored form of
+ * each files contents.
+ */
+void ghost_ramdisk::collectRecursive(const char* path, const char* name, uint32_t parentId, bool isFile) {
+
+	uint32_t entryId = idCounter++;
+
+	std::stringstream msg;
+	msg << " " << entryId << ": " << path << (isFile ? "" : "/");
+	std::cout << msg.str() << std::endl;
+
+	// Root is implicit
+	if (entryId > 0) {
+		entries.push_back(ramdisk_collected_entry());
+		ramdisk_collected_entry& collected = entries.back();
+		collected.isFile = isFile;
+		collected.id = entryId;
+		collected.parentId = parentId;
+		collected.name = name;
+		collected.compression = RAMDISK_COMPRESSION_NONE;
+		collected.length = 0;
+
+		if (isFile) {
+			std::ifstream fileInput;
+			fileInput.open(path, std::ios::in | std::ios::binary);
+			std::vector<uint8_t> content((std::istreambuf_iterator<char>(fileInput)), std::istreambuf_iterator<char>());
+			fileInput.close();
+
+			collected.length = content.size();
+			if (compress && content.size() > 0) {
+				lz4Compress(content.data(), content.size(), collected.stored);
+				if (collected.stored.size() < content.size()) {
+					collected.compression = RAMDISK_COMPRESSION_LZ4;
+				}
+			}
+			if (collected.compression == RAMDISK_COMPRESSION_NONE) {
+				collected.stored.swap(content);
+			}
+		}
+	}
+
+	if (!isFile) {
+		DIR *directory;
+		dirent *entry;
+
+		if ((directory = opendir(path)) != NULL) {
+			while ((entry = readdir(directory)) != NULL) {
+				std::string entryPath = std::string(path) + '/' + entry->d_name;
+
+				struct stat s;
+				if (stat(entryPath.c_str(), &s) == 0) {
+
+					if (S_ISREG(s.st_mode)) {
+						collectRecursive(entryPath.c_str(), entry->d_name, entryId, true);
+
+					} else if (S_ISDIR(s.st_mode)) {
+						if (!(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)) {
+							collectRecursive(entryPath.c_str(), entry->d_name, entryId, false);
+						}
+					}
+				} else {
+					std::cerr << "error: could not read directory: '" << path << "'";
+					break;
+				}
+			}
+
+			closedir(directory);
+		} else {
+			std::cerr << "error: could not open directory: '" << path << "'";
+		}
+	}
+}
+
+/**
+ * Writes the collected entries as a version 2 image: the header, the entry table,
+ * the string table and then the file data. Uncompressed data starts on a page
+ * boundary so that the kernel can map it, compressed data is aligned to four bytes.
+ */
+void ghost_ramdisk::writeIndexed() {
+
+	ramdisk_image_header header;
+	memcpy(header.magic, RAMDISK_MAGIC, RAMDISK_MAGIC_LENGTH);
+	header.version = RAMDISK_VERSION;
+	header.entryCount = entries.size();
+	header.entryTableOffset = sizeof(ramdisk_image_header);
+	header.stringTableOffset = header.entryTableOffset + entries.size() * sizeof(ramdisk_image_entry);
+
+	// lay out the names and the data
+	std::vector<ramdisk_image_entry> table(entries.size());
+	std::string strings;
+	for (size_t i = 0; i < entries.size(); i++) {
+		ramdisk_image_entry& imageEntry = table[i];
+		memset(&imageEntry, 0, sizeof(ramdisk_image_entry));
+		imageEntry.type = entries[i].isFile ? 1 : 0;
+		imageEntry.compression = entries[i].compression;
+		imageEntry.id = entries[i].id;
+		imageEntry.parentId = entries[i].parentId;
+		imageEntry.nameOffset = strings.size();
+		imageEntry.nameLength = entries[i].name.size();
+		strings.append(entries[i].name);
+		strings.push_back(0);
+	}
+	header.stringTableLength = strings.size();
+
+	uint32_t position = header.stringTableOffset + header.stringTableLength;
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (!entries[i].isFile) {
+			continue;
+		}
+
+		uint32_t alignment = (entries[i].compression == RAMDISK_COMPRESSION_NONE) ? RAMDISK_PAGE_SIZE : 4;
+		position = (position + alignment - 1) & ~(alignment - 1);
+		table[i].dataOffset = position;
+		table[i].storedLength = entries[i].stored.size();
+		table[i].length = entries[i].length;
+		position += table[i].storedLength;
+	}
+
+	// write everything in order, padding up to each data offset
+	out.write((const char*) &header, sizeof(ramdisk_image_header));
+	out.write((const char*) table.data(), table.size() * sizeof(ramdisk_image_entry));
+	out.write(strings.data(), strings.size());
+
+	uint32_t written = header.stringTableOffset + header.stringTableLength;
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (!entries[i].isFile) {
+			continue;
+		}
+
+		for (; written < table[i].dataOffset; written++) {
+			out.put(0);
+		}
+		out.write((const char*) entries[i].stored.data(), entries[i].stored.size());
+		written += entries[i].stored.size();
+	}
+
+	out.flush();
+}
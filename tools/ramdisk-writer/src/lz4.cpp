@@ -0,0 +1,111 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *                                                                           *
+ *  Ghost, a micro-kernel based operating system for the x86 architecture    *
+ *  Copyright (C) 2015, Max Schlüssel <lokoxe@gmail.com>                     *
+ *                                                                           *
+ *  This program is free software: you can redistribute it and/or modify     *
+ *  it under the terms of the GNU General Public License as published by     *
+ *  the Free Software Foundation, either version 3 of the License, or        *
+ *  (at your option) any later version.                                      *
+ *                                                                           *
+ *  This program is distributed in the hope that it will be useful,          *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU General Public License for more details.                             *
+ *                                                                           *
+ *  You should have received a copy of the GNU General Public License        *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.    *
+ *                                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "../inc/lz4.hpp"
+
+#include <string.h>
+
+#define LZ4_MINIMUM_MATCH		4
+#define LZ4_LAST_LITERALS		5
+#define LZ4_MATCH_FIND_LIMIT	12
+#define LZ4_MAXIMUM_OFFSET		65535
+#define LZ4_HASH_BITS			16
+
+/**
+ *
+ */
+static uint32_t read32(const uint8_t* in) {
+	uint32_t value;
+	memcpy(&value, in, 4);
+	return value;
+}
+
+/**
+ *
+ */
+static void writeLength(std::vector<uint8_t>& out, uint32_t length) {
+	while (length >= 255) {
+		out.push_back(255);
+		length -= 255;
+	}
+	out.push_back(length);
+}
+
+/**
+ * Writes a sequence of literals, optionally followed by a match.
+ */
+static void writeSequence(std::vector<uint8_t>& out, const uint8_t* literals, uint32_t literalLength, uint32_t offset, uint32_t matchLength) {
+
+	uint32_t matchCode = matchLength ? matchLength - LZ4_MINIMUM_MATCH : 0;
+	uint8_t token = ((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15);
+	out.push_back(token);
+
+	if (literalLength >= 15) {
+		writeLength(out, literalLength - 15);
+	}
+	out.insert(out.end(), literals, literals + literalLength);
+
+	if (matchLength) {
+		out.push_back(offset & 0xFF);
+		out.push_back((offset >> 8) & 0xFF);
+		if (matchCode >= 15) {
+			writeLength(out, matchCode - 15);
+		}
+	}
+}
+
+/**
+ *
+ */
+void lz4Compress(const uint8_t* in, uint32_t length, std::vector<uint8_t>& out) {
+
+	out.clear();
+
+	uint32_t anchor = 0;
+	uint32_t position = 0;
+
+	// the format requires the last match to start 12 bytes and end 5 bytes before the end
+	if (length > LZ4_MATCH_FIND_LIMIT) {
+		std::vector<int64_t> table(1 << LZ4_HASH_BITS, -1);
+		uint32_t matchLimit = length - LZ4_LAST_LITERALS;
+
+		while (position <= length - LZ4_MATCH_FIND_LIMIT) {
+			uint32_t sequence = read32(&in[position]);
+			uint32_t hash = (sequence * 2654435761U) >> (32 - LZ4_HASH_BITS);
+			int64_t candidate = table[hash];
+			table[hash] = position;
+
+			if (candidate >= 0 && position - candidate <= LZ4_MAXIMUM_OFFSET && read32(&in[candidate]) == sequence) {
+				uint32_t matchLength = LZ4_MINIMUM_MATCH;
+				while (position + matchLength < matchLimit && in[candidate + matchLength] == in[position + matchLength]) {
+					++matchLength;
+				}
+
+				writeSequence(out, &in[anchor], position - anchor, position - candidate, matchLength);
+				position += matchLength;
+				anchor = position;
+			} else {
+				++position;
+			}
+		}
+	}
+
+	writeSequence(out, &in[anchor], length - anchor, 0, 0);
+}